@@ -96,6 +96,11 @@ private:
     std::unique_ptr<tbb::task_scheduler_init> fInitTBB;
 };
 
+namespace Internal {
+   /// Executor shared by the parallel algorithms of ROOT, following ROOT::EnableImplicitMT.
+   std::shared_ptr<TThreadExecutor> GetImplicitMTExecutor();
+}
+
 /************ TEMPLATE METHODS IMPLEMENTATION ******************/
 
 //////////////////////////////////////////////////////////////////////////
@@ -37,6 +37,12 @@ static bool &GetImplicitMTFlag()
    return enabled;
 }
 
+static UInt_t &GetImplicitMTPoolSize()
+{
+   static UInt_t size = 0;
+   return size;
+}
+
 static std::atomic_int &GetParBranchProcessingCount()
 {
    static std::atomic_int count(0);
@@ -52,13 +58,18 @@ static std::atomic_int &GetParTreeProcessingCount()
 extern "C" void ROOT_TImplicitMT_EnableImplicitMT(UInt_t numthreads)
 {
    if (!GetImplicitMTFlag()) {
+      if (numthreads == 0)
+         numthreads = tbb::task_scheduler_init::default_num_threads();
+
+      // the scheduler is kept when disabling: initialize it again if the number of threads changes
+      if (GetScheduler().is_active() && numthreads != GetImplicitMTPoolSize())
+         GetScheduler().terminate();
+
       if (!GetScheduler().is_active()) {
          TThread::Initialize();
 
-         if (numthreads == 0)
-            numthreads = tbb::task_scheduler_init::automatic;
-
          GetScheduler().initialize(numthreads);
+         GetImplicitMTPoolSize() = numthreads;
       }
       GetImplicitMTFlag() = true;
    }
@@ -82,6 +93,11 @@ extern "C" bool ROOT_TImplicitMT_IsImplicitMTEnabled()
    return GetImplicitMTFlag();
 };
 
+extern "C" UInt_t ROOT_TImplicitMT_GetImplicitMTPoolSize()
+{
+   return GetImplicitMTPoolSize();
+};
+
 extern "C" void ROOT_TImplicitMT_EnableParBranchProcessing()
 {
    ++GetParBranchProcessingCount();
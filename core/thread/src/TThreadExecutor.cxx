@@ -1,5 +1,8 @@
 #include "ROOT/TThreadExecutor.hxx"
 #include "tbb/tbb.h"
+#include <mutex>
+
+extern "C" unsigned int ROOT_TImplicitMT_GetImplicitMTPoolSize();
 
 namespace ROOT{
   TThreadExecutor::TThreadExecutor():fInitTBB(new tbb::task_scheduler_init()){
@@ -29,4 +32,25 @@ namespace ROOT{
                               return std::accumulate(range.begin(), range.end(), init, redfunc);
                               }, redfunc);
   }
-}
\ No newline at end of file
+
+  namespace Internal {
+    ////////////////////////////////////////////////////////////////////////////////
+    /// Returns the executor shared by the parallel algorithms of the ROOT libraries.
+    /// It has the number of threads given to ROOT::EnableImplicitMT (the default number
+    /// when implicit multi-threading was never enabled), and it is replaced when a later
+    /// ROOT::EnableImplicitMT changes that number. The callers keep the returned pointer
+    /// for the duration of their parallel section only.
+    std::shared_ptr<TThreadExecutor> GetImplicitMTExecutor() {
+      static std::mutex mutex;
+      static std::shared_ptr<TThreadExecutor> executor;
+      static unsigned int nThreads = 0;
+      std::lock_guard<std::mutex> lock(mutex);
+      unsigned int poolSize = ROOT_TImplicitMT_GetImplicitMTPoolSize();
+      if (!executor || poolSize != nThreads) {
+        executor = (poolSize > 0) ? std::make_shared<TThreadExecutor>(poolSize) : std::make_shared<TThreadExecutor>();
+        nThreads = poolSize;
+      }
+      return executor;
+    }
+  }
+}
@@ -150,6 +150,12 @@ private:
       return fFunc->EvalPar(x, 0 ); 
    }
 
+   /// evaluate the function at n points (coordinates in SoA layout) with a single call to TF1::EvalPar.
+   /// Functions defined by a formula use the version of the formula compiled for arrays of points
+   void DoEvalParVec (unsigned int n, const double * x, const double * p, double * f) const {
+      fFunc->EvalPar(n, x, p, f);
+   }
+
 
    /// evaluate the partial derivative with respect to the parameter
    double DoParameterDerivative(const double * x, const double * p, unsigned int ipar) const;
@@ -31,6 +31,8 @@
 #include "TArrayD.h"
 #endif
 
+#include <atomic>
+
 class THashList;
 
 class TAxis : public TNamed, public TAttAxis {
@@ -49,6 +51,9 @@ private:
    THashList   *fLabels;         //List of labels
    TList       *fModLabs;        //List of modified labels
 
+   class TBinLookup;
+   mutable std::atomic<TBinLookup*> fBinLookup; //!Grid accelerating the search of variable bins, built on first use
+
    // TAxis extra status bits (stored in fBits2)
    enum {
       kAlphanumeric = BIT(0),   // axis is alphanumeric
@@ -57,6 +62,8 @@ private:
    };
 
    Bool_t       HasBinWithoutLabel() const;
+   Int_t        FindVariableBin(Double_t x) const;
+   void         ResetBinLookup();
 
 public:
    // TAxis status bits
@@ -110,6 +117,7 @@ public:
    virtual Int_t      FindBin(const char *label);
    virtual Int_t      FindFixBin(Double_t x) const;
    virtual Int_t      FindFixBin(const char *label) const;
+           void       FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride=1) const;
    virtual Double_t   GetBinCenter(Int_t bin) const;
    virtual Double_t   GetBinCenterLog(Int_t bin) const;
    const char        *GetBinLabel(Int_t bin) const;
@@ -157,7 +165,7 @@ public:
                                   Double_t labSize = -1., Int_t labAlign = -1,
                                   Int_t labColor = -1 , Int_t labFont = -1,
                                   TString labText = ""); // *MENU*
-   virtual void       SetLimits(Double_t xmin, Double_t xmax) { /* set axis limits */ fXmin = xmin; fXmax = xmax; }
+   virtual void       SetLimits(Double_t xmin, Double_t xmax) { /* set axis limits */ fXmin = xmin; fXmax = xmax; ResetBinLookup(); }
            void       SetMoreLogLabels(Bool_t more=kTRUE);  // *TOGGLE* *GETTER=GetMoreLogLabels
            void       SetNoExponent(Bool_t noExponent=kTRUE);  // *TOGGLE* *GETTER=GetNoExponent
    virtual void       SetParent(TObject *obj) {fParent = obj;}
@@ -102,10 +102,12 @@ private:
    TString           fClingName;     //! unique name passed to Cling to define the function ( double clingName(double*x, double*p) )
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
+   TInterpreter::CallFuncIFacePtr_t::Generic_t fVecFuncPtr; //!  function pointer of the version evaluating arrays of points
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
+   Bool_t   PrepareVecEvalMethod();
    void     FillDefaults();
    void     HandlePolN(TString &formula);
    void     HandleParametrizedFunctions(TString &formula);
@@ -169,6 +171,7 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalPar(Int_t n, const Double_t *x, const Double_t *params, Double_t *out) const;
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
@@ -47,6 +47,8 @@ class TDirectory;
 
 #include "TFitResultPtr.h"
 
+#include <vector>
+
 class TGraph2D : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
 protected:
@@ -63,6 +65,7 @@ protected:
    Double_t    fMaximum;          ///< Maximum value for plotting along z
    Double_t    fMargin;           ///< Extra space (in %) around interpolated area for fHistogram
    Double_t    fZout;             ///< fHistogram bin height for points lying outside the interpolated area
+   std::vector<UInt_t> fTriangles; ///< Vertex indices of the cached Delaunay triangles (3 per triangle)
    TList      *fFunctions;        ///< Pointer to list of functions (fits and user)
    TH2D       *fHistogram;        ///<!2D histogram of z values linearly interpolated on the triangles
    TObject    *fDelaunay;         ///<! Pointer to Delaunay interpolator object
@@ -144,6 +147,7 @@ public:
    virtual Double_t      GetZmaxE() const {return GetZmax();};
    virtual Double_t      GetZminE() const {return GetZmin();};
    Double_t              Interpolate(Double_t x, Double_t y);
+   void                  Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z);
    void                  Paint(Option_t *option="");
    TH1                  *Project(Option_t *option="x") const; // *MENU*
    Int_t                 RemovePoint(Int_t ipoint); // *MENU*
@@ -164,7 +168,7 @@ public:
    virtual void          SetTitle(const char *title=""); // *MENU*
 
 
-   ClassDef(TGraph2D,1)  //Set of n x[n],y[n],z[n] points with 3-d graphics including Delaunay triangulation
+   ClassDef(TGraph2D,2)  //Set of n x[n],y[n],z[n] points with 3-d graphics including Delaunay triangulation
 };
 
 #endif
@@ -54,7 +54,10 @@ public:
    TGraphDelaunay2D(TGraph2D *g = 0);
 
    Double_t  ComputeZ(Double_t x, Double_t y) { return fDelaunay.Interpolate(x,y); }
+   void      ComputeZ(Int_t n, const Double_t *x, const Double_t *y, Double_t *z) { fDelaunay.Interpolate(n,x,y,z); }
    void      FindAllTriangles() { fDelaunay.FindAllTriangles(); }
+   void      GetTriangles(std::vector<UInt_t> &vertices);
+   void      SetTriangles(const std::vector<UInt_t> &vertices) { fDelaunay.SetTriangles(vertices); }
 
    TGraph2D *GetGraph2D() const {return fGraph2D;}
    Double_t  GetMarginBinsContent() const {return fDelaunay.ZOuterValue();}
@@ -64,6 +64,7 @@ class TList;
 class TGraph;
 class TMultiGraph;
 class TPad;
+class TH2PolyQuadTree;
 
 class TH2Poly : public TH2 {
 
@@ -138,8 +139,12 @@ protected:
    Bool_t   fFloat;             //When set to kTRUE, allows the histogram to expand if a bin outside the limits is added.
    Bool_t   fNewBinAdded;       //!For the 3D Painter
    Bool_t   fBinContentChanged; //!For the 3D Painter
+   TH2PolyQuadTree *fQuadTree;  //!Spatial index of the bins, built on demand
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   TH2PolyBin *FindPolyBin(Double_t x, Double_t y); // Finds the bin containing (x,y) within the histogram limits
+   void   BuildQuadTree();
+   void   ResetQuadTree();
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
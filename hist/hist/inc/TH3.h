@@ -85,6 +85,9 @@ public:
    virtual Int_t    Fill(Double_t x, const char *namey, Double_t z, Double_t w);
    virtual Int_t    Fill(Double_t x, Double_t y, const char *namez, Double_t w);
 
+   virtual void     FillN(Int_t, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   virtual void     FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   virtual void     FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride=1);
    virtual void     FillRandom(const char *fname, Int_t ntimes=5000);
    virtual void     FillRandom(TH1 *h, Int_t ntimes=5000);
    virtual Int_t    FindFirstBinAbove(Double_t threshold=0, Int_t axis=1) const;
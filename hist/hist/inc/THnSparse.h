@@ -48,14 +48,14 @@
 #endif
 
 class THnSparseCompactBinCoord;
+class THnSparseBinIndex;
 
 class THnSparse: public THnBase {
  private:
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseBinIndex        *fBinIndex;     //! filled bins, indexed by the hash of their compact coordinate
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -68,14 +68,17 @@ class THnSparse: public THnBase {
              const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
              Int_t chunksize);
    THnSparseCompactBinCoord* GetCompactCoord() const;
+   THnSparseBinIndex* GetBinIndex() const;
    THnSparseArrayChunk* GetChunk(Int_t idx) const {
       return (THnSparseArrayChunk*) fBinContent[idx]; }
 
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
-   void FillExMap();
+   void FillBinIndex();
    virtual TArray* GenerateArray() const = 0;
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
+   Long64_t GetBinIndexForBuffer(const Char_t* buf, ULong64_t hash, Bool_t allocate);
+   Bool_t AddSameBinning(const THnBase* h, Double_t c);
    void FillBin(Long64_t bin, Double_t w) {
       // Increment the bin content of "bin" by "w",
       // return the bin index.
@@ -114,6 +117,8 @@ class THnSparse: public THnBase {
    Long64_t GetBin(const Double_t* x, Bool_t allocate = kTRUE);
    Long64_t GetBin(const char* name[], Bool_t allocate = kTRUE);
 
+   void FillN(Int_t n, const Double_t* x, const Double_t* w = 0);
+
    void SetBinContent(const Int_t* idx, Double_t v) {
       // Forwards to THnBase::SetBinContent().
       // Non-virtual, CINT-compatible replacement of a using declaration.
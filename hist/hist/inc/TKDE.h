@@ -100,11 +100,13 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); // By default computed from the data
+   void SetNFFTPoints(UInt_t npoints); // Evaluate the fixed bandwidth estimate by FFT on a grid (0 to disable)
 
    virtual void Draw(const Option_t* option = "");
 
    Double_t operator()(Double_t x) const;
    Double_t operator()(const Double_t* x, const Double_t* p=0) const;  // Needed for creating TF1
+   void operator()(UInt_t n, const Double_t* x, Double_t* y) const; // Evaluate at n points, in parallel with implicit MT
 
    Double_t GetValue(Double_t x) const { return (*this)(x); }
    Double_t GetError(Double_t x) const;
@@ -169,6 +171,7 @@ private:
    UInt_t fNEvents;        // Data's number of events
    Double_t fSumOfCounts; // Data sum of weights
    UInt_t fUseBinsNEvents; // If the algorithm is allowed to use binning this is the minimum number of events to do so
+   UInt_t fNFFTPoints;     // Number of grid points for the FFT evaluation, 0 if not used
 
    Double_t fMean;  // Data mean
    Double_t fSigma; // Data std deviation
@@ -252,7 +255,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 2) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -340,6 +340,13 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    bool fitok = false;
 
+   ROOT::Fit::ExecutionPolicy executionPolicy = (fitOption.ExecPolicy) ?
+      ROOT::Fit::ExecutionPolicy::kMultithread : ROOT::Fit::ExecutionPolicy::kSerial;
+   // interpreted functions share the argument list of their TMethodCall and cannot be evaluated in parallel
+   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread && f1->GetMethodCall()) {
+      if (!fitOption.Quiet) Warning("Fit","Function %s is interpreted - evaluate it serially",f1->GetName());
+      executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial;
+   }
 
    // check if can use option user
    //typedef  void (* MinuitFCN_t )(int &npar, double *gin, double &f, double *u, int flag);
@@ -358,10 +365,10 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
       fitConfig.SetWeightCorrection(weight);
       bool extended = ((fitOption.Like & 4 ) != 4 );
       //if (!extended) Info("HFitImpl","Do a not -extended binned fit");
-      fitok = fitter->LikelihoodFit(*fitdata, extended);
+      fitok = fitter->LikelihoodFit(*fitdata, extended, executionPolicy);
    }
    else // standard least square fit
-      fitok = fitter->Fit(*fitdata);
+      fitok = fitter->Fit(*fitdata, executionPolicy);
 
 
    if ( !fitok  && !fitOption.Quiet )
@@ -685,6 +692,12 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
    TString opt = option;
    opt.ToUpper();
 
+   // parallel evaluation of the objective function (remove it before parsing the single letter options)
+   if (opt.Contains("MULTITHREAD")) {
+      fitOption.ExecPolicy = 1;
+      opt.ReplaceAll("MULTITHREAD","");
+   }
+
    // parse firt the specific options
    if (type == kHistogram) {
 
@@ -880,7 +893,13 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    bool extended = (fitOption.Like & 1) == 1;
 
    bool fitok = false;
-   fitok = fitter->LikelihoodFit(fitdata, extended);
+   ROOT::Fit::ExecutionPolicy executionPolicy = (fitOption.ExecPolicy) ?
+      ROOT::Fit::ExecutionPolicy::kMultithread : ROOT::Fit::ExecutionPolicy::kSerial;
+   if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread && fitfunc && fitfunc->GetMethodCall()) {
+      if (!fitOption.Quiet) Warning("UnBinFit","Function %s is interpreted - evaluate it serially",fitfunc->GetName());
+      executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial;
+   }
+   fitok = fitter->LikelihoodFit(fitdata, extended, executionPolicy);
    if ( !fitok  && !fitOption.Quiet )
       Warning("UnBinFit","Abnormal termination of minimization.");
 
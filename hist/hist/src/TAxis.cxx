@@ -26,6 +26,8 @@
 #include "TMath.h"
 #include <time.h>
 #include <cassert>
+#include <algorithm>
+#include <vector>
 
 ClassImp(TAxis)
 
@@ -41,10 +43,54 @@ Labels may be associated to individual bins.
 See examples of various axis representations drawn by class TGaxis.
 *///////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////
+/// \class TAxis::TBinLookup
+/// Uniform grid over the axis range used to find variable bins in nearly
+/// constant time. For each grid cell it stores the index of the first bin edge
+/// lying in that cell or after it, so that a search only has to look at the
+/// few edges of the cell containing x instead of the whole edge array.
+
+class TAxis::TBinLookup {
+public:
+   Double_t           fXmin;   ///< low edge of the grid
+   Double_t           fScale;  ///< number of grid cells per unit along the axis
+   Int_t              fNcells; ///< number of grid cells
+   std::vector<Int_t> fFirst;  ///< fFirst[k] is the number of edges lying in the cells before k
+
+   TBinLookup(const TAxis &axis);
+
+   /// Cell containing x. Values outside the range go to the first or last cell,
+   /// keeping the mapping monotonic.
+   Int_t GetCell(Double_t x) const {
+      Double_t t = (x - fXmin)*fScale;
+      t = (t > 0) ? t : 0;
+      return (t < fNcells - 1) ? Int_t(t) : fNcells - 1;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the grid from the bin edges of axis, with about four cells per bin.
+
+TAxis::TBinLookup::TBinLookup(const TAxis &axis)
+{
+   const Int_t kMaxCells = 65536;
+   fXmin   = axis.fXmin;
+   fNcells = (axis.fNbins < kMaxCells/4) ? TMath::Max(1, 4*axis.fNbins) : kMaxCells;
+   fScale  = fNcells/(axis.fXmax - axis.fXmin);
+   fFirst.resize(fNcells+1);
+   const Double_t *edges = axis.fXbins.fArray;
+   const Int_t nedges = axis.fXbins.fN;
+   Int_t j = 0;
+   for (Int_t k = 0; k <= fNcells; ++k) {
+      while (j < nedges && GetCell(edges[j]) < k) ++j;
+      fFirst[k] = j;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor.
 
-TAxis::TAxis(): TNamed(), TAttAxis()
+TAxis::TAxis(): TNamed(), TAttAxis(), fBinLookup(nullptr)
 {
    fNbins   = 1;
    fXmin    = 0;
@@ -61,7 +107,7 @@ TAxis::TAxis(): TNamed(), TAttAxis()
 ////////////////////////////////////////////////////////////////////////////////
 /// Axis constructor for axis with fix bin size
 
-TAxis::TAxis(Int_t nbins,Double_t xlow,Double_t xup): TNamed(), TAttAxis()
+TAxis::TAxis(Int_t nbins,Double_t xlow,Double_t xup): TNamed(), TAttAxis(), fBinLookup(nullptr)
 {
    fParent  = 0;
    fLabels  = 0;
@@ -72,7 +118,7 @@ TAxis::TAxis(Int_t nbins,Double_t xlow,Double_t xup): TNamed(), TAttAxis()
 ////////////////////////////////////////////////////////////////////////////////
 /// Axis constructor for variable bin size
 
-TAxis::TAxis(Int_t nbins,const Double_t *xbins): TNamed(), TAttAxis()
+TAxis::TAxis(Int_t nbins,const Double_t *xbins): TNamed(), TAttAxis(), fBinLookup(nullptr)
 {
    fParent  = 0;
    fLabels  = 0;
@@ -85,6 +131,7 @@ TAxis::TAxis(Int_t nbins,const Double_t *xbins): TNamed(), TAttAxis()
 
 TAxis::~TAxis()
 {
+   ResetBinLookup();
    if (fLabels) {
       fLabels->Delete();
       delete fLabels;
@@ -100,7 +147,7 @@ TAxis::~TAxis()
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy constructor.
 
-TAxis::TAxis(const TAxis &axis) : TNamed(axis), TAttAxis(axis), fLabels(0), fModLabs(0)
+TAxis::TAxis(const TAxis &axis) : TNamed(axis), TAttAxis(axis), fLabels(0), fModLabs(0), fBinLookup(nullptr)
 {
    axis.Copy(*this);
 }
@@ -217,6 +264,7 @@ void TAxis::Copy(TObject &obj) const
    axis.fLast   = fLast;
    axis.fBits2  = fBits2;
    fXbins.Copy(axis.fXbins);
+   axis.ResetBinLookup();
    axis.fTimeFormat   = fTimeFormat;
    axis.fTimeDisplay  = fTimeDisplay;
    axis.fParent       = fParent;
@@ -299,8 +347,7 @@ Int_t TAxis::FindBin(Double_t x)
       if (!fXbins.fN) {        //*-* fix bins
          bin = 1 + int (fNbins*(x-fXmin)/(fXmax-fXmin) );
       } else {                  //*-* variable bin sizes
-         //for (bin =1; x >= fXbins.fArray[bin]; bin++);
-         bin = 1 + TMath::BinarySearch(fXbins.fN,fXbins.fArray,x);
+         bin = FindVariableBin(x);
       }
    }
    return bin;
@@ -413,13 +460,88 @@ Int_t TAxis::FindFixBin(Double_t x) const
       if (!fXbins.fN) {        //*-* fix bins
          bin = 1 + int (fNbins*(x-fXmin)/(fXmax-fXmin) );
       } else {                  //*-* variable bin sizes
-//         for (bin =1; x >= fXbins.fArray[bin]; bin++);
-         bin = 1 + TMath::BinarySearch(fXbins.fN,fXbins.fArray,x);
+         bin = FindVariableBin(x);
       }
    }
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Find the bin numbers corresponding to an array of abscissas.
+///
+/// bins[i] is set to the bin containing x[i*stride], for i in [0,n), with the
+/// same underflow/overflow convention as FindFixBin(Double_t).
+/// Like FindFixBin, the axis is never extended. For fixed bins the loop is
+/// written without branches so that the compiler can vectorise it.
+
+void TAxis::FindFixBins(Int_t n, const Double_t *x, Int_t *bins, Int_t stride) const
+{
+   const Double_t xmin = fXmin;
+   const Double_t xmax = fXmax;
+   const Int_t nbins = fNbins;
+   if (!fXbins.fN) {        //*-* fix bins
+      const Double_t dnbins = nbins;
+      const Double_t range = xmax - xmin;
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i*stride];
+         // clamp before converting to int: under/overflows are overwritten below
+         Double_t t = dnbins*(xi-xmin)/range;
+         t = (t > 0) ? t : 0;
+         t = (t < dnbins) ? t : dnbins;
+         Int_t bin = 1 + Int_t(t);
+         bin = (xi < xmin) ? 0 : bin;
+         bins[i] = (xi < xmax) ? bin : nbins+1;   // note the way to catch NaN
+      }
+   } else {                  //*-* variable bin sizes
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t xi = x[i*stride];
+         if (xi < xmin)          bins[i] = 0;
+         else if (!(xi < xmax))  bins[i] = nbins+1;
+         else                    bins[i] = FindVariableBin(xi);
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Find the variable-size bin containing x, for fXmin <= x < fXmax.
+///
+/// The search is restricted to the edges of the TBinLookup grid cell containing
+/// x. The grid is built on the first call and shared by FindBin and FindFixBin;
+/// it is discarded whenever the bins or the limits of the axis change.
+/// The result is the same as 1 + TMath::BinarySearch on the bin edges.
+
+Int_t TAxis::FindVariableBin(Double_t x) const
+{
+   TBinLookup *lookup = fBinLookup.load(std::memory_order_acquire);
+   if (!lookup) {
+      TBinLookup *newLookup = new TBinLookup(*this);
+      if (fBinLookup.compare_exchange_strong(lookup, newLookup))
+         lookup = newLookup;
+      else
+         delete newLookup;  // built concurrently by another thread, lookup now points to it
+   }
+   const Double_t *edges = fXbins.fArray;
+   const Int_t nedges = fXbins.fN;
+   const Int_t cell = lookup->GetCell(x);
+   // all edges before lo are smaller than x, all edges from hi on are larger
+   Int_t lo = lookup->fFirst[cell];
+   const Int_t hi = lookup->fFirst[cell+1];
+   if (hi - lo > 8)
+      lo = std::lower_bound(edges + lo, edges + hi, x) - edges;
+   else
+      while (lo < hi && edges[lo] < x) ++lo;
+   // as in TMath::BinarySearch, an edge equal to x is the low edge of the bin
+   return (lo < nedges && edges[lo] == x) ? lo + 1 : lo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Discard the grid used to find variable bins. It is rebuilt on next use.
+
+void TAxis::ResetBinLookup()
+{
+   delete fBinLookup.exchange(nullptr);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return label for bin
 
@@ -721,6 +843,7 @@ void TAxis::Set(Int_t nbins, Double_t xlow, Double_t xup)
    fXmax    = xup;
    if (!fParent) SetDefaults();
    if (fXbins.fN > 0) fXbins.Set(0);
+   ResetBinLookup();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -738,6 +861,7 @@ void TAxis::Set(Int_t nbins, const Float_t *xbins)
          Error("TAxis::Set", "bins must be in increasing order");
    fXmin      = fXbins.fArray[0];
    fXmax      = fXbins.fArray[fNbins];
+   ResetBinLookup();
    if (!fParent) SetDefaults();
 }
 
@@ -756,6 +880,7 @@ void TAxis::Set(Int_t nbins, const Double_t *xbins)
          Error("TAxis::Set", "bins must be in increasing order");
    fXmin      = fXbins.fArray[0];
    fXmax      = fXbins.fArray[fNbins];
+   ResetBinLookup();
    if (!fParent) SetDefaults();
 }
 
@@ -1059,6 +1184,7 @@ void TAxis::SetTimeOffset(Double_t toffset, Option_t *option)
 void TAxis::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
+      ResetBinLookup();
       UInt_t R__s, R__c;
       Version_t R__v = R__b.ReadVersion(&R__s, &R__c);
       if (R__v > 5) {
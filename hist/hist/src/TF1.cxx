@@ -13,6 +13,8 @@
 #include "TROOT.h"
 #include "TMath.h"
 #include "TF1.h"
+#include "TF2.h"
+#include "TF3.h"
 #include "TH1.h"
 #include "TGraph.h"
 #include "TVirtualPad.h"
@@ -1257,6 +1259,41 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function for the n points in x with the parameters params,
+/// storing the results in out[0] to out[n-1]. The coordinates are stored
+/// one dimension after the other: coordinate i of point j is x[i * n + j].
+/// If params is 0 the current parameter values are used.
+///
+/// Functions defined by a formula are evaluated with the version of the
+/// formula compiled for arrays of points (see TFormula::EvalPar()); other
+/// functions are evaluated point by point with EvalPar().
+
+void TF1::EvalPar(Int_t n, const Double_t *x, const Double_t *params, Double_t *out)
+{
+   if (n <= 0) return;
+
+   // classes overriding EvalPar() must be evaluated point by point
+   if (fType == 0 && (IsA() == TF1::Class() || IsA() == TF2::Class() || IsA() == TF3::Class())) {
+      assert(fFormula);
+      fFormula->EvalPar(n, x, params, out);
+      if (fNormalized && fNormIntegral != 0) {
+         for (Int_t i = 0; i < n; ++i)
+            out[i] /= fNormIntegral;
+      }
+      return;
+   }
+
+   const Int_t ndim = TMath::Max(GetNdim(), 1);
+   std::vector<Double_t> point(TMath::Max(ndim, 4));
+   if (fType == 2) InitArgs(point.data(), params ? params : GetParameters());
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t idim = 0; idim < ndim; ++idim)
+         point[idim] = x[idim * n + i];
+      out[i] = EvalPar(point.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2762,7 +2799,6 @@ void TF1::Paint(Option_t *option)
 TH1 *  TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
 {
    Int_t i;
-   Double_t xv[1];
 
    TH1 * histogram = 0;
 
@@ -2823,11 +2859,11 @@ TH1 *  TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv,parameters);
-   for (i=1;i<=fNpx;i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i,EvalPar(xv,parameters));
-   }
+   std::vector<Double_t> xv(fNpx);
+   std::vector<Double_t> yv(fNpx);
+   for (i=1;i<=fNpx;i++) xv[i-1] = histogram->GetBinCenter(i);
+   EvalPar(fNpx, xv.data(), parameters, yv.data());
+   for (i=1;i<=fNpx;i++) histogram->SetBinContent(i,yv[i-1]);
 
    // Copy Function attributes to histogram attributes.
    histogram->SetBit(TH1::kNoStats);
@@ -136,6 +136,8 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// static map of function pointers of the versions evaluating arrays of points and their Cling input
+static std::unordered_map<std::string,  void *> gClingVecFunctions = std::unordered_map<std::string,  void * >();
 
 ////////////////////////////////////////////////////////////////////////////////
 Bool_t TFormula::IsOperator(const char c)
@@ -254,6 +256,7 @@ TFormula::TFormula()
    fClingName = "";
    fFormula = "";
    fLambdaPtr = nullptr;
+   fVecFuncPtr = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -299,6 +302,7 @@ TFormula::TFormula(const char *name, const char *formula, bool addToGlobList)
    fNumber = 0;
    fMethod = 0;
    fLambdaPtr = nullptr;
+   fVecFuncPtr = nullptr;
 
    FillDefaults();
 
@@ -339,6 +343,7 @@ TFormula::TFormula(const char *name, const char *formula, int ndim, int npar, bo
    fNpar = 0;
    fMethod = 0;
    fLambdaPtr = nullptr;
+   fVecFuncPtr = nullptr;
 
 
    fNdim = ndim;
@@ -385,6 +390,7 @@ TFormula::TFormula(const TFormula &formula) :
    fNumber = formula.GetNumber();
    fFormula = formula.GetExpFormula();   // returns fFormula in case of Lambda's
    fLambdaPtr = nullptr;
+   fVecFuncPtr = nullptr;
 
    // case of function based on a C++  expression (lambda's) which is ready to be compiled
    if (formula.fLambdaPtr && formula.TestBit(TFormula::kLambda)) {
@@ -585,6 +591,7 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fVecFuncPtr = fVecFuncPtr;
 
 }
 
@@ -603,6 +610,7 @@ void TFormula::Clear(Option_t * )
 
    if(fMethod) fMethod->Delete();
    fMethod = nullptr;
+   fVecFuncPtr = nullptr;
 
    fClingVariables.clear();
    fClingParameters.clear();
@@ -681,6 +689,65 @@ bool TFormula::PrepareEvalMethod()
    return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Declare to Cling a second version of the formula function, which evaluates
+/// the formula for an array of points in a simple loop the compiler can
+/// vectorize:
+/// ~~~ {.cpp}
+/// void clingName_vec(Int_t n, Double_t *xs, Double_t *p, Double_t *out);
+/// ~~~
+/// where coordinate i of point j is xs[i * n + j]. Functions of identical
+/// expressions are shared between TFormula objects.
+/// Returns false if the formula cannot be evaluated this way, e.g. for
+/// lambda expressions.
+
+Bool_t TFormula::PrepareVecEvalMethod()
+{
+   if (fVecFuncPtr) return true;
+   if (!fClingInitialized || TestBit(TFormula::kLambda) || fClingName.Length() == 0)
+      return false;
+
+   std::string clingFunc = fClingInput.Data();
+   std::size_t found = clingFunc.find("{ return ");
+   std::size_t found2 = clingFunc.rfind(" ; }");
+   if (found == std::string::npos || found2 == std::string::npos || found2 < found + 9)
+      return false;
+   std::string expression = clingFunc.substr(found + 9, found2 - found - 9);
+
+   const Int_t ndim = TMath::Max(fNdim, 1);
+   TString vecName = fClingName + "_vec";
+   TString vecInput = TString::Format("void %s(Int_t n, Double_t *xs, Double_t *p, Double_t *out) {\n"
+                                      "   for (Int_t i = 0; i < n; ++i) {\n"
+                                      "      Double_t x[%d];\n", vecName.Data(), ndim);
+   for (Int_t idim = 0; idim < ndim; ++idim)
+      vecInput += TString::Format("      x[%d] = xs[%d * n + i];\n", idim, idim);
+   vecInput += TString::Format("      out[i] = %s;\n"
+                               "   }\n"
+                               "   (void) p;\n"
+                               "}", expression.c_str());
+
+   R__LOCKGUARD2(gROOTMutex);
+   // the function may have been prepared by another thread in the meantime
+   if (fVecFuncPtr) return true;
+   // a null entry records a formula for which the array version could not be compiled
+   auto funcit = gClingVecFunctions.find(std::string(vecInput));
+   if (funcit != gClingVecFunctions.end()) {
+      fVecFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second;
+      return fVecFuncPtr != nullptr;
+   }
+
+   TInterpreter::CallFuncIFacePtr_t::Generic_t vecFuncPtr = nullptr;
+   if (gCling->Declare(vecInput)) {
+      TMethodCall method;
+      method.InitWithPrototype(vecName, "Int_t,Double_t*,Double_t*,Double_t*");
+      if (method.IsValid())
+         vecFuncPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+   }
+   gClingVecFunctions.insert(std::make_pair(std::string(vecInput), (void*) vecFuncPtr));
+   fVecFuncPtr = vecFuncPtr;
+   return fVecFuncPtr != nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///    Inputs formula, transfered to C++ code into Cling
 
@@ -1858,6 +1925,8 @@ void TFormula::ProcessFormula(TString &formula)
          fClingName = TString::Format("%s__id%zu",gNamePrefix.Data(), hasher(inputFormula) );
 
          fClingInput = TString::Format("Double_t %s(%s){ return %s ; }", fClingName.Data(),argumentsPrototype.Data(),inputFormula.c_str());
+         // the version for arrays of points is generated on demand
+         fVecFuncPtr = nullptr;
 
          // this is not needed (maybe can be re-added in case of recompilation of identical expressions
          // // check in case of a change if need to re-initialize
@@ -2569,6 +2638,41 @@ Double_t TFormula::EvalPar(const Double_t *x,const Double_t *params) const
    return DoEval(x, params);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula for n points, storing the results in out[0] to
+/// out[n-1]. The coordinates are stored one variable after the other:
+/// variable i of point j is x[i * n + j]. If params is 0 the stored
+/// parameter values are used.
+///
+/// The points are evaluated by a version of the formula function compiled
+/// for arrays of points (see PrepareVecEvalMethod()), which is much faster
+/// than calling EvalPar() for each point.
+
+void TFormula::EvalPar(Int_t n, const Double_t *x, const Double_t *params, Double_t *out) const
+{
+   if (n <= 0) return;
+
+   if (fReadyToExecute && const_cast<TFormula*>(this)->PrepareVecEvalMethod()) {
+      double * vars = const_cast<double*>(x);
+      double * pars = (params) ? const_cast<double*>(params) : const_cast<double*>(fClingParameters.data());
+      void* args[4];
+      args[0] = &n;
+      args[1] = &vars;
+      args[2] = &pars;
+      args[3] = &out;
+      (*fVecFuncPtr)(0, 4, args, 0);
+      return;
+   }
+
+   // evaluate one point at a time
+   std::vector<Double_t> point(TMath::Max(fNdim, 1));
+   for (Int_t i = 0; i < n; ++i) {
+      for (Int_t idim = 0; idim < fNdim; ++idim)
+         point[idim] = x[idim * n + i];
+      out[i] = DoEval(point.data(), params);
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets first 4  variables (e.g. x, y, z, t) and evaluate formula.
 
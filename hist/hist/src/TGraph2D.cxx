@@ -25,6 +25,8 @@
 #include "TSystem.h"
 #include <stdlib.h>
 #include <cassert>
+#include <vector>
+#include <algorithm>
 
 #include "HFitInterface.h"
 #include "Fit/DataRange.h"
@@ -108,6 +110,12 @@ drawn in 3D with one of the TGraph2D specific drawing options.
 The histogram generated by the Delaunay interpolation can be accessed using the
 `GetHistogram()` method.
 
+Once computed by the default interpolator (TGraphDelaunay2D), the Delaunay
+triangles are kept with the graph and written with it, so that a graph read
+from a file is drawn and interpolated without computing its triangulation again.
+Changing the points discards them. `Interpolate(n, x, y, z)` interpolates many
+points at once, in parallel when implicit multi-threading is enabled.
+
 The axis settings (title, ranges etc ...) can be changed accessing the axis via
 the GetXaxis GetYaxis and GetZaxis methods. They access the histogram axis created
 at drawing time only. Therefore they should called after the TGraph2D is drawn:
@@ -554,6 +562,7 @@ TGraph2D& TGraph2D::operator=(const TGraph2D &g)
    fMaximum = g.fMaximum;
    fMargin = g.fMargin;
    fZout = g.fZout;
+   fTriangles = g.fTriangles;
    fUserHisto = g.fUserHisto;
    if (g.fHistogram)
       fHistogram = (fUserHisto ) ? g.fHistogram : new TH2D(*g.fHistogram);
@@ -629,6 +638,7 @@ void TGraph2D::Clear(Option_t * /*option = "" */)
    if (fZ) delete [] fZ;
    fZ = 0;
    fSize = fNpoints = 0;
+   fTriangles.clear();
    if (fHistogram && !fUserHisto) {
       delete fHistogram;
       fHistogram = 0;
@@ -1133,6 +1143,8 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
       // new interpolation based on ROOT::Math::Delaunay
       TGraphDelaunay2D *dt = new TGraphDelaunay2D(this);
       dt->SetMarginBinsContent(fZout);
+      // use the cached triangles if any (e.g. read with the graph)
+      if (!fTriangles.empty()) dt->SetTriangles(fTriangles);
       fDelaunay = dt;
       ResetBit(kOldInterpolation);
    }
@@ -1166,21 +1178,22 @@ TH2D *TGraph2D::GetHistogram(Option_t *option)
    Double_t dx = (hxmax - hxmin) / fNpx;
    Double_t dy = (hymax - hymin) / fNpy;
 
-   Double_t x, y, z;
+   // interpolate a column of bin centres at a time
+   std::vector<Double_t> x(fNpy), y(fNpy), z(fNpy);
+   for (Int_t iy = 1; iy <= fNpy; iy++) y[iy-1] = hymin + (iy - 0.5) * dy;
 
    for (Int_t ix = 1; ix <= fNpx; ix++) {
-      x  = hxmin + (ix - 0.5) * dx;
-      for (Int_t iy = 1; iy <= fNpy; iy++) {
-         y  = hymin + (iy - 0.5) * dy;
-         // do interpolation
-         if (oldInterp)
-            z  = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
-         else
-            z  = ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-
-         fHistogram->Fill(x, y, z);
-      }
+      std::fill(x.begin(), x.end(), hxmin + (ix - 0.5) * dx);
+      // do interpolation
+      if (oldInterp) {
+         for (Int_t iy = 0; iy < fNpy; iy++)
+            z[iy] = ((TGraphDelaunay*)fDelaunay)->ComputeZ(x[iy], y[iy]);
+      } else
+         ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(fNpy, x.data(), y.data(), z.data());
+
+      for (Int_t iy = 0; iy < fNpy; iy++) fHistogram->Fill(x[iy], y[iy], z[iy]);
    }
+   if (!oldInterp && fTriangles.empty()) ((TGraphDelaunay2D*)fDelaunay)->GetTriangles(fTriangles);
 
 
    if (fMinimum != -1111) fHistogram->SetMinimum(fMinimum);
@@ -1283,9 +1296,12 @@ Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
 
    if (!fDelaunay) return TMath::QuietNaN();
 
-   if (fDelaunay->IsA() == TGraphDelaunay2D::Class() )
-      return ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
-   else if (fDelaunay->IsA() == TGraphDelaunay::Class() )
+   if (fDelaunay->IsA() == TGraphDelaunay2D::Class() ) {
+      Double_t z = ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(x, y);
+      // keep the triangles found with the graph
+      if (fTriangles.empty()) ((TGraphDelaunay2D*)fDelaunay)->GetTriangles(fTriangles);
+      return z;
+   } else if (fDelaunay->IsA() == TGraphDelaunay::Class() )
       return ((TGraphDelaunay*)fDelaunay)->ComputeZ(x, y);
 
    // cannot be here
@@ -1293,6 +1309,30 @@ Double_t TGraph2D::Interpolate(Double_t x, Double_t y)
    return TMath::QuietNaN();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Finds the z values at the n positions (x[i],y[i]) thanks to
+/// the Delaunay interpolation.
+///
+/// This is equivalent to calling Interpolate(x[i], y[i]) for each point, but
+/// with the default Delaunay interpolator (TGraphDelaunay2D) the triangle
+/// lookup is done in a single call for all the points.
+
+void TGraph2D::Interpolate(Int_t n, const Double_t *x, const Double_t *y, Double_t *z)
+{
+   if (n <= 0) return;
+
+   // the first point initializes the Delaunay interpolator if needed
+   z[0] = Interpolate(x[0], y[0]);
+
+   if (!fDelaunay) {
+      std::fill(z + 1, z + n, z[0]);
+   } else if (fDelaunay->IsA() == TGraphDelaunay2D::Class()) {
+      ((TGraphDelaunay2D*)fDelaunay)->ComputeZ(n - 1, x + 1, y + 1, z + 1);
+   } else {
+      for (Int_t i = 1; i < n; i++) z[i] = Interpolate(x[i], y[i]);
+   }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Paints this 2D graph with its current attributes
@@ -1456,6 +1496,7 @@ Int_t TGraph2D::RemovePoint(Int_t ipoint)
    fY = newY;
    fZ = newZ;
    fSize = fNpoints;
+   fTriangles.clear();
    if (fHistogram) {
       delete fHistogram;
       fHistogram = 0;
@@ -1519,6 +1560,7 @@ void TGraph2D::Set(Int_t n)
    if (n == fNpoints) return;
    if (n >  fNpoints) SetPoint(n, 0, 0, 0);
    fNpoints = n;
+   fTriangles.clear();
 }
 
 
@@ -1722,6 +1764,8 @@ void TGraph2D::SetPoint(Int_t n, Double_t x, Double_t y, Double_t z)
    fY[n]    = y;
    fZ[n]    = z;
    fNpoints = TMath::Max(fNpoints, n + 1);
+   // the cached triangles may not match the points anymore
+   fTriangles.clear();
 }
 
 
@@ -311,6 +311,7 @@ void TGraph2DErrors::Set(Int_t n)
    if (n == fNpoints) return;
    if (n >  fNpoints) SetPointError(n,0,0,0);
    fNpoints = n;
+   fTriangles.clear();
 }
 
 
@@ -353,6 +354,8 @@ void TGraph2DErrors::SetPoint(Int_t i, Double_t x, Double_t y, Double_t z)
    fX[i] = x;
    fY[i] = y;
    fZ[i] = z;
+   // the cached triangles may not match the points anymore
+   fTriangles.clear();
 }
 
 
@@ -54,3 +54,19 @@ TGraphDelaunay2D::TGraphDelaunay2D(TGraph2D *g ) :
 
 {}
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the indices of the vertices of the Delaunay triangles, three per
+/// triangle, finding the triangles if needed. They can be given back to
+/// SetTriangles() to avoid computing the triangulation of the same points again.
+
+void TGraphDelaunay2D::GetTriangles(std::vector<UInt_t> &vertices)
+{
+   fDelaunay.FindAllTriangles();
+   vertices.clear();
+   vertices.reserve(3 * fDelaunay.NumberOfTriangles());
+   for (const auto &triangle : fDelaunay) {
+      vertices.push_back(triangle.idx[0]);
+      vertices.push_back(triangle.idx[1]);
+      vertices.push_back(triangle.idx[2]);
+   }
+}
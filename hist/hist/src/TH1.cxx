@@ -3247,6 +3247,11 @@ void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method to fill histogram content from a vector
 /// called directly by TH1::BufferEmpty
+///
+/// When the axis cannot be extended, the bins of a whole batch of entries are
+/// first computed with TAxis::FindFixBins and the contents, the sum of squares
+/// of weights and the statistics are then accumulated in separate tight loops.
+/// The result is identical to filling the entries one by one.
 
 void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
@@ -3255,6 +3260,55 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+
+   if (!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) {
+      // Sumw2 is triggered by the first weight different from 1; since the
+      // bins do not change it can be called before filling
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = 0; i < ntimes; ++i) {
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      Int_t bins[kNFillBatch];
+      Double_t tsumw   = fTsumw;
+      Double_t tsumw2  = fTsumw2;
+      Double_t tsumwx  = fTsumwx;
+      Double_t tsumwx2 = fTsumwx2;
+      const Bool_t statOverflows = fgStatOverflows;
+      for (Int_t first = 0; first < ntimes; first += kNFillBatch) {
+         const Int_t n = TMath::Min(ntimes - first, Int_t(kNFillBatch));
+         const Double_t *xb = x + first*stride;
+         const Double_t *wb = (w) ? w + first*stride : 0;
+         fXaxis.FindFixBins(n, xb, bins, stride);
+         if (wb) {
+            for (i = 0; i < n; ++i) AddBinContent(bins[i], wb[i*stride]);
+            if (fSumw2.fN) {
+               for (i = 0; i < n; ++i) fSumw2.fArray[bins[i]] += wb[i*stride]*wb[i*stride];
+            }
+         } else {
+            for (i = 0; i < n; ++i) AddBinContent(bins[i]);
+            if (fSumw2.fN) {
+               for (i = 0; i < n; ++i) fSumw2.fArray[bins[i]] += 1.;
+            }
+         }
+         for (i = 0; i < n; ++i) {
+            bin = bins[i];
+            if (!statOverflows && (bin == 0 || bin > nbins)) continue;
+            Double_t z  = (wb) ? wb[i*stride] : 1.;
+            Double_t xi = xb[i*stride];
+            tsumw   += z;
+            tsumw2  += z*z;
+            tsumwx  += z*xi;
+            tsumwx2 += z*xi*xi;
+         }
+      }
+      fTsumw   = tsumw;
+      fTsumw2  = tsumw2;
+      fTsumwx  = tsumwx;
+      fTsumwx2 = tsumwx2;
+      return;
+   }
+
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
@@ -3623,6 +3677,9 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///        - "F"  If fitting a polN, switch to minuit fitter
 ///        - "S"  The result of the fit is returned in the TFitResultPtr
 ///          (see below Access to the Fit Result)
+///        - "MULTITHREAD" Evaluate the chi2 or likelihood function in parallel chunks of bins
+///          using the ROOT thread pool (requires ROOT built with imt support).
+///          The fitted function must be thread safe; interpreted functions are always evaluated serially.
 /// \param[in] goption specify a list of graphics options. See TH1::Draw for a complete list of these options.
 /// \param[in] xxmin range
 /// \param[in] xxmax range
@@ -4,6 +4,8 @@
 #include "TH1.h"
 #include "TList.h"
 
+#include <vector>
+
 class TH1Merger{
 
 public: 
@@ -61,6 +63,9 @@ private:
 
    Bool_t SameAxesMerge();
 
+   template <class ArrayType>
+   Bool_t SameAxesArrayMerge(const std::vector<TH1*> & hists);
+
    Bool_t DifferentAxesMerge();
 
    Bool_t LabelMerge();
@@ -528,6 +528,9 @@ Int_t TH2::Fill(Double_t x, const char *namey, Double_t w)
 ///     by w[i]^2 in the bin corresponding to x[i],y[i].
 ///   - If w is NULL each entry is assumed a weight=1
 ///
+/// When the axes cannot be extended, the bins of a batch of entries are searched
+/// at once with TAxis::FindFixBins, as in TH1::FillN.
+///
 /// NB: function only valid for a TH2x object
 
 void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *w, Int_t stride)
@@ -552,6 +555,71 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   // if no axis can be extended, fill by batches of entries whose bins are
+   // found at once (see TH1::DoFillN)
+   if ((!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) &&
+       (!fYaxis.CanExtend() || fYaxis.IsAlphanumeric())) {
+      const Int_t nentries = (ntimes - ifirst + stride - 1)/stride;
+      x += ifirst; y += ifirst;
+      if (w) w += ifirst;
+      fEntries += nentries;
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = 0; i < nentries; ++i) {
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Int_t nx = fXaxis.GetNbins();
+      const Int_t ny = fYaxis.GetNbins();
+      const Bool_t statOverflows = fgStatOverflows;
+      Int_t binsx[kNFillBatch];
+      Int_t binsy[kNFillBatch];
+      Double_t tsumw   = fTsumw;
+      Double_t tsumw2  = fTsumw2;
+      Double_t tsumwx  = fTsumwx;
+      Double_t tsumwx2 = fTsumwx2;
+      Double_t tsumwy  = fTsumwy;
+      Double_t tsumwy2 = fTsumwy2;
+      Double_t tsumwxy = fTsumwxy;
+      for (Int_t first = 0; first < nentries; first += kNFillBatch) {
+         const Int_t n = TMath::Min(nentries - first, Int_t(kNFillBatch));
+         const Double_t *xb = x + first*stride;
+         const Double_t *yb = y + first*stride;
+         const Double_t *wb = (w) ? w + first*stride : 0;
+         fXaxis.FindFixBins(n, xb, binsx, stride);
+         fYaxis.FindFixBins(n, yb, binsy, stride);
+         for (i = 0; i < n; ++i) {
+            bin = binsy[i]*(nx+2) + binsx[i];
+            if (wb) ww = wb[i*stride];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+         }
+         for (i = 0; i < n; ++i) {
+            binx = binsx[i];
+            biny = binsy[i];
+            if (!statOverflows && (binx == 0 || binx > nx || biny == 0 || biny > ny)) continue;
+            Double_t z  = (wb) ? wb[i*stride] : 1.;
+            Double_t xi = xb[i*stride];
+            Double_t yi = yb[i*stride];
+            tsumw   += z;
+            tsumw2  += z*z;
+            tsumwx  += z*xi;
+            tsumwx2 += z*xi*xi;
+            tsumwy  += z*yi;
+            tsumwy2 += z*yi*yi;
+            tsumwxy += z*xi*yi;
+         }
+      }
+      fTsumw   = tsumw;
+      fTsumw2  = tsumw2;
+      fTsumwx  = tsumwx;
+      fTsumwx2 = tsumwx2;
+      fTsumwy  = tsumwy;
+      fTsumwy2 = tsumwy2;
+      fTsumwxy = tsumwxy;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -17,6 +17,15 @@
 #include "TList.h"
 #include "TMath.h"
 
+#include <vector>
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 ClassImp(TH2Poly)
 
 /** \class TH2Poly
@@ -133,8 +142,156 @@ filling, it also adds a constant time delay into the code. When `Fill()`
 is to be called many times, it is more efficient to divide the histogram into
 a large number cells. However, if the histogram is to be filled only a few
 times, it is better to divide into a small number of cells.
+
+Inside the non-empty partition cells, `Fill()` and `FindBin()` locate the
+bin through a quad-tree of the bin bounding boxes (see `TH2PolyQuadTree`).
+It adapts to the local bin density, so that histograms with very non-uniform
+bins, e.g. detector geometries, are filled without testing hundreds of
+polygons per entry. The quad-tree is built at the first `Fill()` after bins
+were added and is not stored.
 */
 
+/** \class TH2PolyQuadTree
+    \ingroup Hist
+Quad-tree of the bounding boxes of the bins of a TH2Poly, used internally
+by TH2Poly to find the bin containing a point.
+
+Each node covers a rectangle; a leaf node holds the bins whose bounding box
+overlaps its rectangle, in the order of their bin number, so that the first
+bin containing a point is the same as when testing all bins in turn. A leaf
+is split into four quadrants while it holds more than kMaxLeafBins bins,
+unless splitting would not reduce the number of bins per quadrant, e.g. for
+large overlapping bins.
+*/
+
+class TH2PolyQuadTree {
+public:
+   TH2PolyQuadTree(TList *bins, Double_t xmin, Double_t xmax, Double_t ymin, Double_t ymax);
+
+   TH2PolyBin *FindBin(Double_t x, Double_t y) const;
+
+private:
+   enum {
+      kMaxLeafBins = 8, // maximum number of bins in a leaf, unless it cannot be split
+      kMaxDepth = 16    // maximum depth of the tree
+   };
+
+   struct TEntry {
+      Double_t    fXmin, fXmax, fYmin, fYmax; // bounding box of the bin
+      TH2PolyBin *fBin;
+   };
+
+   struct TNode {
+      Double_t fXmid, fYmid; // split point of the node
+      Int_t    fChild;       // index of the first of the four children, -1 for leaves
+      Int_t    fBegin;       // first entry of a leaf in fLeafEntries
+      Int_t    fEnd;         // end of the entries of a leaf in fLeafEntries
+   };
+
+   void Build(Int_t node, const std::vector<Int_t> &entries, Double_t xmin, Double_t xmax,
+              Double_t ymin, Double_t ymax, Int_t depth);
+
+   std::vector<TEntry> fEntries;     // bounding boxes of all bins
+   std::vector<TNode>  fNodes;       // nodes of the tree; the root is the first node
+   std::vector<TEntry> fLeafEntries; // entries of all leaves, one leaf after the other
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build the quad-tree for the TH2PolyBin objects in bins, covering the
+/// rectangle [xmin, xmax] x [ymin, ymax].
+
+TH2PolyQuadTree::TH2PolyQuadTree(TList *bins, Double_t xmin, Double_t xmax,
+                                 Double_t ymin, Double_t ymax)
+{
+   std::vector<Int_t> entries;
+   TIter next(bins);
+   TObject *obj;
+   while ((obj = next())) {
+      TH2PolyBin *bin = (TH2PolyBin*) obj;
+      TEntry e;
+      e.fXmin = bin->GetXMin();
+      e.fXmax = bin->GetXMax();
+      e.fYmin = bin->GetYMin();
+      e.fYmax = bin->GetYMax();
+      e.fBin = bin;
+      if (e.fXmax < xmin || e.fXmin > xmax || e.fYmax < ymin || e.fYmin > ymax) continue;
+      entries.push_back(fEntries.size());
+      fEntries.push_back(e);
+   }
+   fNodes.resize(1);
+   Build(0, entries, xmin, xmax, ymin, ymax, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Set up node covering [xmin, xmax] x [ymin, ymax] for the given entries,
+/// splitting it recursively if needed.
+
+void TH2PolyQuadTree::Build(Int_t node, const std::vector<Int_t> &entries, Double_t xmin,
+                            Double_t xmax, Double_t ymin, Double_t ymax, Int_t depth)
+{
+   const Double_t xmid = 0.5 * (xmin + xmax);
+   const Double_t ymid = 0.5 * (ymin + ymax);
+   fNodes[node].fXmid = xmid;
+   fNodes[node].fYmid = ymid;
+   fNodes[node].fChild = -1;
+
+   std::vector<Int_t> quadrant[4];
+   Bool_t split = entries.size() > (size_t)kMaxLeafBins && depth < kMaxDepth;
+   if (split) {
+      // Bins touching the split lines go into both quadrants.
+      size_t ntotal = 0;
+      for (Int_t q = 0; q < 4; ++q) {
+         const Double_t qxmin = (q & 1) ? xmid : xmin;
+         const Double_t qxmax = (q & 1) ? xmax : xmid;
+         const Double_t qymin = (q & 2) ? ymid : ymin;
+         const Double_t qymax = (q & 2) ? ymax : ymid;
+         for (size_t i = 0; i < entries.size(); ++i) {
+            const TEntry &e = fEntries[entries[i]];
+            if (e.fXmax >= qxmin && e.fXmin <= qxmax && e.fYmax >= qymin && e.fYmin <= qymax)
+               quadrant[q].push_back(entries[i]);
+         }
+         ntotal += quadrant[q].size();
+      }
+      // Splitting only pays off if most bins end up in a single quadrant.
+      split = ntotal <= 2 * entries.size();
+   }
+
+   if (!split) {
+      fNodes[node].fBegin = fLeafEntries.size();
+      for (size_t i = 0; i < entries.size(); ++i)
+         fLeafEntries.push_back(fEntries[entries[i]]);
+      fNodes[node].fEnd = fLeafEntries.size();
+      return;
+   }
+
+   const Int_t child = fNodes.size();
+   fNodes[node].fChild = child;
+   fNodes.resize(child + 4);
+   for (Int_t q = 0; q < 4; ++q) {
+      Build(child + q, quadrant[q], (q & 1) ? xmid : xmin, (q & 1) ? xmax : xmid,
+            (q & 2) ? ymid : ymin, (q & 2) ? ymax : ymid, depth + 1);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the bin with the smallest bin number containing (x,y), or 0.
+
+TH2PolyBin *TH2PolyQuadTree::FindBin(Double_t x, Double_t y) const
+{
+   Int_t node = 0;
+   while (fNodes[node].fChild >= 0) {
+      const TNode &n = fNodes[node];
+      node = n.fChild + (x >= n.fXmid) + 2 * (y >= n.fYmid);
+   }
+   const TNode &leaf = fNodes[node];
+   for (Int_t i = leaf.fBegin; i < leaf.fEnd; ++i) {
+      const TEntry &e = fLeafEntries[i];
+      if (x < e.fXmin || x > e.fXmax || y < e.fYmin || y > e.fYmax) continue;
+      if (e.fBin->IsInside(x, y)) return e.fBin;
+   }
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default Constructor. No boundaries specified.
 
@@ -177,6 +334,7 @@ TH2Poly::TH2Poly(const char *name,const char *title,
 
 TH2Poly::~TH2Poly()
 {
+   ResetQuadTree();
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
@@ -229,6 +387,7 @@ Int_t TH2Poly::AddBin(TObject *poly)
 
    fBins->Add((TObject*) bin);
    SetNewBinAdded(kTRUE);
+   ResetQuadTree();
 
    // Adds the bin to the partition matrix
    AddBinToPartition(bin);
@@ -434,6 +593,8 @@ void TH2Poly::ChangePartition(Int_t n, Int_t m)
    fCellX = n;                          // Set the number of cells
    fCellY = m;                          // Set the number of cells
 
+   ResetQuadTree();                     // The histogram limits might have changed
+
    delete [] fCells;                    // Deletes the old partition
 
    // number of cells in the grid
@@ -546,6 +707,18 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
+   TH2PolyBin *bin = FindPolyBin(x, y);
+
+   // If the search has not returned a bin, the point must be on "the sea"
+   return bin ? bin->GetBinNumber() : -5;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the bin containing (x,y), or 0 if (x,y) is on "the sea". (x,y) must
+/// be within the histogram limits.
+
+TH2PolyBin *TH2Poly::FindPolyBin(Double_t x, Double_t y)
+{
    // Finds the cell (x,y) coordinates belong to
    Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
    Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
@@ -556,21 +729,30 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    if (n<0)       n = 0;
    if (m<0)       m = 0;
 
-   if (fIsEmpty[n+fCellX*m]) return -5;
+   if (fIsEmpty[n+fCellX*m]) return 0;
 
-   TH2PolyBin *bin;
+   // Search for the bin in the quad-tree
+   if (!fQuadTree) BuildQuadTree();
+   return fQuadTree->FindBin(x, y);
+}
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
+////////////////////////////////////////////////////////////////////////////////
+/// Builds the quad-tree of the bins, deleting the previous one if any.
 
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
-   }
+void TH2Poly::BuildQuadTree()
+{
+   delete fQuadTree;
+   fQuadTree = new TH2PolyQuadTree(fBins, fXaxis.GetXmin(), fXaxis.GetXmax(),
+                                   fYaxis.GetXmin(), fYaxis.GetXmax());
+}
 
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+////////////////////////////////////////////////////////////////////////////////
+/// Deletes the quad-tree of the bins; it is rebuilt when needed.
+
+void TH2Poly::ResetQuadTree()
+{
+   delete fQuadTree;
+   fQuadTree = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -600,50 +782,27 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
+   TH2PolyBin *bin = FindPolyBin(x, y);
+   if (!bin) {
       fOverflow[4]++;
       return -5;
    }
 
-   TH2PolyBin *bin;
-   Int_t bi;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      bi = bin->GetBinNumber()-1;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) fSumw2.fArray[bi] += w*w;
-         fEntries++;
+   Int_t bi = bin->GetBinNumber()-1;
+   bin->Fill(w);
 
-         SetBinContentChanged(kTRUE);
+   // Statistics
+   fTsumw   = fTsumw + w;
+   fTsumwx  = fTsumwx + w*x;
+   fTsumwx2 = fTsumwx2 + w*x*x;
+   fTsumwy  = fTsumwy + w*y;
+   fTsumwy2 = fTsumwy2 + w*y*y;
+   if (fSumw2.fN) fSumw2.fArray[bi] += w*w;
+   fEntries++;
 
-         return bin->GetBinNumber();
-      }
-   }
+   SetBinContentChanged(kTRUE);
 
-   fOverflow[4]++;
-   return -5;
+   return bin->GetBinNumber();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -677,14 +836,72 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights; if NULL all weights are 1
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// When implicit multi-threading is enabled (ROOT::EnableImplicitMT()) and
+/// many entries are given, the bins containing the entries are searched in
+/// parallel, in chunks of entries. The bins are then filled sequentially in
+/// the order of the entries, so that the result is identical to calling
+/// Fill() for each entry.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
+#ifdef R__USE_IMT
+   const Int_t kEntriesPerTask = 1024;
+   if (ROOT::IsImplicitMTEnabled() && fNcells > 0 && ntimes >= 2 * kEntriesPerTask) {
+      // the quad-tree must exist before the concurrent (read-only) searches
+      if (!fQuadTree) BuildQuadTree();
+
+      // bin of each entry, or 0 for the overflow/underflow/sea bin in code
+      std::vector<TH2PolyBin *> bins(ntimes);
+      std::vector<Int_t> code(ntimes);
+      auto findBins = [&](UInt_t itask) {
+         Int_t first = itask * kEntriesPerTask;
+         Int_t last = TMath::Min(first + kEntriesPerTask, ntimes);
+         for (Int_t i = first; i < last; ++i) {
+            Double_t xi = x[(Long64_t)i * stride];
+            Double_t yi = y[(Long64_t)i * stride];
+            Int_t overflow = 0;
+            if      (yi > fYaxis.GetXmax()) overflow += -1;
+            else if (yi > fYaxis.GetXmin()) overflow += -4;
+            else                            overflow += -7;
+            if      (xi > fXaxis.GetXmax()) overflow += -2;
+            else if (xi > fXaxis.GetXmin()) overflow += -1;
+            bins[i] = (overflow == -5) ? FindPolyBin(xi, yi) : 0;
+            code[i] = overflow;
+         }
+         return 0;
+      };
+      auto pool = ROOT::Internal::GetImplicitMTExecutor();
+      pool->Map(findBins, ROOT::TSeq<UInt_t>((ntimes + kEntriesPerTask - 1) / kEntriesPerTask));
+
+      for (Int_t i = 0; i < ntimes; ++i) {
+         TH2PolyBin *bin = bins[i];
+         if (!bin) {
+            fOverflow[-code[i] - 1]++;
+            continue;
+         }
+         Double_t xi = x[(Long64_t)i * stride];
+         Double_t yi = y[(Long64_t)i * stride];
+         Double_t wi = w ? w[(Long64_t)i * stride] : 1.;
+         bin->Fill(wi);
+         fTsumw   = fTsumw + wi;
+         fTsumwx  = fTsumwx + wi*xi;
+         fTsumwx2 = fTsumwx2 + wi*xi*xi;
+         fTsumwy  = fTsumwy + wi*yi;
+         fTsumwy2 = fTsumwy2 + wi*yi*yi;
+         if (fSumw2.fN) fSumw2.fArray[bin->GetBinNumber() - 1] += wi*wi;
+         fEntries++;
+      }
+      SetBinContentChanged(kTRUE);
+      return;
+   }
+#endif
+   ntimes *= stride;
    for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+      Fill(x[i], y[i], w ? w[i] : 1.);
    }
 }
 
@@ -931,6 +1148,7 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
 
    fBins   = 0;
    fNcells = 0;
+   fQuadTree = 0;
 
    // Sets the boundaries of the histogram
    fXaxis.Set(100, xlow, xup);
@@ -1452,6 +1670,32 @@ Double_t TH2PolyBin::GetYMin()
    return fYmin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the point (xp,yp) is inside the polygon defined by the np
+/// points in arrays x and y. Same result as TMath::IsInside(), but the
+/// crossings are counted without branches, such that the loop over the
+/// edges can be vectorized by the compiler.
+
+static Bool_t IsInsidePolygon(Double_t xp, Double_t yp, Int_t np, const Double_t *x, const Double_t *y)
+{
+   if (np <= 0) return kFALSE;
+
+   // The edge from the last to the first point.
+   Bool_t straddle = (y[0] < yp && y[np-1] >= yp) || (y[np-1] < yp && y[0] >= yp);
+   Int_t crossings = straddle && x[0] + (yp - y[0]) / (y[np-1] - y[0]) * (x[np-1] - x[0]) < xp;
+
+   for (Int_t i = 1; i < np; ++i) {
+      const Int_t below = (y[i] < yp) & (y[i-1] >= yp);
+      const Int_t above = (y[i-1] < yp) & (y[i] >= yp);
+      const Int_t cross = below | above;
+      // avoid the division by 0 for horizontal edges that are not crossed
+      const Double_t dy = cross ? y[i-1] - y[i] : 1.;
+      crossings += cross & (x[i] + (yp - y[i]) / dy * (x[i-1] - x[i]) < xp);
+   }
+
+   return crossings & 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return "true" if the point (x,y) is inside the bin.
 
@@ -1461,12 +1705,19 @@ Bool_t TH2PolyBin::IsInside(Double_t x, Double_t y) const
 
    if (fPoly->IsA() == TGraph::Class()) {
       TGraph *g = (TGraph*)fPoly;
-      in = g->IsInside(x, y);
+      in = IsInsidePolygon(x, y, g->GetN(), g->GetX(), g->GetY());
    }
 
    if (fPoly->IsA() == TMultiGraph::Class()) {
       TMultiGraph *mg = (TMultiGraph*)fPoly;
-      in = mg->IsInside(x, y);
+      TList *gl = mg->GetListOfGraphs();
+      if (!gl) return in;
+      TGraph *g;
+      TIter next(gl);
+      while ((g = (TGraph*) next())) {
+         in = IsInsidePolygon(x, y, g->GetN(), g->GetX(), g->GetY());
+         if (in) break;
+      }
    }
 
    return in;
@@ -641,6 +641,135 @@ Int_t TH3::Fill(Double_t x, Double_t y, const char *namez, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// When the axes cannot be extended, the bins of a batch of entries are searched
+/// at once with TAxis::FindFixBins, as in TH1::FillN.
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   ntimes *= stride;
+   Int_t ifirst = 0;
+
+   //If a buffer is activated, fill buffer
+   if (fBuffer) {
+      for (i=0;i<ntimes;i+=stride) {
+         if (!fBuffer) break; // buffer can be deleted in BufferFill when is empty
+         if (w) BufferFill(x[i],y[i],z[i],w[i]);
+         else BufferFill(x[i],y[i],z[i],1.);
+      }
+      // fill the remaining entries if the buffer has been deleted
+      if (i < ntimes && fBuffer==0)
+         ifirst = i;
+      else
+         return;
+   }
+
+   Double_t ww = 1;
+
+   if ((!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) &&
+       (!fYaxis.CanExtend() || fYaxis.IsAlphanumeric()) &&
+       (!fZaxis.CanExtend() || fZaxis.IsAlphanumeric())) {
+      const Int_t nentries = (ntimes - ifirst + stride - 1)/stride;
+      x += ifirst; y += ifirst; z += ifirst;
+      if (w) w += ifirst;
+      fEntries += nentries;
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = 0; i < nentries; ++i) {
+            if (w[i*stride] != 1.0) { Sumw2(); break; }
+         }
+      }
+      const Int_t nx = fXaxis.GetNbins();
+      const Int_t ny = fYaxis.GetNbins();
+      const Int_t nz = fZaxis.GetNbins();
+      const Bool_t statOverflows = fgStatOverflows;
+      Int_t binsx[kNFillBatch];
+      Int_t binsy[kNFillBatch];
+      Int_t binsz[kNFillBatch];
+      Double_t tsumw   = fTsumw;
+      Double_t tsumw2  = fTsumw2;
+      Double_t tsumwx  = fTsumwx;
+      Double_t tsumwx2 = fTsumwx2;
+      Double_t tsumwy  = fTsumwy;
+      Double_t tsumwy2 = fTsumwy2;
+      Double_t tsumwxy = fTsumwxy;
+      Double_t tsumwz  = fTsumwz;
+      Double_t tsumwz2 = fTsumwz2;
+      Double_t tsumwxz = fTsumwxz;
+      Double_t tsumwyz = fTsumwyz;
+      for (Int_t first = 0; first < nentries; first += kNFillBatch) {
+         const Int_t n = TMath::Min(nentries - first, Int_t(kNFillBatch));
+         const Double_t *xb = x + first*stride;
+         const Double_t *yb = y + first*stride;
+         const Double_t *zb = z + first*stride;
+         const Double_t *wb = (w) ? w + first*stride : 0;
+         fXaxis.FindFixBins(n, xb, binsx, stride);
+         fYaxis.FindFixBins(n, yb, binsy, stride);
+         fZaxis.FindFixBins(n, zb, binsz, stride);
+         for (i = 0; i < n; ++i) {
+            bin = binsx[i] + (nx+2)*(binsy[i] + (ny+2)*binsz[i]);
+            if (wb) ww = wb[i*stride];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+         }
+         for (i = 0; i < n; ++i) {
+            binx = binsx[i];
+            biny = binsy[i];
+            binz = binsz[i];
+            if (!statOverflows && (binx == 0 || binx > nx || biny == 0 || biny > ny ||
+                                   binz == 0 || binz > nz)) continue;
+            Double_t v  = (wb) ? wb[i*stride] : 1.;
+            Double_t xi = xb[i*stride];
+            Double_t yi = yb[i*stride];
+            Double_t zi = zb[i*stride];
+            tsumw   += v;
+            tsumw2  += v*v;
+            tsumwx  += v*xi;
+            tsumwx2 += v*xi*xi;
+            tsumwy  += v*yi;
+            tsumwy2 += v*yi*yi;
+            tsumwxy += v*xi*yi;
+            tsumwz  += v*zi;
+            tsumwz2 += v*zi*zi;
+            tsumwxz += v*xi*zi;
+            tsumwyz += v*yi*zi;
+         }
+      }
+      fTsumw   = tsumw;
+      fTsumw2  = tsumw2;
+      fTsumwx  = tsumwx;
+      fTsumwx2 = tsumwx2;
+      fTsumwy  = tsumwy;
+      fTsumwy2 = tsumwy2;
+      fTsumwxy = tsumwxy;
+      fTsumwz  = tsumwz;
+      fTsumwz2 = tsumwz2;
+      fTsumwxz = tsumwxz;
+      fTsumwyz = tsumwyz;
+      return;
+   }
+
+   for (i=ifirst;i<ntimes;i+=stride) {
+      if (w) ww = w[i];
+      Fill(x[i],y[i],z[i],ww);
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
 ///
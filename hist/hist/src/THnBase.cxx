@@ -643,6 +643,12 @@ void THnBase::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
       Sumw2();
    Bool_t haveErrors = GetCalculateErrors();
 
+   // Let the storage add the bins directly if it knows how to
+   if (!rebinned && AddSameBinning(h, c)) {
+      SetEntries(GetEntries() + c * h->GetEntries());
+      return;
+   }
+
    Double_t* x = 0;
    if (rebinned) {
       x = new Double_t[fNdimensions];
@@ -998,6 +1004,17 @@ Bool_t THnBase::CheckConsistency(const THnBase *h, const char *tag) const
    return kTRUE;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries. x holds the coordinates of the entries one after the
+/// other, i.e. coordinate d of entry i is x[i * GetNdimensions() + d].
+/// w holds the n weights; if w is NULL all weights are 1.
+
+void THnBase::FillN(Int_t n, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   for (Int_t i = 0; i < n; ++i)
+      Fill(x + i * fNdimensions, w ? w[i] : 1.);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set the axis # of bins and bin limits on dimension idim
 
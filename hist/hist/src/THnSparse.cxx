@@ -17,6 +17,16 @@
 #include "TDataMember.h"
 #include "TDataType.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 namespace {
 //______________________________________________________________________________
 //
@@ -410,6 +420,111 @@ THnSparseCompactBinCoord::~THnSparseCompactBinCoord()
    delete [] fCurrentBin;
 }
 
+/** \class THnSparseBinIndex
+THnSparseBinIndex is a class used by THnSparse internally. It maps the hash
+of a compact bin coordinate to the linear index of the bin. It is an
+open-addressing hash table with linear probing: keys and values are kept
+in two separate arrays whose size is a power of two, at most half filled.
+Slots are found by a multiplicative hash of the key, which spreads the
+mostly low-entropy compact coordinates over the table.
+
+Several bins can share the same key if the compact coordinates do not fit
+into 8 bytes; they simply occupy successive slots of the probe sequence,
+and the caller compares the coordinates of each candidate.
+*/
+
+class THnSparseBinIndex {
+public:
+   THnSparseBinIndex(): fBits(0), fSize(0), fKeys(0), fValues(0) {}
+   ~THnSparseBinIndex() { Clear(); }
+
+   Long64_t  GetSize() const { return fSize; }
+   Long64_t  GetCapacity() const { return fBits ? (1LL << fBits) : 0; }
+
+   /// First slot of the probe sequence of key; requires GetCapacity() > 0.
+   Long64_t  GetFirstSlot(ULong64_t key) const {
+      return (Long64_t)((key * 0x9E3779B97F4A7C15ULL) >> (64 - fBits));
+   }
+   Long64_t  GetNextSlot(Long64_t slot) const { return (slot + 1) & (GetCapacity() - 1); }
+   ULong64_t GetKey(Long64_t slot) const { return fKeys[slot]; }
+   /// Value stored in slot; 0 for an empty slot.
+   Long64_t  GetValue(Long64_t slot) const { return fValues ? fValues[slot] : 0; }
+
+   void Clear();
+   void Insert(ULong64_t key, Long64_t value);
+   void Reserve(Long64_t n);
+
+private:
+   THnSparseBinIndex(const THnSparseBinIndex&); // intentionally not implemented
+   THnSparseBinIndex& operator=(const THnSparseBinIndex&); // intentionally not implemented
+
+   Int_t      fBits;   // log2 of the number of slots
+   Long64_t   fSize;   // number of filled slots
+   ULong64_t *fKeys;   //[1 << fBits] keys
+   Long64_t  *fValues; //[1 << fBits] values, 0 for empty slots
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove all entries and release the memory.
+
+void THnSparseBinIndex::Clear()
+{
+   delete [] fKeys;
+   delete [] fValues;
+   fKeys = 0;
+   fValues = 0;
+   fBits = 0;
+   fSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the non-zero value with the given key; the key is not checked for
+/// duplicates.
+
+void THnSparseBinIndex::Insert(ULong64_t key, Long64_t value)
+{
+   Reserve(fSize + 1);
+   Long64_t slot = GetFirstSlot(key);
+   while (fValues[slot])
+      slot = GetNextSlot(slot);
+   fKeys[slot] = key;
+   fValues[slot] = value;
+   ++fSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Make sure that n entries can be stored while keeping the table at most
+/// half filled; rehashes the existing entries if the table grows.
+
+void THnSparseBinIndex::Reserve(Long64_t n)
+{
+   Int_t bits = fBits ? fBits : 4;
+   while ((1LL << bits) < 2 * n) ++bits;
+   if (bits == fBits) return;
+
+   const Long64_t oldCapacity = GetCapacity();
+   ULong64_t *oldKeys = fKeys;
+   Long64_t *oldValues = fValues;
+
+   fBits = bits;
+   const Long64_t capacity = GetCapacity();
+   fKeys = new ULong64_t[capacity];
+   fValues = new Long64_t[capacity];
+   memset(fValues, 0, capacity * sizeof(Long64_t));
+   for (Long64_t i = 0; i < oldCapacity; ++i) {
+      if (!oldValues[i]) continue;
+      Long64_t slot = GetFirstSlot(oldKeys[i]);
+      while (fValues[slot])
+         slot = GetNextSlot(slot);
+      fKeys[slot] = oldKeys[i];
+      fValues[slot] = oldValues[i];
+   }
+   delete [] oldKeys;
+   delete [] oldValues;
+}
+
+
 /** \class THnSparseArrayChunk
 THnSparseArrayChunk is used internally by THnSparse.
 THnSparse stores its (dynamic size) array of bin coordinates and their
@@ -571,14 +686,20 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
-retrieve the matching bin.
+This hash is used to lookup the linear index in the open-addressing hash
+table fBinIndex (see THnSparseBinIndex). For each slot of the probe sequence
+with the same hash, the coordinates of the bin it points to are compared to
+the coordinates passed to GetBin(). They can only differ if the compact bin
+coordinates are larger than 8 bytes, where the hash is not unique - which
+is extremely unlikely but possible.
+
+## Bulk Filling and Merging
+FillN() fills many entries at once. When the compact bin coordinates fit into
+8 bytes, the entries are sorted by bin and each distinct bin is looked up
+only once, which is much faster than calling Fill() for each entry of
+a histogram with many dimensions. Adding or merging THnSparse objects with
+the same binning works directly on the compact coordinates, without
+unpacking and re-packing the coordinates of every bin.
 */
 
 
@@ -588,7 +709,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBinIndex(0), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +726,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBinIndex(0), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -615,6 +736,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
 /// Destruct a THnSparse
 
 THnSparse::~THnSparse() {
+   delete fBinIndex;
    delete fCompactCoord;
 }
 
@@ -651,36 +773,23 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+///We have been streamed; set up fBinIndex
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinIndex()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
-   THnSparseCoordCompression compactCoord(*GetCompactCoord());
+   const THnSparseCompactBinCoord* compactCoord = GetCompactCoord();
+   THnSparseBinIndex* index = GetBinIndex();
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   index->Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         index->Insert(compactCoord->GetHashFromBuffer(buf), idx + 1);
    }
 }
 
@@ -688,12 +797,10 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   if (!GetBinIndex()->GetSize() && fBinContent.GetSize()) {
+      FillBinIndex();
    }
+   GetBinIndex()->Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -737,6 +844,75 @@ Long64_t THnSparse::GetBin(const Int_t* coord, Bool_t allocate /*= kTRUE*/)
    return GetBinIndexForCurrentBin(allocate);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill n entries. x holds the coordinates of the entries one after the
+/// other, i.e. coordinate d of entry i is x[i * GetNdimensions() + d].
+/// w holds the n weights; if w is NULL all weights are 1.
+///
+/// If the compact bin coordinates fit into 8 bytes, the bins of a batch of
+/// entries are computed first; the entries are then sorted by bin, and the
+/// weights of all entries falling into the same bin are added with a single
+/// bin lookup. Bins that did not exist yet are thus allocated in the order
+/// of their coordinates rather than in the order of the entries.
+
+void THnSparse::FillN(Int_t n, const Double_t* x, const Double_t* w /*= 0*/)
+{
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   Bool_t canExtend = kFALSE;
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      canExtend |= GetAxis(d)->CanExtend();
+   if (cc->GetBufferSize() > 8 || canExtend) {
+      // the hash is not the coordinate itself, or the axes might need to be
+      // extended: fill one by one
+      THnBase::FillN(n, x, w);
+      return;
+   }
+
+   const Int_t kBatchSize = 4096;
+   const Int_t batchSize = TMath::Min(n, kBatchSize);
+   std::vector<Int_t> coord(batchSize * fNdimensions);
+   std::vector<Int_t> axisBins(batchSize);
+   std::vector<std::pair<ULong64_t, Int_t> > keys(batchSize);
+   Char_t buf[sizeof(ULong64_t)];
+
+   for (Int_t first = 0; first < n; first += batchSize) {
+      const Int_t nb = TMath::Min(n - first, batchSize);
+      const Double_t* xb = x + (Long64_t)first * fNdimensions;
+      const Double_t* wb = w ? w + first : 0;
+      for (Int_t d = 0; d < fNdimensions; ++d) {
+         GetAxis(d)->FindFixBins(nb, xb + d, &axisBins[0], fNdimensions);
+         for (Int_t i = 0; i < nb; ++i)
+            coord[i * fNdimensions + d] = axisBins[i];
+      }
+      for (Int_t i = 0; i < nb; ++i) {
+         keys[i].first = cc->SetBufferFromCoord(&coord[i * fNdimensions], buf);
+         keys[i].second = i;
+         const Double_t wi = wb ? wb[i] : 1.;
+         UpdateXStat(xb + i * fNdimensions, wi);
+         FillBinBase(wi);
+      }
+      std::sort(keys.begin(), keys.begin() + nb);
+
+      for (Int_t i = 0; i < nb;) {
+         const ULong64_t key = keys[i].first;
+         Double_t sumw = 0.;
+         Double_t sumw2 = 0.;
+         for (; i < nb && keys[i].first == key; ++i) {
+            const Double_t wi = wb ? wb[keys[i].second] : 1.;
+            sumw += wi;
+            sumw2 += wi * wi;
+         }
+         memcpy(buf, &key, sizeof(ULong64_t));
+         Long64_t bin = GetBinIndexForBuffer(buf, key, kTRUE);
+         THnSparseArrayChunk* chunk = GetChunk(bin / fChunkSize);
+         bin %= fChunkSize;
+         chunk->fContent->SetAt(sumw + chunk->fContent->GetAt(bin), bin);
+         if (chunk->fSumw2)
+            chunk->fSumw2->SetAt(sumw2 + chunk->fSumw2->GetAt(bin), bin);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the content of the filled bin number "idx".
 /// If coord is non-null, it will contain the bin's coordinates for each axis
@@ -790,20 +966,30 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
 Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
 {
    THnSparseCompactBinCoord* cc = GetCompactCoord();
-   ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
+   return GetBinIndexForBuffer(cc->GetBuffer(), cc->GetHash(), allocate);
+}
 
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin with compact coordinate buf and its hash.
+/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
 
-      linidx = nextlinidx;
+Long64_t THnSparse::GetBinIndexForBuffer(const Char_t* buf, ULong64_t hash, Bool_t allocate)
+{
+   THnSparseBinIndex* index = GetBinIndex();
+   if (fBinContent.GetSize() && !index->GetSize())
+      FillBinIndex();
+   if (index->GetSize()) {
+      Long64_t slot = index->GetFirstSlot(hash);
+      Long64_t linidx = 0;
+      while ((linidx = index->GetValue(slot))) {
+         // the index stores index + 1, 0 is "empty slot"
+         if (index->GetKey(slot) == hash) {
+            THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
+            if (chunk->Matches((linidx - 1) % fChunkSize, buf))
+               return linidx - 1;
+         }
+         slot = index->GetNextSlot(slot);
+      }
    }
    if (!allocate) return -1;
 
@@ -816,23 +1002,87 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, buf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   index->Insert(hash, newidx + 1);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add c times h to this, if h is a THnSparse with the same binning.
+/// The compact coordinates of the bins of h are used as they are.
+/// The bins of h that already exist in this are looked up and added first; this
+/// only reads the bin index and each bin of this is updated by a single bin of h,
+/// so it is done in parallel, one task per chunk of h, when implicit
+/// multi-threading is enabled. The remaining bins are then appended in order.
+/// Return kFALSE if h cannot be added this way.
+
+Bool_t THnSparse::AddSameBinning(const THnBase* h, Double_t c)
+{
+   const THnSparse* hs = dynamic_cast<const THnSparse*>(h);
+   if (!hs)
+      return kFALSE;
+   // the compact coordinates are only compatible for identical numbers of bins
+   for (Int_t d = 0; d < fNdimensions; ++d)
+      if (hs->GetAxis(d)->GetNbins() != GetAxis(d)->GetNbins())
+         return kFALSE;
+
+   const THnSparseCompactBinCoord* cc = GetCompactCoord();
+   const Bool_t haveErrors = GetCalculateErrors();
+   // also builds the bin index, which is not modified by the lookups below
+   Reserve(GetNbins() + hs->GetNbins());
+
+   // the number of chunks and bins of hs is fixed, even if hs == this
+   const Int_t nchunks = hs->GetNChunks();
+   const Int_t hsChunkSize = hs->GetChunkSize();
+   // bins of hs (by chunk) that are not yet filled in this
+   std::vector<std::vector<Int_t> > missing(nchunks);
+
+   auto addExisting = [&](UInt_t ichunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(ichunk);
+      const Int_t nentries = chunk->GetEntries();
+      const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
+      for (Int_t i = 0; i < nentries; ++i) {
+         const Char_t* buf = chunk->fCoordinates + i * singleCoordSize;
+         const Long64_t mybinidx = GetBinIndexForBuffer(buf, cc->GetHashFromBuffer(buf), kFALSE);
+         if (mybinidx < 0) {
+            missing[ichunk].push_back(i);
+            continue;
+         }
+         THnSparseArrayChunk* mychunk = GetChunk(mybinidx / fChunkSize);
+         const Int_t mybin = mybinidx % fChunkSize;
+         if (haveErrors)
+            (*mychunk->fSumw2)[mybin] += hs->GetBinError2((Long64_t)ichunk * hsChunkSize + i) * c * c;
+         mychunk->fContent->SetAt(mychunk->fContent->GetAt(mybin) + c * chunk->fContent->GetAt(i), mybin);
+      }
+      return 0;
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1) {
+      auto pool = ROOT::Internal::GetImplicitMTExecutor();
+      pool->Map(addExisting, ROOT::TSeq<UInt_t>(nchunks));
+   } else
+#endif
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk) addExisting(ichunk);
+
+   // new bins, allocated in the order of hs
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk) {
+      const THnSparseArrayChunk* chunk = hs->GetChunk(ichunk);
+      const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
+      for (std::vector<Int_t>::const_iterator it = missing[ichunk].begin(); it != missing[ichunk].end(); ++it) {
+         const Char_t* buf = chunk->fCoordinates + (*it) * singleCoordSize;
+         const Long64_t mybinidx = GetBinIndexForBuffer(buf, cc->GetHashFromBuffer(buf), kTRUE);
+         if (haveErrors)
+            AddBinError2(mybinidx, hs->GetBinError2((Long64_t)ichunk * hsChunkSize + *it) * c * c);
+         AddBinContent(mybinidx, c * chunk->fContent->GetAt(*it));
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -849,6 +1099,16 @@ THnSparseCompactBinCoord* THnSparse::GetCompactCoord() const
    return fCompactCoord;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return THnSparseBinIndex object.
+
+THnSparseBinIndex* THnSparse::GetBinIndex() const
+{
+   if (!fBinIndex)
+      const_cast<THnSparse*>(this)->fBinIndex = new THnSparseBinIndex();
+   return fBinIndex;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the amount of filled bins over all bins
 
@@ -881,7 +1141,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += (sizeof(ULong64_t) + sizeof(Long64_t)) * GetBinIndex()->GetCapacity() /* THnSparseBinIndex */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -963,8 +1223,7 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   GetBinIndex()->Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -22,6 +22,20 @@
  
  The algorithm is briefly described in (4). A binned version is also implemented to address the 
  performance issue due to its data size dependance.
+
+ For the built-in kernels, which vanish beyond a few bandwidths, the data are kept sorted and
+ only the kernels of the data within this range around the evaluation point are summed.
+
+ With SetNFFTPoints(npoints), the estimate with the fixed bandwidth is instead computed once on a
+ regular grid of npoints points (rounded up to a power of two): the data are linearly binned on
+ the grid and convolved with the kernel by FFT (TVirtualFFT if the FFTW plugin is available, an
+ internal radix-2 transform otherwise). The estimate at any point is then linearly interpolated
+ on the grid. With the adaptive iteration, the grid is used for the pilot estimate from which
+ the adaptive bandwidths are computed, while the final estimate is summed directly. This mode
+ is available for the built-in kernels only.
+
+ Many points can be evaluated at once with operator()(n, x, y); with implicit multi-threading
+ enabled (ROOT::EnableImplicitMT()) the points are evaluated in parallel.
  */
 
 
@@ -30,6 +44,7 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <complex>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -42,7 +57,99 @@
 #include "TH1.h"
 #include "TCanvas.h"
 #include "TKDE.h"
+#include "TVirtualFFT.h"
+#include "TPluginManager.h"
+#include "TROOT.h"
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+
+namespace {
+
+// In-place complex FFT of a power of two number of points (radix-2, decimation in time)
+void Radix2FFT(std::vector<std::complex<Double_t> > & a, Bool_t inverse) {
+   UInt_t n = a.size();
+   for (UInt_t i = 1, j = 0; i < n; ++i) {
+      UInt_t bit = n >> 1;
+      for (; j & bit; bit >>= 1) j ^= bit;
+      j ^= bit;
+      if (i < j) std::swap(a[i], a[j]);
+   }
+   std::vector<std::complex<Double_t> > twiddle(n / 2);
+   for (UInt_t k = 0; k < n / 2; ++k) {
+      twiddle[k] = std::polar(1.0, (inverse ? 2. : -2.) * M_PI * k / n);
+   }
+   for (UInt_t len = 2; len <= n; len <<= 1) {
+      UInt_t stride = n / len;
+      for (UInt_t i = 0; i < n; i += len) {
+         for (UInt_t j = 0; j < len / 2; ++j) {
+            std::complex<Double_t> u = a[i + j];
+            std::complex<Double_t> v = a[i + j + len / 2] * twiddle[j * stride];
+            a[i + j] = u + v;
+            a[i + j + len / 2] = u - v;
+         }
+      }
+   }
+}
+
+// Whether the FFTW plugin of TVirtualFFT can be loaded; checked once, since without it
+// TVirtualFFT::FFT reports an error at every call
+Bool_t HasFFTPlugin() {
+   static const Bool_t hasPlugin = []() {
+      TPluginHandler *h = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", "fftwr2c");
+      return h != 0 && h->CheckPlugin() != -1;
+   }();
+   return hasPlugin;
+}
+
+// Circular convolution of the real sequences a and b (of the same power of two size), returned in a
+void FFTConvolve(std::vector<Double_t> & a, const std::vector<Double_t> & b) {
+   Int_t n = a.size();
+   TVirtualFFT *fftA = (HasFFTPlugin()) ? TVirtualFFT::FFT(1, &n, "R2C ES K") : 0;
+   TVirtualFFT *fftB = (fftA) ? TVirtualFFT::FFT(1, &n, "R2C ES K") : 0;
+   TVirtualFFT *fftInv = (fftB) ? TVirtualFFT::FFT(1, &n, "C2R ES K") : 0;
+   if (fftA && fftB && fftInv) {
+      for (Int_t i = 0; i < n; ++i) {
+         fftA->SetPoint(i, a[i]);
+         fftB->SetPoint(i, b[i]);
+      }
+      fftA->Transform();
+      fftB->Transform();
+      Double_t re1, im1, re2, im2;
+      for (Int_t i = 0; i <= n / 2; ++i) {
+         fftA->GetPointComplex(i, re1, im1);
+         fftB->GetPointComplex(i, re2, im2);
+         fftInv->SetPoint(i, re1 * re2 - im1 * im2, re1 * im2 + re2 * im1);
+      }
+      fftInv->Transform();
+      for (Int_t i = 0; i < n; ++i) {
+         a[i] = fftInv->GetPointReal(i) / n;
+      }
+   } else {
+      // no FFT plugin: use the internal transform
+      std::vector<std::complex<Double_t> > ca(a.begin(), a.end());
+      std::vector<std::complex<Double_t> > cb(b.begin(), b.end());
+      Radix2FFT(ca, kFALSE);
+      Radix2FFT(cb, kFALSE);
+      for (Int_t i = 0; i < n; ++i) ca[i] *= cb[i];
+      Radix2FFT(ca, kTRUE);
+      for (Int_t i = 0; i < n; ++i) {
+         a[i] = ca[i].real() / n;
+      }
+   }
+   delete fftA;
+   delete fftB;
+   delete fftInv;
+}
+
+// Number of points evaluated by each task of the parallel evaluation
+const UInt_t kTKDEPointsPerTask = 256;
 
+}
 
 ClassImp(TKDE)
 
@@ -50,6 +157,19 @@ class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   Double_t fSupport; // Kernel support in units of the bandwidth, 0 if unbounded
+   Double_t fMaxWeight; // Largest kernel weight
+   std::vector<Double_t> fSortedData; // Data sorted by value, for summing only the kernels within the support
+   std::vector<Double_t> fSortedWeights; // Kernel weights of the sorted data
+   std::vector<Double_t> fSortedCounts; // Bin counts or event weights of the sorted data
+   Bool_t fSortedUseBins; // Whether fSortedCounts holds the bin counts or event weights
+   std::vector<Double_t> fGrid; // Fixed bandwidth estimate (not normalized) on a regular grid, for the FFT evaluation
+   Double_t fGridMin; // First point of the grid
+   Double_t fGridStep; // Distance between the grid points
+   void SortData();
+   Double_t SumKernels(Double_t x, Double_t twoA, Bool_t reflected) const;
+   void ComputeGrid(UInt_t npoints);
+   Double_t InterpolateGrid(Double_t x) const;
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
@@ -130,6 +250,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNBins = events < 10000 ? 100 : events / 10;
    fNEvents = events;
    fUseBinsNEvents = 10000;
+   fNFFTPoints = 0;
    fMean = 0.0;
    fSigma = 0.0;
    fXMin = xMin;
@@ -413,6 +534,17 @@ void TKDE::SetRange(Double_t xMin, Double_t xMax) {
    SetKernel();
 }
 
+void TKDE::SetNFFTPoints(UInt_t npoints) {
+   // Sets the number of grid points for evaluating the fixed bandwidth estimate by FFT
+   // convolution of the binned data with the kernel; 0 (default) disables it.
+   // It is only used for the built-in kernels.
+   if (npoints > 0 && fKernelType == kUserDefined) {
+      Warning("SetNFFTPoints", "The FFT evaluation is not available for user defined kernels");
+   }
+   fNFFTPoints = npoints;
+   SetKernel();
+}
+
 // private methods
 
 void TKDE::SetUseBins() {
@@ -672,6 +804,32 @@ Double_t TKDE::operator()(Double_t x) const {
    return (*fKernel)(x);
 }
 
+void TKDE::operator()(UInt_t n, const Double_t* x, Double_t* y) const {
+   // Evaluates the kernel density estimate at the n points x, storing the results in y.
+   // With implicit multi-threading enabled, the points are evaluated in parallel
+   // (not for user defined kernels, which may not be thread safe).
+   if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
+   auto evalPoints = [&](UInt_t itask) {
+      UInt_t first = itask * kTKDEPointsPerTask;
+      UInt_t last = std::min(first + kTKDEPointsPerTask, n);
+      for (UInt_t i = first; i < last; ++i) {
+         y[i] = (*fKernel)(x[i]);
+      }
+      return 0;
+   };
+   UInt_t ntasks = (n + kTKDEPointsPerTask - 1) / kTKDEPointsPerTask;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && ntasks > 1 && fKernelType != kUserDefined) {
+      auto pool = ROOT::Internal::GetImplicitMTExecutor();
+      pool->Map(evalPoints, ROOT::TSeq<UInt_t>(ntasks));
+      return;
+   }
+#endif
+   for (UInt_t itask = 0; itask < ntasks; ++itask) {
+      evalPoints(itask);
+   }
+}
+
 Double_t TKDE::GetMean() const {
    // return the mean of the data
    if (fNewData) (const_cast<TKDE*>(this))->InitFromNewData();
@@ -694,8 +852,117 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
-{}
+fWeights(fNWeights, weight),
+fSupport(0.0),
+fMaxWeight(weight),
+fSortedUseBins(kFALSE),
+fGridMin(0.0),
+fGridStep(0.0)
+{
+   // The built-in kernels vanish outside a finite range: only the data within
+   // this range around the evaluation point need to be summed.
+   switch (kde->fKernelType) {
+      case kGaussian :
+         fSupport = 9.0;
+         break;
+      case kEpanechnikov :
+      case kBiweight :
+      case kCosineArch :
+         fSupport = 1.0;
+         break;
+      default:
+         fSupport = 0.0;
+   }
+   SortData();
+   if (kde->fNFFTPoints > 0) ComputeGrid(kde->fNFFTPoints);
+}
+
+void TKDE::TKernel::SortData() {
+   // Sorts the data together with their weights and counts, for evaluating
+   // only the kernels within their support
+   if (fSupport <= 0) return;
+   UInt_t n = fKDE->fData.size();
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   std::vector<UInt_t> index(n);
+   for (UInt_t i = 0; i < n; ++i) index[i] = i;
+   const std::vector<Double_t> & data = fKDE->fData;
+   std::stable_sort(index.begin(), index.end(), [&data](UInt_t a, UInt_t b) { return data[a] < data[b]; });
+   fSortedData.resize(n);
+   fSortedWeights.resize(n);
+   fSortedCounts.resize(n);
+   fSortedUseBins = useBins;
+   fMaxWeight = 0.0;
+   for (UInt_t i = 0; i < n; ++i) {
+      fSortedData[i] = data[index[i]];
+      fSortedWeights[i] = fWeights[index[i]];
+      fSortedCounts[i] = (useBins) ? fKDE->fBinCount[index[i]] : 1.0;
+      fMaxWeight = std::max(fMaxWeight, fWeights[index[i]]);
+   }
+}
+
+Double_t TKDE::TKernel::SumKernels(Double_t x, Double_t twoA, Bool_t reflected) const {
+   // Returns the sum of the kernels centred at the data (or at the data
+   // reflected around twoA / 2) which do not vanish at x
+   Double_t centre = reflected ? twoA - x : x;
+   // a slightly larger range, such that no kernel is missed due to rounding
+   Double_t halfWidth = fSupport * fMaxWeight * (1. + 1.E-9);
+   std::vector<Double_t>::const_iterator first = std::lower_bound(fSortedData.begin(), fSortedData.end(), centre - halfWidth);
+   std::vector<Double_t>::const_iterator last = std::upper_bound(first, fSortedData.end(), centre + halfWidth);
+   UInt_t begin = first - fSortedData.begin();
+   UInt_t end = last - fSortedData.begin();
+   Double_t result(0.0);
+   for (UInt_t i = begin; i < end; ++i) {
+      Double_t point = reflected ? twoA - fSortedData[i] : fSortedData[i];
+      result += fSortedCounts[i] / fSortedWeights[i] * (*fKDE->fKernelFunction)((x - point) / fSortedWeights[i]);
+   }
+   return result;
+}
+
+void TKDE::TKernel::ComputeGrid(UInt_t npoints) {
+   // Computes the fixed bandwidth estimate at the points of a regular grid covering the data
+   // and the support of their kernels: the data are linearly binned on the grid and the bin
+   // contents are convolved with the kernel sampled at the grid spacing
+   fGrid.clear();
+   UInt_t n = fKDE->fData.size();
+   if (fSupport <= 0 || n == 0) return;
+   UInt_t m = 4;
+   while (m < npoints) m *= 2;
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   Double_t h = fWeights[0];
+   const std::vector<Double_t> & data = fKDE->fData;
+   fGridMin = *std::min_element(data.begin(), data.end()) - fSupport * h;
+   Double_t gridMax = *std::max_element(data.begin(), data.end()) + fSupport * h;
+   fGridStep = (gridMax - fGridMin) / (m - 1);
+   // the sequences are padded to twice the grid size, so that the circular convolution
+   // does not wrap around
+   std::vector<Double_t> counts(2 * m, 0.0);
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t t = (data[i] - fGridMin) / fGridStep;
+      UInt_t j = std::min(UInt_t(t), m - 2);
+      Double_t frac = t - j;
+      Double_t count = (useBins) ? fKDE->fBinCount[i] : 1.0;
+      counts[j] += count * (1. - frac);
+      counts[j + 1] += count * frac;
+   }
+   std::vector<Double_t> kernel(2 * m, 0.0);
+   for (UInt_t j = 0; j < m; ++j) {
+      Double_t k = (*fKDE->fKernelFunction)(j * fGridStep / h) / h;
+      kernel[j] = k;
+      if (j > 0) kernel[2 * m - j] = k;
+   }
+   FFTConvolve(counts, kernel);
+   fGrid.assign(counts.begin(), counts.begin() + m);
+}
+
+Double_t TKDE::TKernel::InterpolateGrid(Double_t x) const {
+   // Returns the fixed bandwidth estimate (not normalized) at x, linearly interpolated on the grid
+   Double_t t = (x - fGridMin) / fGridStep;
+   UInt_t m = fGrid.size();
+   if (!(t >= 0 && t <= m - 1)) return 0.0; // no kernel reaches beyond the grid
+   UInt_t j = std::min(UInt_t(t), m - 2);
+   Double_t frac = t - j;
+   return fGrid[j] * (1. - frac) + fGrid[j + 1] * frac;
+}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
    // Gets the adaptive weights (bandwidths) for TKernel internal computation
@@ -719,6 +986,9 @@ void TKDE::TKernel::ComputeAdaptiveWeights() {
    Double_t kAPPROX_GEO_MEAN = 0.241970724519143365; // 1 / TMath::Power(2 * TMath::Pi(), .5) * TMath::Exp(-.5). Approximated geometric mean over pointwise data (the KDE function is substituted by the "real Gaussian" pdf) and proportional to sigma. Used directly when the mirroring is enabled, otherwise computed from the data
    fKDE->fAdaptiveBandwidthFactor = fKDE->fUseMirroring ? kAPPROX_GEO_MEAN / fKDE->fSigmaRob : std::sqrt(std::exp(fKDE->fAdaptiveBandwidthFactor / fKDE->fData.size()));
    transform(weights.begin(), weights.end(), fWeights.begin(), std::bind2nd(std::multiplies<Double_t>(), fKDE->fAdaptiveBandwidthFactor));
+   // the grid holds the fixed bandwidth (pilot) estimate only
+   fGrid.clear();
+   SortData();
    //printf("adaptive bandwidth factor % f weight 0 %f , %f \n",fKDE->fAdaptiveBandwidthFactor, weights[0],fWeights[0] );
 }
 
@@ -909,6 +1179,31 @@ Double_t TKDE::TKernel::operator()(Double_t x) const {
    // case of bins or weighted data 
    Bool_t useBins = (fKDE->fBinCount.size() == n);
    Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   if (!fGrid.empty()) {
+      // interpolate the estimate computed by FFT; the mirrored terms are the estimate at the reflected point
+      result = InterpolateGrid(x);
+      if (fKDE->fAsymLeft) {
+         result -= InterpolateGrid(2. * fKDE->fXMin - x);
+      }
+      if (fKDE->fAsymRight) {
+         result -= InterpolateGrid(2. * fKDE->fXMax - x);
+      }
+      return result / nSum;
+   }
+   if (fSupport > 0 && fSortedData.size() == n && fSortedUseBins == useBins) {
+      // sum only the kernels which do not vanish at x
+      result = SumKernels(x, 0., kFALSE);
+      if (fKDE->fAsymLeft) {
+         result -= SumKernels(x, 2. * fKDE->fXMin, kTRUE);
+      }
+      if (fKDE->fAsymRight) {
+         result -= SumKernels(x, 2. * fKDE->fXMax, kTRUE);
+      }
+      if ( TMath::IsNaN(result) ) {
+         fKDE->Warning("operator()","Result is NaN for  x %f \n",x);
+      }
+      return result / nSum;
+   }
    // double dmin = 1.E10;
    // double xmin,bmin,wmin; 
    for (UInt_t i = 0; i < n; ++i) {
@@ -1247,9 +1247,9 @@ TH1D *TProfile::ProjectionX(const char *name, Option_t *option) const
       // this is correct only if the profile is filled with weights =1
       if (binWeight) h1->GetSumw2()->fArray[bin] = fSumw2.fArray[bin];
       // in case of bin entries and profile is weighted, we need to set also the bin error
-      if (binEntries && fBinSumw2.fN ) {
+      if (binEntries && (fBinSumw2.fN || TH1::GetDefaultSumw2()) ) {
          R__ASSERT(  h1->GetSumw2() );
-         h1->GetSumw2()->fArray[bin] =  fBinSumw2.fArray[bin];
+         h1->GetSumw2()->fArray[bin] = (fBinSumw2.fN ? fBinSumw2.fArray[bin] : fBinEntries.fArray[bin]);
       }
 
    }
@@ -1738,8 +1738,9 @@ void TProfile::Streamer(TBuffer &R__b)
 /// This is needed to compute  the correct statistical quantities
 /// of a profile filled with weights
 ///
-/// This function is automatically called when the histogram is created
-/// if the static function TH1::SetDefaultSumw2 has been called before.
+/// If the static function TH1::SetDefaultSumw2 has been called before, this function
+/// is automatically called when the profile is first filled with a weight different
+/// from one. Until then the sum of squares of weights is equal to the bin entries.
 /// If flag is false the structure is deleted
 
 void TProfile::Sumw2(Bool_t flag)
@@ -112,8 +112,10 @@ Bool_t TProfileHelper::Add(T* p, const TH1 *h1,  const TH1 *h2, Double_t c1, Dou
    Double_t *er1 = p1->GetW2();   Double_t *er2 = p2->GetW2();
    Double_t *en1 = p1->GetB();    Double_t *en2 = p2->GetB();
    Double_t *ew1 = p1->GetB2();   Double_t *ew2 = p2->GetB2();
-   // create sumw2 per bin if not set
-   if (p->fBinSumw2.fN == 0 && (p1->fBinSumw2.fN != 0 || p2->fBinSumw2.fN != 0) ) p->Sumw2();
+   // create sumw2 per bin if not set (or if it would have been created by default, since the
+   // bin weights are scaled)
+   if (p->fBinSumw2.fN == 0 && (p1->fBinSumw2.fN != 0 || p2->fBinSumw2.fN != 0 ||
+                                (TH1::GetDefaultSumw2() && (ac1 != 1 || ac2 != 1)) ) ) p->Sumw2();
    // if p1 has not the sum of weight squared/bin stored use just the sum of weights
    if (ew1 == 0) ew1 = en1;
    if (ew2 == 0) ew2 = en2;
@@ -133,9 +135,12 @@ void TProfileHelper::BuildArray(T* p) {
    //              array of sum of profiled observable value - squared
    //              stored in TH1::fSumw2
    //              array of some of weight squared (optional) in TProfile::fBinSumw2
+   // fBinSumw2 is not created here when TH1::GetDefaultSumw2() is set: as long as the profile
+   // is filled with unit weights it is identical to fBinEntries, and it is created from it
+   // by Sumw2() only when the first weight different from one is used
    p->fBinEntries.Set(p->fNcells);
    p->fSumw2.Set(p->fNcells);
-   if (TH1::GetDefaultSumw2() || p->fBinSumw2.fN > 0 ) p->fBinSumw2.Set(p->fNcells);
+   if (p->fBinSumw2.fN > 0 ) p->fBinSumw2.Set(p->fNcells);
 }
 
 
@@ -372,6 +377,9 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
             totstats[i] += stats[i];
          nentries += h->GetEntries();
 
+         // create sumw2 per bin from the current bin entries if h is weighted
+         if (p->fBinSumw2.fN == 0 && h->fBinSumw2.fN != 0) p->Sumw2();
+
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
@@ -503,8 +511,8 @@ void TProfileHelper::Sumw2(T* p, Bool_t flag)
    //    of a profile filled with weights
    //
    //
-   //  This function is automatically called when the histogram is created
-   //  if the static function TH1::SetDefaultSumw2 has been called before.
+   //  If the static function TH1::SetDefaultSumw2 has been called before, this function
+   //  is automatically called when the profile is first filled with a weight different from one.
 
    if (!flag) {
       // clear array if existing or do nothing
@@ -8,6 +8,15 @@
 #include "TH1.h"
 #include "TMath.h"
 
+#include <algorithm>
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 /** \class TSpectrum
     \ingroup Spectrum
     \brief Advanced Spectra Processing
@@ -44,6 +53,97 @@ Int_t TSpectrum::fgAverageWindow = 3;
 #define PEAK_WINDOW 1024
 ClassImp(TSpectrum)
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the averages of the spectrum over windows of 2*bw+1 channels
+/// centered at each channel. The windows are truncated at the spectrum limits.
+
+void WindowAverages(const Double_t *source, Double_t *average, int ssize, int bw)
+{
+   for (int j = 0; j < ssize; j++) {
+      Double_t av = 0, men = 0;
+      const int wmax = std::min(j + bw, ssize - 1);
+      for (int w = std::max(j - bw, 0); w <= wmax; w++) {
+         av += source[w];
+         men += 1;
+      }
+      average[j] = av / men;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// One clipping iteration of the SNIP background algorithm with window i,
+/// used by TSpectrum::Background.
+///
+/// For the channels j in [i, ssize-i) the clipping filters up to the given
+/// order are computed from `values`, and the result is the smaller of
+/// source[j] and the largest filter. Without smoothing `values` is the source
+/// itself, with smoothing it contains the window averages of the source
+/// (see WindowAverages), which are also kept where the source is not clipped.
+/// Since the order and the smoothing are template parameters, the loop over
+/// the channels has no branches and can be vectorized by the compiler.
+
+template <int order, bool smoothing>
+void BackgroundClippingStep(const Double_t *source, const Double_t *values, Double_t *result, int ssize, int i)
+{
+   const int i2 = i / 2, i3 = i / 3, i4 = i / 4;
+   const Double_t *v = values;
+   for (int j = i; j < ssize - i; j++) {
+      Double_t b = (v[j - i] + v[j + i]) / 2.0;
+      if (order >= TSpectrum::kBackOrder4) {
+         Double_t c;
+         if (smoothing) {
+            c = (-v[j - 2 * i2] + 4 * v[j - i2] + 4 * v[j + i2] - v[j + 2 * i2]) / 6;
+         } else {
+            c = 0;
+            c -= v[j - 2 * i2] / 6;
+            c += 4 * v[j - i2] / 6;
+            c += 4 * v[j + i2] / 6;
+            c -= v[j + 2 * i2] / 6;
+         }
+         b = (b < c) ? c : b;
+      }
+      if (order >= TSpectrum::kBackOrder6) {
+         Double_t d;
+         if (smoothing) {
+            d = (v[j - 3 * i3] - 6 * v[j - 2 * i3] + 15 * v[j - i3] + 15 * v[j + i3] - 6 * v[j + 2 * i3] + v[j + 3 * i3]) / 20;
+         } else {
+            d = 0;
+            d += v[j - 3 * i3] / 20;
+            d -= 6 * v[j - 2 * i3] / 20;
+            d += 15 * v[j - i3] / 20;
+            d += 15 * v[j + i3] / 20;
+            d -= 6 * v[j + 2 * i3] / 20;
+            d += v[j + 3 * i3] / 20;
+         }
+         b = (b < d) ? d : b;
+      }
+      if (order >= TSpectrum::kBackOrder8) {
+         Double_t e;
+         if (smoothing) {
+            e = (-v[j - 4 * i4] + 8 * v[j - 3 * i4] - 28 * v[j - 2 * i4] + 56 * v[j - i4] - 56 * v[j + i4] - 28 * v[j + 2 * i4] + 8 * v[j + 3 * i4] - v[j + 4 * i4]) / 70;
+         } else {
+            e = 0;
+            e -= v[j - 4 * i4] / 70;
+            e += 8 * v[j - 3 * i4] / 70;
+            e -= 28 * v[j - 2 * i4] / 70;
+            e += 56 * v[j - i4] / 70;
+            e += 56 * v[j + i4] / 70;
+            e -= 28 * v[j + 2 * i4] / 70;
+            e += 8 * v[j + 3 * i4] / 70;
+            e -= v[j + 4 * i4] / 70;
+         }
+         b = (b < e) ? e : b;
+      }
+      const Double_t a = source[j];
+      const Double_t unclipped = smoothing ? v[j] : a;
+      result[j] = (b < a) ? b : unclipped;
+   }
+}
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor.
 
@@ -515,8 +615,8 @@ const char *TSpectrum::Background(Double_t *spectrum, int ssize,
                                           bool smoothing,int smoothWindow,
                                           bool compton)
 {
-   int i, j, w, bw, b1, b2, priz;
-   Double_t a, b, c, d, e, yb1, yb2, ai, av, men, b4, c4, d4, e4, b6, c6, d6, e6, f6, g6, b8, c8, d8, e8, f8, g8, h8, i8;
+   int i, j, b1, b2, priz;
+   Double_t a, b, c, d, yb1, yb2;
    if (ssize <= 0)
       return "Wrong Parameters";
    if (numberIterations < 1)
@@ -530,566 +630,43 @@ const char *TSpectrum::Background(Double_t *spectrum, int ssize,
       working_space[i] = spectrum[i];
       working_space[i + ssize] = spectrum[i];
    }
-   bw=(smoothWindow-1)/2;
+   Double_t *average = smoothing ? new Double_t[ssize] : 0;
    if (direction == kBackIncreasingWindow)
       i = 1;
    else if(direction == kBackDecreasingWindow)
       i = numberIterations;
-   if (filterOrder == kBackOrder2) {
-      do{
-         for (j = i; j < ssize - i; j++) {
-            if (smoothing == kFALSE){
-               a = working_space[ssize + j];
-               b = (working_space[ssize + j - i] + working_space[ssize + j + i]) / 2.0;
-               if (b < a)
-                  a = b;
-               working_space[j] = a;
-            }
-
-            else if (smoothing == kTRUE){
-               a = working_space[ssize + j];
-               av = 0;
-               men = 0;
-               for (w = j - bw; w <= j + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     av += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               av = av / men;
-               b = 0;
-               men = 0;
-               for (w = j - i - bw; w <= j - i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     b += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b = b / men;
-               c = 0;
-               men = 0;
-               for (w = j + i - bw; w <= j + i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     c += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c = c / men;
-               b = (b + c) / 2;
-               if (b < a)
-                  av = b;
-               working_space[j]=av;
-            }
-         }
-         for (j = i; j < ssize - i; j++)
-            working_space[ssize + j] = working_space[j];
-         if (direction == kBackIncreasingWindow)
-            i+=1;
-         else if(direction == kBackDecreasingWindow)
-            i-=1;
-      }while((direction == kBackIncreasingWindow && i <= numberIterations) || (direction == kBackDecreasingWindow && i >= 1));
-   }
-
-   else if (filterOrder == kBackOrder4) {
-      do{
-         for (j = i; j < ssize - i; j++) {
-            if (smoothing == kFALSE){
-               a = working_space[ssize + j];
-               b = (working_space[ssize + j - i] + working_space[ssize + j + i]) / 2.0;
-               c = 0;
-               ai = i / 2;
-               c -= working_space[ssize + j - (Int_t) (2 * ai)] / 6;
-               c += 4 * working_space[ssize + j - (Int_t) ai] / 6;
-               c += 4 * working_space[ssize + j + (Int_t) ai] / 6;
-               c -= working_space[ssize + j + (Int_t) (2 * ai)] / 6;
-               if (b < c)
-                  b = c;
-               if (b < a)
-                  a = b;
-               working_space[j] = a;
-            }
-
-            else if (smoothing == kTRUE){
-               a = working_space[ssize + j];
-               av = 0;
-               men = 0;
-               for (w = j - bw; w <= j + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     av += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               av = av / men;
-               b = 0;
-               men = 0;
-               for (w = j - i - bw; w <= j - i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     b += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b = b / men;
-               c = 0;
-               men = 0;
-               for (w = j + i - bw; w <= j + i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     c += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c = c / men;
-               b = (b + c) / 2;
-               ai = i / 2;
-               b4 = 0, men = 0;
-               for (w = j - (Int_t)(2 * ai) - bw; w <= j - (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     b4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b4 = b4 / men;
-               c4 = 0, men = 0;
-               for (w = j - (Int_t)ai - bw; w <= j - (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     c4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c4 = c4 / men;
-               d4 = 0, men = 0;
-               for (w = j + (Int_t)ai - bw; w <= j + (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     d4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               d4 = d4 / men;
-               e4 = 0, men = 0;
-               for (w = j + (Int_t)(2 * ai) - bw; w <= j + (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     e4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               e4 = e4 / men;
-               b4 = (-b4 + 4 * c4 + 4 * d4 - e4) / 6;
-               if (b < b4)
-                  b = b4;
-               if (b < a)
-                  av = b;
-               working_space[j]=av;
-            }
-         }
-         for (j = i; j < ssize - i; j++)
-            working_space[ssize + j] = working_space[j];
-         if (direction == kBackIncreasingWindow)
-            i+=1;
-         else if(direction == kBackDecreasingWindow)
-            i-=1;
-      }while((direction == kBackIncreasingWindow && i <= numberIterations) || (direction == kBackDecreasingWindow && i >= 1));
-   }
-
-   else if (filterOrder == kBackOrder6) {
-      do{
-         for (j = i; j < ssize - i; j++) {
-            if (smoothing == kFALSE){
-               a = working_space[ssize + j];
-               b = (working_space[ssize + j - i] + working_space[ssize + j + i]) / 2.0;
-               c = 0;
-               ai = i / 2;
-               c -= working_space[ssize + j - (Int_t) (2 * ai)] / 6;
-               c += 4 * working_space[ssize + j - (Int_t) ai] / 6;
-               c += 4 * working_space[ssize + j + (Int_t) ai] / 6;
-               c -= working_space[ssize + j + (Int_t) (2 * ai)] / 6;
-               d = 0;
-               ai = i / 3;
-               d += working_space[ssize + j - (Int_t) (3 * ai)] / 20;
-               d -= 6 * working_space[ssize + j - (Int_t) (2 * ai)] / 20;
-               d += 15 * working_space[ssize + j - (Int_t) ai] / 20;
-               d += 15 * working_space[ssize + j + (Int_t) ai] / 20;
-               d -= 6 * working_space[ssize + j + (Int_t) (2 * ai)] / 20;
-               d += working_space[ssize + j + (Int_t) (3 * ai)] / 20;
-               if (b < d)
-                  b = d;
-               if (b < c)
-                  b = c;
-               if (b < a)
-                  a = b;
-               working_space[j] = a;
-            }
-
-            else if (smoothing == kTRUE){
-               a = working_space[ssize + j];
-               av = 0;
-               men = 0;
-               for (w = j - bw; w <= j + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     av += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               av = av / men;
-               b = 0;
-               men = 0;
-               for (w = j - i - bw; w <= j - i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     b += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b = b / men;
-               c = 0;
-               men = 0;
-               for (w = j + i - bw; w <= j + i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     c += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c = c / men;
-               b = (b + c) / 2;
-               ai = i / 2;
-               b4 = 0, men = 0;
-               for (w = j - (Int_t)(2 * ai) - bw; w <= j - (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     b4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b4 = b4 / men;
-               c4 = 0, men = 0;
-               for (w = j - (Int_t)ai - bw; w <= j - (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     c4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c4 = c4 / men;
-               d4 = 0, men = 0;
-               for (w = j + (Int_t)ai - bw; w <= j + (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     d4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               d4 = d4 / men;
-               e4 = 0, men = 0;
-               for (w = j + (Int_t)(2 * ai) - bw; w <= j + (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     e4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               e4 = e4 / men;
-               b4 = (-b4 + 4 * c4 + 4 * d4 - e4) / 6;
-               ai = i / 3;
-               b6 = 0, men = 0;
-               for (w = j - (Int_t)(3 * ai) - bw; w <= j - (Int_t)(3 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     b6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b6 = b6 / men;
-               c6 = 0, men = 0;
-               for (w = j - (Int_t)(2 * ai) - bw; w <= j - (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     c6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c6 = c6 / men;
-               d6 = 0, men = 0;
-               for (w = j - (Int_t)ai - bw; w <= j - (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     d6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               d6 = d6 / men;
-               e6 = 0, men = 0;
-               for (w = j + (Int_t)ai - bw; w <= j + (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     e6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               e6 = e6 / men;
-               f6 = 0, men = 0;
-               for (w = j + (Int_t)(2 * ai) - bw; w <= j + (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     f6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               f6 = f6 / men;
-               g6 = 0, men = 0;
-               for (w = j + (Int_t)(3 * ai) - bw; w <= j + (Int_t)(3 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     g6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               g6 = g6 / men;
-               b6 = (b6 - 6 * c6 + 15 * d6 + 15 * e6 - 6 * f6 + g6) / 20;
-               if (b < b6)
-                  b = b6;
-               if (b < b4)
-                  b = b4;
-               if (b < a)
-                  av = b;
-               working_space[j]=av;
-            }
-         }
-         for (j = i; j < ssize - i; j++)
-            working_space[ssize + j] = working_space[j];
-         if (direction == kBackIncreasingWindow)
-            i+=1;
-         else if(direction == kBackDecreasingWindow)
-            i-=1;
-      }while((direction == kBackIncreasingWindow && i <= numberIterations) || (direction == kBackDecreasingWindow && i >= 1));
-   }
-
-   else if (filterOrder == kBackOrder8) {
-      do{
-         for (j = i; j < ssize - i; j++) {
-            if (smoothing == kFALSE){
-               a = working_space[ssize + j];
-               b = (working_space[ssize + j - i] + working_space[ssize + j + i]) / 2.0;
-               c = 0;
-               ai = i / 2;
-               c -= working_space[ssize + j - (Int_t) (2 * ai)] / 6;
-               c += 4 * working_space[ssize + j - (Int_t) ai] / 6;
-               c += 4 * working_space[ssize + j + (Int_t) ai] / 6;
-               c -= working_space[ssize + j + (Int_t) (2 * ai)] / 6;
-               d = 0;
-               ai = i / 3;
-               d += working_space[ssize + j - (Int_t) (3 * ai)] / 20;
-               d -= 6 * working_space[ssize + j - (Int_t) (2 * ai)] / 20;
-               d += 15 * working_space[ssize + j - (Int_t) ai] / 20;
-               d += 15 * working_space[ssize + j + (Int_t) ai] / 20;
-               d -= 6 * working_space[ssize + j + (Int_t) (2 * ai)] / 20;
-               d += working_space[ssize + j + (Int_t) (3 * ai)] / 20;
-               e = 0;
-               ai = i / 4;
-               e -= working_space[ssize + j - (Int_t) (4 * ai)] / 70;
-               e += 8 * working_space[ssize + j - (Int_t) (3 * ai)] / 70;
-               e -= 28 * working_space[ssize + j - (Int_t) (2 * ai)] / 70;
-               e += 56 * working_space[ssize + j - (Int_t) ai] / 70;
-               e += 56 * working_space[ssize + j + (Int_t) ai] / 70;
-               e -= 28 * working_space[ssize + j + (Int_t) (2 * ai)] / 70;
-               e += 8 * working_space[ssize + j + (Int_t) (3 * ai)] / 70;
-               e -= working_space[ssize + j + (Int_t) (4 * ai)] / 70;
-               if (b < e)
-                  b = e;
-               if (b < d)
-                  b = d;
-               if (b < c)
-                  b = c;
-               if (b < a)
-                  a = b;
-               working_space[j] = a;
-            }
-
-            else if (smoothing == kTRUE){
-               a = working_space[ssize + j];
-               av = 0;
-               men = 0;
-               for (w = j - bw; w <= j + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     av += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               av = av / men;
-               b = 0;
-               men = 0;
-               for (w = j - i - bw; w <= j - i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     b += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b = b / men;
-               c = 0;
-               men = 0;
-               for (w = j + i - bw; w <= j + i + bw; w++){
-                  if ( w >= 0 && w < ssize){
-                     c += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c = c / men;
-               b = (b + c) / 2;
-               ai = i / 2;
-               b4 = 0, men = 0;
-               for (w = j - (Int_t)(2 * ai) - bw; w <= j - (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     b4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b4 = b4 / men;
-               c4 = 0, men = 0;
-               for (w = j - (Int_t)ai - bw; w <= j - (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     c4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c4 = c4 / men;
-               d4 = 0, men = 0;
-               for (w = j + (Int_t)ai - bw; w <= j + (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     d4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               d4 = d4 / men;
-               e4 = 0, men = 0;
-               for (w = j + (Int_t)(2 * ai) - bw; w <= j + (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     e4 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               e4 = e4 / men;
-               b4 = (-b4 + 4 * c4 + 4 * d4 - e4) / 6;
-               ai = i / 3;
-               b6 = 0, men = 0;
-               for (w = j - (Int_t)(3 * ai) - bw; w <= j - (Int_t)(3 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     b6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b6 = b6 / men;
-               c6 = 0, men = 0;
-               for (w = j - (Int_t)(2 * ai) - bw; w <= j - (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     c6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c6 = c6 / men;
-               d6 = 0, men = 0;
-               for (w = j - (Int_t)ai - bw; w <= j - (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     d6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               d6 = d6 / men;
-               e6 = 0, men = 0;
-               for (w = j + (Int_t)ai - bw; w <= j + (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     e6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               e6 = e6 / men;
-               f6 = 0, men = 0;
-               for (w = j + (Int_t)(2 * ai) - bw; w <= j + (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     f6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               f6 = f6 / men;
-               g6 = 0, men = 0;
-               for (w = j + (Int_t)(3 * ai) - bw; w <= j + (Int_t)(3 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     g6 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               g6 = g6 / men;
-               b6 = (b6 - 6 * c6 + 15 * d6 + 15 * e6 - 6 * f6 + g6) / 20;
-               ai = i / 4;
-               b8 = 0, men = 0;
-               for (w = j - (Int_t)(4 * ai) - bw; w <= j - (Int_t)(4 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     b8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               b8 = b8 / men;
-               c8 = 0, men = 0;
-               for (w = j - (Int_t)(3 * ai) - bw; w <= j - (Int_t)(3 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     c8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               c8 = c8 / men;
-               d8 = 0, men = 0;
-               for (w = j - (Int_t)(2 * ai) - bw; w <= j - (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     d8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               d8 = d8 / men;
-               e8 = 0, men = 0;
-               for (w = j - (Int_t)ai - bw; w <= j - (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     e8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               e8 = e8 / men;
-               f8 = 0, men = 0;
-               for (w = j + (Int_t)ai - bw; w <= j + (Int_t)ai + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     f8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               f8 = f8 / men;
-               g8 = 0, men = 0;
-               for (w = j + (Int_t)(2 * ai) - bw; w <= j + (Int_t)(2 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     g8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               g8 = g8 / men;
-               h8 = 0, men = 0;
-               for (w = j + (Int_t)(3 * ai) - bw; w <= j + (Int_t)(3 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     h8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               h8 = h8 / men;
-               i8 = 0, men = 0;
-               for (w = j + (Int_t)(4 * ai) - bw; w <= j + (Int_t)(4 * ai) + bw; w++){
-                  if (w >= 0 && w < ssize){
-                     i8 += working_space[ssize + w];
-                     men +=1;
-                  }
-               }
-               i8 = i8 / men;
-               b8 = ( -b8 + 8 * c8 - 28 * d8 + 56 * e8 - 56 * f8 - 28 * g8 + 8 * h8 - i8)/70;
-               if (b < b8)
-                  b = b8;
-               if (b < b6)
-                  b = b6;
-               if (b < b4)
-                  b = b4;
-               if (b < a)
-                  av = b;
-               working_space[j]=av;
-            }
-         }
-         for (j = i; j < ssize - i; j++)
-            working_space[ssize + j] = working_space[j];
-         if (direction == kBackIncreasingWindow)
-            i += 1;
-         else if(direction == kBackDecreasingWindow)
-            i -= 1;
-      }while((direction == kBackIncreasingWindow && i <= numberIterations) || (direction == kBackDecreasingWindow && i >= 1));
-   }
+   do{
+      // the upper half of working_space holds the current estimate, the lower half the new one
+      const Double_t *current = working_space + ssize;
+      if (smoothing == kFALSE) {
+         if (filterOrder == kBackOrder2)
+            BackgroundClippingStep<kBackOrder2, false>(current, current, working_space, ssize, i);
+         else if (filterOrder == kBackOrder4)
+            BackgroundClippingStep<kBackOrder4, false>(current, current, working_space, ssize, i);
+         else if (filterOrder == kBackOrder6)
+            BackgroundClippingStep<kBackOrder6, false>(current, current, working_space, ssize, i);
+         else if (filterOrder == kBackOrder8)
+            BackgroundClippingStep<kBackOrder8, false>(current, current, working_space, ssize, i);
+      }
+      else {
+         WindowAverages(current, average, ssize, (smoothWindow - 1) / 2);
+         if (filterOrder == kBackOrder2)
+            BackgroundClippingStep<kBackOrder2, true>(current, average, working_space, ssize, i);
+         else if (filterOrder == kBackOrder4)
+            BackgroundClippingStep<kBackOrder4, true>(current, average, working_space, ssize, i);
+         else if (filterOrder == kBackOrder6)
+            BackgroundClippingStep<kBackOrder6, true>(current, average, working_space, ssize, i);
+         else if (filterOrder == kBackOrder8)
+            BackgroundClippingStep<kBackOrder8, true>(current, average, working_space, ssize, i);
+      }
+      for (j = i; j < ssize - i; j++)
+         working_space[ssize + j] = working_space[j];
+      if (direction == kBackIncreasingWindow)
+         i += 1;
+      else if(direction == kBackDecreasingWindow)
+         i -= 1;
+   }while((direction == kBackIncreasingWindow && i <= numberIterations) || (direction == kBackDecreasingWindow && i >= 1));
+   delete [] average;
 
    if (compton == kTRUE) {
       for (i = 0, b2 = 0; i < ssize; i++){
@@ -1154,6 +731,49 @@ const char *TSpectrum::Background(Double_t *spectrum, int ssize,
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Background estimation of many spectra of the same size at once.
+///
+/// The nspectra spectra are stored one after the other in spectra, which
+/// holds nspectra*ssize values; each one is replaced by its background
+/// estimated by Background() with the given parameters. With implicit
+/// multi-threading enabled (ROOT::EnableImplicitMT()) the spectra are
+/// processed in parallel.
+///
+/// Returns 0 on success or the error message of Background(), which only
+/// depends on the parameters, so that then no spectrum is modified.
+
+const char *TSpectrum::BackgroundBatch(Double_t *spectra, Int_t nspectra, Int_t ssize,
+                                       Int_t numberIterations,
+                                       Int_t direction, Int_t filterOrder,
+                                       bool smoothing, Int_t smoothWindow,
+                                       bool compton)
+{
+   if (nspectra <= 0)
+      return "Wrong Parameters";
+   // the first spectrum checks the parameters
+   const char *error = Background(spectra, ssize, numberIterations, direction, filterOrder,
+                                  smoothing, smoothWindow, compton);
+   if (error || nspectra == 1)
+      return error;
+   // the other spectra, counted from the second one
+   auto background = [&](UInt_t i) {
+      Background(spectra + (Long64_t)(i + 1) * ssize, ssize, numberIterations, direction,
+                 filterOrder, smoothing, smoothWindow, compton);
+      return 0;
+   };
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) {
+      auto pool = ROOT::Internal::GetImplicitMTExecutor();
+      pool->Map(background, ROOT::TSeq<UInt_t>(nspectra - 1));
+      return 0;
+   }
+#endif
+   for (Int_t i = 0; i < nspectra - 1; i++)
+      background(i);
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// One-dimensional markov spectrum smoothing function
 ///
@@ -2130,13 +1750,13 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
                                      bool markov, int averWindow)
 {
    int i, j, numberIterations = (Int_t)(7 * sigma + 0.5);
-   Double_t a, b, c;
+   Double_t a, b;
    int k, lindex, posit, imin, imax, jmin, jmax, lh_gold, priz;
    Double_t lda, ldb, ldc, area, maximum, maximum_decon;
-   int xmin, xmax, l, peak_index = 0, size_ext = ssize + 2 * numberIterations, shift = numberIterations, bw = 2, w;
+   int xmin, xmax, l, peak_index = 0, size_ext = ssize + 2 * numberIterations, shift = numberIterations, bw = 2;
    Double_t maxch;
    Double_t nom, nip, nim, sp, sm, plocha = 0;
-   Double_t m0low=0,m1low=0,m2low=0,l0low=0,l1low=0,detlow,av,men;
+   Double_t m0low=0,m1low=0,m2low=0,l0low=0,l1low=0,detlow;
    if (sigma < 1) {
       Error("SearchHighRes", "Invalid sigma, must be greater than or equal to 1");
       return 0;
@@ -2211,55 +1831,20 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
    }
 
    if(backgroundRemove == true){
+      Double_t *average = markov ? new Double_t[size_ext] : 0;
       for(i = 1; i <= numberIterations; i++){
-         for(j = i; j < size_ext - i; j++){
-            if(markov == false){
-               a = working_space[size_ext + j];
-               b = (working_space[size_ext + j - i] + working_space[size_ext + j + i]) / 2.0;
-               if(b < a)
-                  a = b;
-
-               working_space[j]=a;
-            }
+         const Double_t *current = working_space + size_ext;
+         if(markov == false)
+            BackgroundClippingStep<kBackOrder2, false>(current, current, working_space, size_ext, i);
 
-            else{
-               a = working_space[size_ext + j];
-               av = 0;
-               men = 0;
-               for (w = j - bw; w <= j + bw; w++){
-                  if ( w >= 0 && w < size_ext){
-                     av += working_space[size_ext + w];
-                     men +=1;
-                  }
-               }
-               av = av / men;
-               b = 0;
-               men = 0;
-               for (w = j - i - bw; w <= j - i + bw; w++){
-                  if ( w >= 0 && w < size_ext){
-                     b += working_space[size_ext + w];
-                     men +=1;
-                  }
-               }
-               b = b / men;
-               c = 0;
-               men = 0;
-               for (w = j + i - bw; w <= j + i + bw; w++){
-                  if ( w >= 0 && w < size_ext){
-                     c += working_space[size_ext + w];
-                     men +=1;
-                  }
-               }
-               c = c / men;
-               b = (b + c) / 2;
-               if (b < a)
-                  av = b;
-               working_space[j]=av;
-            }
+         else{
+            WindowAverages(current, average, size_ext, bw);
+            BackgroundClippingStep<kBackOrder2, true>(current, average, working_space, size_ext, i);
          }
          for(j = i; j < size_ext - i; j++)
             working_space[size_ext + j] = working_space[j];
       }
+      delete [] average;
       for(j = 0;j < size_ext; j++){
          if(j < shift){
                   a = j - shift;
@@ -2357,13 +1942,8 @@ Int_t TSpectrum::SearchHighRes(Double_t *source,Double_t *destVector, int ssize,
       }
       if(backgroundRemove == true){
          for(i = 1; i <= numberIterations; i++){
-            for(j = i; j < size_ext - i; j++){
-               a = working_space[size_ext + j];
-               b = (working_space[size_ext + j - i] + working_space[size_ext + j + i]) / 2.0;
-               if(b < a)
-                  a = b;
-               working_space[j] = a;
-            }
+            BackgroundClippingStep<kBackOrder2, false>(working_space + size_ext, working_space + size_ext,
+                                                       working_space, size_ext, i);
             for(j = i; j < size_ext - i; j++)
                working_space[size_ext + j] = working_space[j];
          }
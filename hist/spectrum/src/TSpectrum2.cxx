@@ -501,13 +501,14 @@ const char *TSpectrum2::Background(Double_t **spectrum,
       working_space[i] = new Double_t[ssizey];
    sampling =
        (Int_t) TMath::Max(numberIterationsX, numberIterationsY);
+   // the loops run over y innermost since spectrum[x] is contiguous in y
    if (direction == kBackIncreasingWindow) {
       if (filterType == kBackSuccessiveFiltering) {
          for (i = 1; i <= sampling; i++) {
             r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
                 (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
+            for (x = r1; x < ssizex - r1; x++) {
+               for (y = r2; y < ssizey - r2; y++) {
                   a = spectrum[x][y];
                   p1 = spectrum[x - r1][y - r2];
                   p2 = spectrum[x - r1][y + r2];
@@ -541,8 +542,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                   working_space[x][y] = a;
                }
             }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
+            for (x = r1; x < ssizex - r1; x++) {
+               for (y = r2; y < ssizey - r2; y++) {
                   spectrum[x][y] = working_space[x][y];
                }
             }
@@ -553,8 +554,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
          for (i = 1; i <= sampling; i++) {
             r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
                 (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
+            for (x = r1; x < ssizex - r1; x++) {
+               for (y = r2; y < ssizey - r2; y++) {
                   a = spectrum[x][y];
                   b = -(spectrum[x - r1][y - r2] +
                          spectrum[x - r1][y + r2] + spectrum[x + r1][y -
@@ -567,8 +568,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                   working_space[x][y] = a;
                }
             }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
+            for (x = i; x < ssizex - i; x++) {
+               for (y = i; y < ssizey - i; y++) {
                   spectrum[x][y] = working_space[x][y];
                }
             }
@@ -581,8 +582,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
          for (i = sampling; i >= 1; i--) {
             r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
                 (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
+            for (x = r1; x < ssizex - r1; x++) {
+               for (y = r2; y < ssizey - r2; y++) {
                   a = spectrum[x][y];
                   p1 = spectrum[x - r1][y - r2];
                   p2 = spectrum[x - r1][y + r2];
@@ -616,8 +617,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                   working_space[x][y] = a;
                }
             }
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
+            for (x = r1; x < ssizex - r1; x++) {
+               for (y = r2; y < ssizey - r2; y++) {
                   spectrum[x][y] = working_space[x][y];
                }
             }
@@ -628,8 +629,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
          for (i = sampling; i >= 1; i--) {
             r1 = (Int_t) TMath::Min(i, numberIterationsX), r2 =
                 (Int_t) TMath::Min(i, numberIterationsY);
-            for (y = r2; y < ssizey - r2; y++) {
-               for (x = r1; x < ssizex - r1; x++) {
+            for (x = r1; x < ssizex - r1; x++) {
+               for (y = r2; y < ssizey - r2; y++) {
                   a = spectrum[x][y];
                   b = -(spectrum[x - r1][y - r2] +
                          spectrum[x - r1][y + r2] + spectrum[x + r1][y -
@@ -642,8 +643,8 @@ const char *TSpectrum2::Background(Double_t **spectrum,
                   working_space[x][y] = a;
                }
             }
-            for (y = i; y < ssizey - i; y++) {
-               for (x = i; x < ssizex - i; x++) {
+            for (x = i; x < ssizex - i; x++) {
+               for (y = i; y < ssizey - i; y++) {
                   spectrum[x][y] = working_space[x][y];
                }
             }
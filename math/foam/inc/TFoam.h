@@ -25,6 +25,9 @@ class TFoamIntegrand;
 class TFoamMaxwt;
 class TFoamVect;
 class TFoamCell;
+namespace ROOT {
+   class TThreadExecutor;
+}
 
 class TFoam : public TObject {
 protected:
@@ -81,6 +84,8 @@ protected:
    Double_t fMCerror;         // and its error
    //----------  working space for CELL exploration -------------
    Double_t *fAlpha;          // [fDim] Internal parameters of the hyperrectangle
+   Int_t     fNSamplBatch;    //! No. of MC events of the cell exploration evaluated together
+   ROOT::TThreadExecutor *fExecutor; //! Thread pool of the cell exploration, exists only during Initialize
    //////////////////////////////////////////////////////////////////////////////////////////////
    //                                     METHODS                                              //
    //////////////////////////////////////////////////////////////////////////////////////////////
@@ -103,6 +108,8 @@ public:
    virtual Int_t  Divide(TFoamCell *);       // Divide iCell into two daughters; iCell retained, taged as inactive
    virtual void MakeActiveList();            // Creates table of active cells
    virtual void GenerCel2(TFoamCell *&);     // Chose an active cell the with probability ~ Primary integral
+   virtual Double_t SampleCellBatch(TFoamVect&, TFoamVect&, Double_t, Double_t []); // MC sampling of a cell with batches of events
+   virtual void EvalArray(Int_t, const Double_t *, Double_t *); // Evaluates the distribution function at many points
    // Generation
    virtual Double_t Eval(Double_t *);        // Evaluates value of the distribution function
    virtual void     MakeEvent();             // Makes (generates) single MC event
@@ -110,6 +117,8 @@ public:
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
    virtual Double_t MCgenerate(Double_t *MCvect);// All three above function in one
+   virtual Double_t GenerateEvent(TRandom *PseRan, Double_t *MCvect) const; // Thread-safe generation of one MC event
+   virtual void     GenerateEvents(Long_t nEvents, Double_t *MCvect, Double_t *MCwt, ULong64_t seed=1) const; // Generates many MC events in parallel
    // Finalization
    virtual void GetIntegMC(Double_t&, Double_t&);// Provides Integrand and abs. error from MC run
    virtual void GetIntNorm(Double_t&, Double_t&);// Provides normalization Inegrand
@@ -126,6 +135,7 @@ public:
    virtual void SetkDim(Int_t kDim){fDim = kDim;}            // Sets dimension of cubical space
    virtual void SetnCells(Long_t nCells){fNCells =nCells;}  // Sets maximum number of cells
    virtual void SetnSampl(Long_t nSampl){fNSampl =nSampl;}  // Sets no of MC events in cell exploration
+   virtual void SetnSamplBatch(Int_t nBatch){fNSamplBatch =nBatch;}  // Sets no of MC events of cell exploration evaluated together
    virtual void SetnBin(Int_t nBin){fNBin = nBin;}          // Sets no of bins in histogs in cell exploration
    virtual void SetChat(Int_t Chat){fChat = Chat;}          // Sets option Chat, chat level
    virtual void SetOptRej(Int_t OptRej){fOptRej =OptRej;}   // Sets option for MC rejection
@@ -149,6 +159,7 @@ public:
    // Inline
 private:
    Double_t Sqr(Double_t x) const { return x*x;}      // Square function
+   TFoamCell *FindActiveCell(Double_t random) const;  // Active cell for a random number, used by GenerCel2
    //////////////////////////////////////////////////////////////////////////////////////////////
    ClassDef(TFoam,1);   // General purpose self-adapting Monte Carlo event generator
 };
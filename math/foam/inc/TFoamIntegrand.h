@@ -18,6 +18,8 @@ public:
    TFoamIntegrand() { };
    virtual ~TFoamIntegrand() { };
    virtual Double_t Density(Int_t ndim, Double_t *) = 0;
+   // Evaluates the density at n points, with coordinate k of point i in x[k*n+i]
+   virtual void DensityArray(Int_t ndim, Int_t n, const Double_t *x, Double_t *f);
 
    ClassDef(TFoamIntegrand,1); //n-dimensional real positive integrand of FOAM
 };
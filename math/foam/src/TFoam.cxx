@@ -102,6 +102,17 @@
 // Increasing nSampl sometimes helps, but it may cost CPU time.
 // MaxWtRej may need to be increased for wild a distribution, while using OptRej=0.
 //
+// Parallel exploration and generation
+// ====================================
+// For an expensive distribution, FoamObject->SetnSamplBatch(n) makes the cell
+// exploration generate its MC events in batches of n and evaluate each batch with
+// TFoamIntegrand::DensityArray; with implicit multi-threading enabled
+// (ROOT::EnableImplicitMT) the points of a batch are evaluated in parallel.
+// After Initialize(), GenerateEvent(rnd, MCvect) generates an event with a given
+// random number generator without modifying the foam, so that several threads can
+// share the same foam, and GenerateEvents generates many events in parallel with
+// independent random number streams.
+//
 // --------------------------------------------------------------------
 // Past versions of FOAM: August 2003, v.1.00; September 2003 v.1.01
 // Adopted starting from FOAM-2.06 by P. Sawicki
@@ -123,6 +134,18 @@
 #include "TRandom.h"
 #include "TMath.h"
 #include "TInterpreter.h"
+#include "TRandomPhilox.h"
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 ClassImp(TFoam);
 
@@ -147,6 +170,9 @@ ClassImp(TFoam);
 static const Double_t gHigh= 1.0e150;
 static const Double_t gVlow=-1.0e150;
 
+// number of points evaluated in a task when exploring a cell in parallel
+static const Int_t kFoamPointsPerTask = 16;
+
 #define SW2 setprecision(7) << std::setw(12)
 
 // class to wrap a global function in a TFoamIntegrand function
@@ -190,7 +216,7 @@ TFoam::TFoam() :
    fSumOve(0), fNevGen(0),
    fWtMax(0), fWtMin(0),
    fPrime(0), fMCresult(0), fMCerror(0),
-   fAlpha(0)
+   fAlpha(0), fNSamplBatch(0), fExecutor(0)
 {
 }
 ////////////////////////////////////////////////////////////////////////////////
@@ -211,7 +237,7 @@ TFoam::TFoam(const Char_t* Name) :
    fSumOve(0), fNevGen(0),
    fWtMax(0), fWtMin(0),
    fPrime(0), fMCresult(0), fMCerror(0),
-   fAlpha(0)
+   fAlpha(0), fNSamplBatch(0), fExecutor(0)
 {
    if(strlen(Name)  >129) {
       Error("TFoam","Name too long %s \n",Name);
@@ -440,11 +466,18 @@ void TFoam::Initialize()
    //                     BUILD-UP of the FOAM                            //
    // ||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||| //
    //
+#ifdef R__USE_IMT
+   // thread pool used by EvalArray for all the cells explored in batches
+   std::shared_ptr<ROOT::TThreadExecutor> executor;
+   if(fNSamplBatch>1 && fRho && ROOT::IsImplicitMTEnabled()) executor = ROOT::Internal::GetImplicitMTExecutor();
+   fExecutor = executor.get();
+#endif
    //        Define and explore root cell(s)
    InitCells();
    //        PrintCells(); std::cout<<" ===== after InitCells ====="<<std::endl;
    Grow();
    //        PrintCells(); std::cout<<" ===== after Grow      ====="<<std::endl;
+   fExecutor = 0;
 
    MakeActiveList(); // Final Preparations for the M.C. generation
 
@@ -550,6 +583,8 @@ Int_t TFoam::CellFill(Int_t Status, TFoamCell *parent)
 /// The volume estimate in all (inactive) parent cells is updated.
 /// Note that links to parents and initial volume = 1/2 parent has to be
 /// already defined prior to calling this routine.
+/// If SetnSamplBatch(n) was called with n>1, the MC events are generated and
+/// evaluated in batches of n events (see SampleCellBatch).
 
 void TFoam::Explore(TFoamCell *cell)
 {
@@ -593,34 +628,39 @@ void TFoam::Explore(TFoamCell *cell)
    //
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
    Double_t nevEff=0.;
-   for(iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
+   if(fNSamplBatch>1) {
+      // events generated and evaluated in batches, possibly in parallel
+      nevEff = SampleCellBatch(cellPosi, cellSize, dx, ceSum);
+   } else {
+      for(iev=0;iev<fNSampl;iev++){
+         MakeAlpha();               // generate uniformly vector inside hypercube
 
-      if(fDim>0){
-      for(j=0; j<fDim; j++)
-         xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
-      }
+         if(fDim>0){
+         for(j=0; j<fDim; j++)
+            xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
 
-      wt=dx*Eval(xRand);
+         wt=dx*Eval(xRand);
 
-      nProj = 0;
-      if(fDim>0) {
-         for(k=0; k<fDim; k++) {
-            xproj =fAlpha[k];
-            ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
-            nProj++;
+         nProj = 0;
+         if(fDim>0) {
+            for(k=0; k<fDim; k++) {
+               xproj =fAlpha[k];
+               ((TH1D *)(*fHistEdg)[nProj])->Fill(xproj,wt);
+               nProj++;
+            }
          }
+         //
+         fNCalls++;
+         ceSum[0] += wt;    // sum of weights
+         ceSum[1] += wt*wt; // sum of weights squared
+         ceSum[2]++;        // sum of 1
+         if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
+         if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
+         // test MC loop exit condition
+         nevEff = ceSum[0]*ceSum[0]/ceSum[1];
+         if( nevEff >= fNBin*fEvPerBin) break;
       }
-      //
-      fNCalls++;
-      ceSum[0] += wt;    // sum of weights
-      ceSum[1] += wt*wt; // sum of weights squared
-      ceSum[2]++;        // sum of 1
-      if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
-      if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
-      // test MC loop exit condition
-      nevEff = ceSum[0]*ceSum[0]/ceSum[1];
-      if( nevEff >= fNBin*fEvPerBin) break;
    }   // ||||||||||||||||||||||||||END MC LOOP|||||||||||||||||||||||||||||
    //------------------------------------------------------------------
    //---  predefine logics of searching for the best division edge ---
@@ -696,6 +736,98 @@ void TFoam::Explore(TFoamCell *cell)
    //cell->Print();
 } // TFoam::Explore
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram used by Explore.
+/// Short MC sampling of a cell, in which the MC events are generated and
+/// evaluated in batches of fNSamplBatch events. The random points of a batch
+/// are generated with the random number generator of the foam, then the
+/// distribution is evaluated for all of them with EvalArray (in parallel, when
+/// implicit multi-threading is enabled) and the weights are accumulated in the
+/// same way as in Explore, until the same exit condition is met.
+/// The events of the last batch following the exit condition are not used,
+/// therefore the cells differ from the ones obtained without batches, but they
+/// are statistically equivalent.
+/// Returns the number of effective events.
+
+Double_t TFoam::SampleCellBatch(TFoamVect &cellPosi, TFoamVect &cellSize, Double_t dx, Double_t ceSum[5])
+{
+   Double_t nevEff = 0.;
+   const Int_t nBatch = fNSamplBatch;
+   std::vector<Double_t> alpha(nBatch*fDim);  // alpha of the events of a batch
+   std::vector<Double_t> xRand(nBatch*fDim);  // points of the events of a batch
+   std::vector<Double_t> rho(nBatch);         // distribution at the points
+   for(Long_t iev0=0; iev0<fNSampl; iev0 += nBatch) {
+      const Int_t nev = (Int_t) TMath::Min((Long_t)nBatch, fNSampl-iev0);
+      for(Int_t iev=0; iev<nev; iev++) {
+         MakeAlpha();               // generate uniformly vector inside hypercube
+         for(Int_t j=0; j<fDim; j++) {
+            alpha[iev*fDim+j] = fAlpha[j];
+            xRand[iev*fDim+j] = cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
+      }
+      EvalArray(nev, xRand.data(), rho.data());
+      fNCalls += nev;
+      for(Int_t iev=0; iev<nev; iev++) {
+         Double_t wt = dx*rho[iev];
+         for(Int_t k=0; k<fDim; k++)
+            ((TH1D *)(*fHistEdg)[k])->Fill(alpha[iev*fDim+k],wt);
+         ceSum[0] += wt;    // sum of weights
+         ceSum[1] += wt*wt; // sum of weights squared
+         ceSum[2]++;        // sum of 1
+         if (ceSum[3]>wt) ceSum[3]=wt;  // minimum weight;
+         if (ceSum[4]<wt) ceSum[4]=wt;  // maximum weight
+         // test MC loop exit condition
+         nevEff = ceSum[0]*ceSum[0]/ceSum[1];
+         if( nevEff >= fNBin*fEvPerBin) return nevEff;
+      }
+   }
+   return nevEff;
+} // TFoam::SampleCellBatch
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram.
+/// Evaluates the distribution at n points, point i being xRand[i*fDim],...,xRand[i*fDim+fDim-1].
+/// In compiled mode the points are passed in groups to TFoamIntegrand::DensityArray
+/// and, when implicit multi-threading is enabled, the groups are evaluated in
+/// parallel with the thread pool created by Initialize: the distribution must then
+/// be thread safe.
+
+void TFoam::EvalArray(Int_t n, const Double_t *xRand, Double_t *rho)
+{
+   if(!fRho) {   //interactive mode
+      std::vector<Double_t> point(fDim);
+      for(Int_t i=0; i<n; i++) {
+         std::copy(xRand+i*fDim, xRand+(i+1)*fDim, point.begin());
+         rho[i] = Eval(point.data());
+      }
+      return;
+   }
+
+   // evaluate the points first ... last-1, transposed in the layout of DensityArray
+   auto evalPoints = [&](Int_t first, Int_t last) {
+      const Int_t np = last-first;
+      std::vector<Double_t> x(np*fDim);
+      for(Int_t i=0; i<np; i++)
+         for(Int_t k=0; k<fDim; k++)
+            x[k*np+i] = xRand[(first+i)*fDim+k];
+      fRho->DensityArray(fDim, np, x.data(), rho+first);
+   };
+
+#ifdef R__USE_IMT
+   if (fExecutor && n >= 2*kFoamPointsPerTask) {
+      const UInt_t ntasks = (n + kFoamPointsPerTask - 1) / kFoamPointsPerTask;
+      auto evalTask = [&](UInt_t itask) {
+         const Int_t first = itask*kFoamPointsPerTask;
+         evalPoints(first, TMath::Min(first + kFoamPointsPerTask, n));
+         return 0;
+      };
+      fExecutor->Map(evalTask, ROOT::TSeq<UInt_t>(ntasks));
+      return;
+   }
+#endif
+   evalPoints(0, n);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal subrogram used by Initialize.
 /// In determines the best edge candidate and the position of the cell division plane
@@ -1112,12 +1244,20 @@ Double_t TFoam::Eval(Double_t *xRand)
 /// contribution into total driver integral using interpolation search.
 
 void TFoam::GenerCel2(TFoamCell *&pCell)
+{
+   pCell = FindActiveCell(fPseRan->Rndm());
+}       // TFoam::GenerCel2
+
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram.
+/// Return the active cell corresponding to the uniform random number random,
+/// found in the cumulative primary integral with interpolation search.
+
+TFoamCell *TFoam::FindActiveCell(Double_t random) const
 {
    Long_t  lo, hi, hit;
    Double_t fhit, flo, fhi;
-   Double_t random;
 
-   random=fPseRan->Rndm();
    lo  = 0;              hi =fNoAct-1;
    flo = fPrimAcu[lo];  fhi=fPrimAcu[hi];
    while(lo+1<hi) {
@@ -1136,10 +1276,10 @@ void TFoam::GenerCel2(TFoamCell *&pCell)
       }
    }
    if (fPrimAcu[lo]>random)
-      pCell = (TFoamCell *) fCellsAct->At(lo);
+      return (TFoamCell *) fCellsAct->At(lo);
    else
-      pCell = (TFoamCell *) fCellsAct->At(hi);
-}       // TFoam::GenerCel2
+      return (TFoamCell *) fCellsAct->At(hi);
+}       // TFoam::FindActiveCell
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1196,6 +1336,61 @@ ee0:
    //********************** MC LOOP ENDS HERE **********************
 } // MakeEvent
 
+////////////////////////////////////////////////////////////////////////////////
+/// User subprogram.
+/// Thread-safe version of MakeEvent: it generates a MC point/vector MCvect
+/// (of GetTotDim() elements) and returns its MC weight, using the random number
+/// generator PseRan instead of the one of the foam.
+/// The foam (the tree of cells built by Initialize) is only read, so that events can be
+/// generated concurrently from several threads, each one using its own generator.
+/// The MC statistics of the foam (sums of weights, weight monitor and histogram,
+/// number of calls) are not updated. The distribution must be given in compiled mode
+/// (SetRho) and be thread safe when used from several threads.
+/// As for MakeEvent, events with wt=1 are generated with rejection if OptRej=1.
+
+Double_t TFoam::GenerateEvent(TRandom *PseRan, Double_t *MCvect) const
+{
+   if(fCellsAct==0 || fPrimAcu==0) {
+      Error("GenerateEvent", "Foam is not initialized \n");
+      return 0;
+   }
+   if(fRho==0) {
+      Error("GenerateEvent", "Distribution function must be set with SetRho \n");
+      return 0;
+   }
+   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
+   std::vector<Double_t> alpha(fDim);
+   while(true) {
+      TFoamCell *rCell = FindActiveCell(PseRan->Rndm());   // choose randomly one cell
+      PseRan->RndmArray(fDim,alpha.data());
+      rCell->GetHcub(cellPosi,cellSize);
+      for(Int_t j=0; j<fDim; j++)
+         MCvect[j]= cellPosi[j] +alpha[j]*cellSize[j];
+      Double_t wt = rCell->GetVolume()*fRho->Density(fDim,MCvect);
+      Double_t mcwt = wt / rCell->GetPrim();  // PRIMARY controls normalization
+      if(fOptRej != 1) return mcwt;
+      //*******  Optional rejection ******
+      if( fMaxWtRej*PseRan->Rndm() > mcwt) continue;   // Wt=1 events, internal rejection
+      return (mcwt<fMaxWtRej) ? 1.0 : mcwt/fMaxWtRej;
+   }
+} // GenerateEvent
+
+////////////////////////////////////////////////////////////////////////////////
+/// User subprogram.
+/// Generates nEvents MC events with GenerateEvent: the vector of event i is stored
+/// in MCvect[i*GetTotDim()],...,MCvect[i*GetTotDim()+GetTotDim()-1] and its weight in MCwt[i].
+/// The random numbers are taken from the substreams of TRandomPhilox::GenerateStreams,
+/// initialized with seed; with implicit multi-threading the groups of events of the
+/// substreams are generated in parallel, sharing the tree of cells.
+
+void TFoam::GenerateEvents(Long_t nEvents, Double_t *MCvect, Double_t *MCwt, ULong64_t seed) const
+{
+   TRandomPhilox::GenerateStreams(seed, nEvents, [&](TRandomPhilox &rndm, Long64_t first, Long64_t n) {
+      for (Long64_t iev = first; iev < first + n; iev++)
+         MCwt[iev] = GenerateEvent(&rndm, MCvect + iev*fDim);
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User may get generated MC point/vector with help of this method
 
@@ -3,9 +3,28 @@
 
 #include "TFoamIntegrand.h"
 
+#include <vector>
+
 ClassImp(TFoamIntegrand);
 
 //_________________________________________
 // Class TFoamIntegrand
 // =====================
 // Abstract class representing n-dimensional real positive integrand function
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluates the density at n points, storing the results in f[0],...,f[n-1].
+/// The coordinates are given in structure-of-arrays layout: coordinate k of point i
+/// is x[k*n+i]. The default implementation calls Density for each point; it can be
+/// overridden to evaluate all the points together (e.g. in a vectorized loop).
+/// It is used by TFoam when the cells are explored with a batch of samples
+/// (see TFoam::SetnSamplBatch).
+
+void TFoamIntegrand::DensityArray(Int_t ndim, Int_t n, const Double_t *x, Double_t *f)
+{
+   std::vector<Double_t> point(ndim);
+   for (Int_t i = 0; i < n; i++) {
+      for (Int_t k = 0; k < ndim; k++) point[k] = x[k*n + i];
+      f[i] = Density(ndim, point.data());
+   }
+}
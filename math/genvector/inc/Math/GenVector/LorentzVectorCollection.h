@@ -0,0 +1,334 @@
+// @(#)root/mathcore:$Id$
+
+// Header file for class LorentzVectorCollection
+//
+#ifndef ROOT_Math_GenVector_LorentzVectorCollection
+#define ROOT_Math_GenVector_LorentzVectorCollection  1
+
+#ifndef ROOT_Math_GenVector_LorentzVector
+#include "Math/GenVector/LorentzVector.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_GenVector_exception
+#include "Math/GenVector/GenVector_exception.h"
+#endif
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+
+namespace ROOT {
+
+  namespace Math {
+
+//__________________________________________________________________________________________
+    /**
+        Collection of Lorentz vectors stored as a structure of arrays: the four coordinates
+        of the chosen coordinate system (e.g. px, py, pz, E for PxPyPzE4D or pt, eta, phi, M
+        for PtEtaPhiM4D) are kept in four separate contiguous arrays.
+
+        The collection provides kernels computing a kinematic quantity for all the vectors
+        in a single loop (M, Pt, Eta, Phi, ...), the matrices of the pairwise invariant masses
+        and Delta R between two collections and the boost of all the vectors.
+        The single vector kernels use the coordinate system classes for the computation of
+        each element, therefore they give the same results as the corresponding LorentzVector
+        methods, but the loops run over contiguous data and can be vectorized by the compiler.
+        The pairwise invariant masses are computed from the sums of the cartesian components
+        (see PairM).
+
+        When a dictionary is available (it is provided for the double precision coordinate
+        systems) the collection can be stored in a TTree; with split level > 0 each
+        coordinate is written in its own branch (fC0, fC1, fC2 and fC3).
+
+        @ingroup GenVector
+    */
+    template< class CoordSystem >
+    class LorentzVectorCollection {
+
+    public:
+
+       typedef typename CoordSystem::Scalar Scalar;
+       typedef CoordSystem CoordinateType;
+       typedef LorentzVector<CoordSystem> Vector;
+
+       /**
+          default constructor of an empty collection
+       */
+       LorentzVectorCollection() {}
+
+       /**
+          construct a collection of n zero vectors
+       */
+       explicit LorentzVectorCollection(size_t n) : fC0(n), fC1(n), fC2(n), fC3(n) {}
+
+       // ------ size and memory management ------
+
+       size_t size() const { return fC0.size(); }
+       bool empty() const { return fC0.empty(); }
+
+       void clear() {
+          fC0.clear(); fC1.clear(); fC2.clear(); fC3.clear();
+       }
+
+       void reserve(size_t n) {
+          fC0.reserve(n); fC1.reserve(n); fC2.reserve(n); fC3.reserve(n);
+       }
+
+       void resize(size_t n) {
+          fC0.resize(n); fC1.resize(n); fC2.resize(n); fC3.resize(n);
+       }
+
+       // ------ element access ------
+
+       /**
+          add a vector at the end of the collection
+       */
+       void push_back(const Vector & v) {
+          Scalar c[4];
+          v.GetCoordinates(c);
+          fC0.push_back(c[0]); fC1.push_back(c[1]); fC2.push_back(c[2]); fC3.push_back(c[3]);
+       }
+
+       /**
+          add a vector expressed in another coordinate system
+       */
+       template <class OtherCoords>
+       void push_back(const LorentzVector<OtherCoords> & v) {
+          push_back(Vector(v));
+       }
+
+       /**
+          add a vector from its coordinates in the collection coordinate system
+       */
+       void push_back(Scalar a, Scalar b, Scalar c, Scalar d) {
+          push_back(Vector(a, b, c, d));
+       }
+
+       /**
+          return the i-th vector (by value, since the vectors are not stored as objects)
+       */
+       Vector operator[] (size_t i) const { return Vector(fC0[i], fC1[i], fC2[i], fC3[i]); }
+       Vector At(size_t i) const { return operator[](i); }
+
+       /**
+          set the i-th vector
+       */
+       void Set(size_t i, const Vector & v) {
+          Scalar c[4];
+          v.GetCoordinates(c);
+          fC0[i] = c[0]; fC1[i] = c[1]; fC2[i] = c[2]; fC3[i] = c[3];
+       }
+
+       /**
+          direct access to the array of the coordinate icoord (0 to 3) of all vectors,
+          in the order of the coordinate system
+       */
+       const Scalar * Coordinate(unsigned int icoord) const { return CoordVector(icoord).data(); }
+       Scalar * Coordinate(unsigned int icoord) {
+          return const_cast<Scalar *>(static_cast<const LorentzVectorCollection *>(this)->Coordinate(icoord));
+       }
+
+       // ------ kernels: the result arrays must have size() elements ------
+
+       /**
+          invariant mass of each vector
+       */
+       void M(Scalar * result) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) result[i] = Coords(i).M();
+       }
+
+       /**
+          squared invariant mass of each vector
+       */
+       void M2(Scalar * result) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) result[i] = Coords(i).M2();
+       }
+
+       /**
+          transverse momentum of each vector
+       */
+       void Pt(Scalar * result) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) result[i] = Coords(i).Pt();
+       }
+
+       /**
+          pseudorapidity of each vector
+       */
+       void Eta(Scalar * result) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) result[i] = Coords(i).Eta();
+       }
+
+       /**
+          azimuthal angle of each vector
+       */
+       void Phi(Scalar * result) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) result[i] = Coords(i).Phi();
+       }
+
+       /**
+          energy of each vector
+       */
+       void E(Scalar * result) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) result[i] = Coords(i).E();
+       }
+
+       /**
+          cartesian components of all vectors
+       */
+       void GetPxPyPzE(Scalar * px, Scalar * py, Scalar * pz, Scalar * e) const {
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) {
+             const CoordSystem c = Coords(i);
+             px[i] = c.Px(); py[i] = c.Py(); pz[i] = c.Pz(); e[i] = c.E();
+          }
+       }
+
+       /**
+          invariant mass of the sum of each vector of this collection with each vector
+          of the collection other. The result is a matrix of size() x other.size() elements,
+          stored by row: result[i*other.size() + j] = (v_i + w_j).M()
+          The sums are made on the cartesian components (px, py, pz, E) of the vectors.
+          The result is therefore identical to the one of LorentzVector only when both
+          collections use cartesian coordinates (PxPyPzE4D): for the other coordinate systems
+          LorentzVector::operator+ converts the sum back to the coordinates of v_i before
+          computing M(), and the results agree only within the rounding errors of the
+          conversions.
+          As for the LorentzVector, a negative value is returned for spacelike sums.
+       */
+       template <class OtherCoords>
+       void PairM(const LorentzVectorCollection<OtherCoords> & other, Scalar * result) const {
+          const size_t n1 = size();
+          const size_t n2 = other.size();
+          if (n1 == 0 || n2 == 0) return;
+          std::vector<Scalar> p1(4*n1);
+          std::vector<Scalar> p2(4*n2);
+          const Scalar * x1 = p1.data();
+          const Scalar * y1 = x1 + n1;
+          const Scalar * z1 = y1 + n1;
+          const Scalar * e1 = z1 + n1;
+          const Scalar * x2 = p2.data();
+          const Scalar * y2 = x2 + n2;
+          const Scalar * z2 = y2 + n2;
+          const Scalar * e2 = z2 + n2;
+          GetPxPyPzE(p1.data(), p1.data() + n1, p1.data() + 2*n1, p1.data() + 3*n1);
+          other.GetPxPyPzE(p2.data(), p2.data() + n2, p2.data() + 2*n2, p2.data() + 3*n2);
+          for (size_t i = 0; i < n1; ++i) {
+             Scalar * row = result + i*n2;
+             for (size_t j = 0; j < n2; ++j) {
+                const Scalar x = x1[i] + x2[j];
+                const Scalar y = y1[i] + y2[j];
+                const Scalar z = z1[i] + z2[j];
+                const Scalar e = e1[i] + e2[j];
+                const Scalar mm = e*e - x*x - y*y - z*z;
+                row[j] = (mm >= 0) ? std::sqrt(mm) : -std::sqrt(-mm);
+             }
+          }
+       }
+
+       /**
+          Delta R = sqrt(Delta eta^2 + Delta phi^2) between each vector of this collection and
+          each vector of the collection other. The result is a matrix of size() x other.size()
+          elements, stored by row: result[i*other.size() + j] = VectorUtil::DeltaR(v_i, w_j)
+       */
+       template <class OtherCoords>
+       void DeltaR(const LorentzVectorCollection<OtherCoords> & other, Scalar * result) const {
+          const size_t n1 = size();
+          const size_t n2 = other.size();
+          if (n1 == 0 || n2 == 0) return;
+          std::vector<Scalar> etaPhi1(2*n1);
+          std::vector<Scalar> etaPhi2(2*n2);
+          Eta(etaPhi1.data());
+          Phi(etaPhi1.data() + n1);
+          other.Eta(etaPhi2.data());
+          other.Phi(etaPhi2.data() + n2);
+          const Scalar * eta2 = etaPhi2.data();
+          const Scalar * phi2 = eta2 + n2;
+          for (size_t i = 0; i < n1; ++i) {
+             const Scalar eta1 = etaPhi1[i];
+             const Scalar phi1 = etaPhi1[n1 + i];
+             Scalar * row = result + i*n2;
+             for (size_t j = 0; j < n2; ++j) {
+                Scalar dphi = phi2[j] - phi1;
+                if ( dphi > M_PI ) {
+                   dphi -= 2.0*M_PI;
+                } else if ( dphi <= -M_PI ) {
+                   dphi += 2.0*M_PI;
+                }
+                const Scalar deta = eta2[j] - eta1;
+                row[j] = std::sqrt(dphi*dphi + deta*deta);
+             }
+          }
+       }
+
+       /**
+          boost all the vectors with the velocity beta = (bx, by, bz), as VectorUtil::boost.
+          The beta of the boost must be < 1, otherwise the collection is not modified
+       */
+       void Boost(Scalar bx, Scalar by, Scalar bz) {
+          const Scalar b2 = bx*bx + by*by + bz*bz;
+          if (b2 >= 1) {
+             GenVector::Throw ( "Beta Vector supplied to set Boost represents speed >= c");
+             return;
+          }
+          const Scalar gamma = 1.0 / std::sqrt(1.0 - b2);
+          const Scalar gamma2 = b2 > 0 ? (gamma - 1.0)/b2 : 0.0;
+          const size_t n = size();
+          for (size_t i = 0; i < n; ++i) {
+             CoordSystem c = Coords(i);
+             const Scalar x = c.Px();
+             const Scalar y = c.Py();
+             const Scalar z = c.Pz();
+             const Scalar t = c.E();
+             const Scalar bp = bx*x + by*y + bz*z;
+             c.SetPxPyPzE(x + gamma2*bp*bx + gamma*bx*t,
+                          y + gamma2*bp*by + gamma*by*t,
+                          z + gamma2*bp*bz + gamma*bz*t,
+                          gamma*(t + bp) );
+             Scalar coords[4];
+             c.GetCoordinates(coords);
+             fC0[i] = coords[0]; fC1[i] = coords[1]; fC2[i] = coords[2]; fC3[i] = coords[3];
+          }
+       }
+
+       /**
+          boost all the vectors with the velocity given by a 3D vector implementing X(), Y() and Z()
+       */
+       template <class BoostVector>
+       void Boost(const BoostVector & beta) {
+          Boost(beta.X(), beta.Y(), beta.Z());
+       }
+
+    private:
+
+       CoordSystem Coords(size_t i) const { return CoordSystem(fC0[i], fC1[i], fC2[i], fC3[i]); }
+
+       const std::vector<Scalar> & CoordVector(unsigned int icoord) const {
+          switch (icoord) {
+             case 0: return fC0;
+             case 1: return fC1;
+             case 2: return fC2;
+             default: return fC3;
+          }
+       }
+
+       std::vector<Scalar> fC0;   // first coordinate of the vectors (e.g. px or pt)
+       std::vector<Scalar> fC1;   // second coordinate of the vectors (e.g. py or eta)
+       std::vector<Scalar> fC2;   // third coordinate of the vectors (e.g. pz or phi)
+       std::vector<Scalar> fC3;   // fourth coordinate of the vectors (e.g. E or M)
+
+    };
+
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_GenVector_LorentzVectorCollection */
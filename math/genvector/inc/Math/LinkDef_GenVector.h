@@ -72,6 +72,12 @@
 #pragma link C++ class ROOT::Math::LorentzVector<ROOT::Math::PxPyPzM4D<double> >+;
 #pragma link C++ class ROOT::Math::LorentzVector<ROOT::Math::PtEtaPhiM4D<double> >+;
 
+// structure of arrays collections (stored with one branch per coordinate when split)
+#pragma link C++ class ROOT::Math::LorentzVectorCollection<ROOT::Math::PxPyPzE4D<double> >+;
+#pragma link C++ class ROOT::Math::LorentzVectorCollection<ROOT::Math::PtEtaPhiE4D<double> >+;
+#pragma link C++ class ROOT::Math::LorentzVectorCollection<ROOT::Math::PxPyPzM4D<double> >+;
+#pragma link C++ class ROOT::Math::LorentzVectorCollection<ROOT::Math::PtEtaPhiM4D<double> >+;
+
 // rotations
 //#ifdef LATER
 
@@ -115,6 +121,11 @@
 #pragma link C++ typedef ROOT::Math::PxPyPzMVector;
 #pragma link C++ typedef ROOT::Math::PtEtaPhiMVector;
 
+#pragma link C++ typedef ROOT::Math::PxPyPzEVectorCollection;
+#pragma link C++ typedef ROOT::Math::PtEtaPhiEVectorCollection;
+#pragma link C++ typedef ROOT::Math::PxPyPzMVectorCollection;
+#pragma link C++ typedef ROOT::Math::PtEtaPhiMVectorCollection;
+
 // Needed for header on demand parsing
 #pragma link C++ typedef ROOT::Math::RhoZPhiVector;
 #pragma link C++ typedef ROOT::Math::PxPyPzEVector;
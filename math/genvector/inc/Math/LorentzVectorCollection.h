@@ -0,0 +1,39 @@
+// @(#)root/mathcore:$Id$
+
+#ifndef ROOT_Math_LorentzVectorCollection
+#define ROOT_Math_LorentzVectorCollection
+
+// define the coordinate systems and the LorentzVector class
+#include "Math/Vector4D.h"
+
+#include "Math/GenVector/LorentzVectorCollection.h"
+
+namespace ROOT {
+
+  namespace Math {
+
+    /**
+       collection of LorentzVector based on x,y,z,t (or px,py,pz,E) coordinates in double precision
+    */
+    typedef LorentzVectorCollection<PxPyPzE4D<double> > PxPyPzEVectorCollection;
+
+    /**
+       collection of LorentzVector based on x,y,z and Mass in double precision
+    */
+    typedef LorentzVectorCollection<PxPyPzM4D<double> > PxPyPzMVectorCollection;
+
+    /**
+       collection of LorentzVector based on pt, eta, phi and E in double precision
+    */
+    typedef LorentzVectorCollection<PtEtaPhiE4D<double> > PtEtaPhiEVectorCollection;
+
+    /**
+       collection of LorentzVector based on pt, eta, phi and Mass in double precision
+    */
+    typedef LorentzVectorCollection<PtEtaPhiM4D<double> > PtEtaPhiMVectorCollection;
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+#endif
@@ -20,6 +20,7 @@
 #include "Math/RotationZYX.h"
 
 #include "Math/LorentzRotation.h"
+#include "Math/LorentzVectorCollection.h"
 
 #include "Math/VectorUtil.h"
 #ifndef NO_SMATRIX
@@ -743,6 +744,62 @@ int testVectorUtil() {
 
 }
 
+int testLorentzVectorCollection() {
+
+  std::cout << "testing LorentzVectorCollection \t:\t";
+  int iret = 0;
+
+  PxPyPzEVectorCollection c1;
+  PtEtaPhiMVectorCollection c2;
+  std::vector<XYZTVector> v1;
+  std::vector<PtEtaPhiMVector> v2;
+  for (int i = 0; i < 5; ++i) {
+     v1.push_back( XYZTVector(1.+i, 2.-i, 3.*i-2., 10.+i) );
+     v2.push_back( PtEtaPhiMVector(5.+i, 0.5*i-1., 0.9*i-2., 0.1*i) );
+     c1.push_back(v1.back());
+     c2.push_back(v2.back());
+  }
+  iret |= compare(c1.size(), v1.size(), "size");
+
+  std::vector<double> m(c1.size()), pt(c1.size()), eta(c1.size()), phi(c1.size());
+  c1.M(m.data());
+  c1.Pt(pt.data());
+  c1.Eta(eta.data());
+  c1.Phi(phi.data());
+  for (unsigned int i = 0; i < v1.size(); ++i) {
+     iret |= compare(m[i], v1[i].M(), "M");
+     iret |= compare(pt[i], v1[i].Pt(), "Pt");
+     iret |= compare(eta[i], v1[i].Eta(), "Eta");
+     iret |= compare(phi[i], v1[i].Phi(), "Phi");
+  }
+
+  std::vector<double> mij(c1.size()*c2.size()), drij(c1.size()*c2.size());
+  c1.PairM(c2, mij.data());
+  c1.DeltaR(c2, drij.data());
+  for (unsigned int i = 0; i < v1.size(); ++i) {
+     for (unsigned int j = 0; j < v2.size(); ++j) {
+        XYZTVector vsum = v1[i] + XYZTVector(v2[j]);
+        iret |= compare(mij[i*v2.size()+j], vsum.M(), "PairM", 10);
+        iret |= compare(drij[i*v2.size()+j], DeltaR(v1[i], v2[j]), "DeltaR", 10);
+     }
+  }
+
+  XYZVector beta(0.1, -0.3, 0.5);
+  c2.Boost(beta);
+  for (unsigned int i = 0; i < v2.size(); ++i) {
+     PtEtaPhiMVector vb = boost(v2[i], beta);
+     iret |= compare(c2[i].Pt(), vb.Pt(), "boost Pt", 10);
+     iret |= compare(c2[i].Eta(), vb.Eta(), "boost Eta", 10);
+     iret |= compare(c2[i].Phi(), vb.Phi(), "boost Phi", 10);
+     iret |= compare(c2[i].M(), vb.M(), "boost M", 100);
+  }
+
+  if (iret == 0) std::cout << "\t\tOK\n";
+  else std::cout << "\t\t\t\tFAILED\n";
+  return iret;
+
+}
+
 int testGenVector() {
 
   int iret = 0;
@@ -758,6 +815,8 @@ int testGenVector() {
 
   iret |= testVectorUtil();
 
+  iret |= testLorentzVectorCollection();
+
 
   if (iret !=0) std::cout << "\nTest GenVector FAILED!!!!!!!!!\n";
   return iret;
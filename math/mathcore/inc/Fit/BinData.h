@@ -230,6 +230,19 @@ public :
       return fDataWrapper->Coords(ipoint);
    }
 
+   /**
+      copy the coordinates of the fit points [ipoint, ipoint+n) in the array x using a
+      structure-of-arrays layout: coordinate i of point j is stored in x[i*n + j].
+      This is the layout used by IParamMultiFunction::EvalPar for arrays of points
+    */
+   void GetCoordsSoA(unsigned int ipoint, unsigned int n, double * x) const {
+      for (unsigned int j = 0; j < n; ++j) {
+         const double * xj = Coords(ipoint + j);
+         for (unsigned int i = 0; i < fDim; ++i)
+            x[i*n + j] = xj[i];
+      }
+   }
+
    /**
       return the value for the given fit point
     */
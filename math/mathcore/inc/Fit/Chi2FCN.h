@@ -79,22 +79,27 @@ public:
    typedef typename BaseObjFunction::Type_t Type_t;
 
    /**
-      Constructor from data set (binned ) and model function
+      Constructor from data set (binned ) and model function.
+      The execution policy defines how the data points are evaluated (serially or in parallel chunks)
    */
-   Chi2FCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func) :
+   Chi2FCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func,
+            const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) :
       BaseFCN( data, func),
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func->NPar() ) )
+      fGrad ( std::vector<double> ( func->NPar() ) ),
+      fExecutionPolicy(executionPolicy)
    { }
 
    /**
       Same Constructor from data set (binned ) and model function but now managed by the user
       we clone the function but not the data
    */
-   Chi2FCN ( const BinData & data, const IModelFunction & func) :
+   Chi2FCN ( const BinData & data, const IModelFunction & func,
+             const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) :
       BaseFCN(std::shared_ptr<BinData>(const_cast<BinData*>(&data), DummyDeleter<BinData>()), std::shared_ptr<IModelFunction>(dynamic_cast<IModelFunction*>(func.Clone() ) ) ),
       fNEffPoints(0),
-      fGrad ( std::vector<double> ( func.NPar() ) )
+      fGrad ( std::vector<double> ( func.NPar() ) ),
+      fExecutionPolicy(executionPolicy)
    { }
 
    /**
@@ -107,7 +112,8 @@ public:
    Chi2FCN(const Chi2FCN & f) :
       BaseFCN(f.DataPtr(), f.ModelFunctionPtr() ),
       fNEffPoints( f.fNEffPoints ),
-      fGrad( f.fGrad)
+      fGrad( f.fGrad),
+      fExecutionPolicy(f.fExecutionPolicy)
    {  }
 
    /**
@@ -118,6 +124,7 @@ public:
       SetModelFunction(rhs.ModelFunctionPtr() );
       fNEffPoints = rhs.fNEffPoints;
       fGrad = rhs.fGrad; 
+      fExecutionPolicy = rhs.fExecutionPolicy;
    }
 
    /* 
@@ -165,7 +172,7 @@ private:
       return FitUtilParallel::EvaluateChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
 #else
       if (!BaseFCN::Data().HaveCoordErrors() )
-         return FitUtil::EvaluateChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
+         return FitUtil::EvaluateChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints, fExecutionPolicy);
       else
          return FitUtil::EvaluateChi2Effective(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
 #endif
@@ -182,6 +189,7 @@ private:
 
    mutable std::vector<double> fGrad; // for derivatives
 
+   ROOT::Fit::ExecutionPolicy fExecutionPolicy; // serial or multithread evaluation of the data points
 
 };
 
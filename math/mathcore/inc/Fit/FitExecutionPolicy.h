@@ -0,0 +1,34 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2016  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file defining the execution policy used when evaluating the fit method functions
+
+#ifndef ROOT_Fit_FitExecutionPolicy
+#define ROOT_Fit_FitExecutionPolicy
+
+namespace ROOT {
+
+   namespace Fit {
+
+      /**
+         Policy used to evaluate the fit objective functions (chi2, likelihood) over the data points.
+         kSerial evaluates all the points in the calling thread; kMultithread splits the data
+         in chunks which are evaluated in parallel using the ROOT thread pool (requires ROOT built
+         with imt support, otherwise the serial evaluation is used).
+         In the multithread case the model function must be safe to evaluate concurrently.
+
+         @ingroup FitMain
+      */
+      enum class ExecutionPolicy { kSerial, kMultithread };
+
+   } // end namespace Fit
+
+} // end namespace ROOT
+
+#endif /* ROOT_Fit_FitExecutionPolicy */
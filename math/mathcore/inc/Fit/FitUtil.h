@@ -21,6 +21,8 @@
 #include "Fit/DataVectorfwd.h"
 #endif
 
+#include "Fit/FitExecutionPolicy.h"
+
 
 namespace ROOT {
 
@@ -45,8 +47,12 @@ namespace FitUtil {
    /**
        evaluate the Chi2 given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the Chi2 evaluation
+       The data points can be evaluated in parallel chunks using executionPolicy = ExecutionPolicy::kMultithread.
+       nChunks is the number of chunks (when 0 it is chosen from the data size only, so the result does not
+       depend on the number of threads used)
    */
-   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);
+   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints,
+                       ROOT::Fit::ExecutionPolicy executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0);
 
    /**
        evaluate the effective Chi2 given a model function and the data at the point x.
@@ -64,8 +70,12 @@ namespace FitUtil {
    /**
        evaluate the LogL given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the LogL evaluation
+       The data points can be evaluated in parallel chunks using executionPolicy = ExecutionPolicy::kMultithread.
+       nChunks is the number of chunks (when 0 it is chosen from the data size only, so the result does not
+       depend on the number of threads used)
    */
-   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);
+   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints,
+                       ROOT::Fit::ExecutionPolicy executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0);
 
    /**
        evaluate the LogL gradient given a model function and the data at the point x.
@@ -77,8 +87,12 @@ namespace FitUtil {
        evaluate the Poisson LogL given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the LogL evaluation
        By default is extended, pass extedend to false if want to be not extended (MultiNomial)
+       The data points can be evaluated in parallel chunks using executionPolicy = ExecutionPolicy::kMultithread.
+       nChunks is the number of chunks (when 0 it is chosen from the data size only, so the result does not
+       depend on the number of threads used)
    */
-   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);
+   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints,
+                              ROOT::Fit::ExecutionPolicy executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0);
 
    /**
        evaluate the Poisson LogL given a model function and the data at the point x.
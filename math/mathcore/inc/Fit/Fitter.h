@@ -40,6 +40,8 @@ Classes used for fitting (regression analysis) and estimation of parameter value
 #include "Fit/FitResult.h"
 #endif
 
+#include "Fit/FitExecutionPolicy.h"
+
 #ifndef ROOT_Math_IParamFunctionfwd
 #include "Math/IParamFunctionfwd.h"
 #endif
@@ -149,53 +151,55 @@ public:
    }
 
    /**
-       Fit a binned data set using a least square fit (default method)
+       Fit a binned data set using a least square fit (default method).
+       With executionPolicy = ExecutionPolicy::kMultithread the data points are evaluated
+       in parallel chunks (the same applies to the likelihood fits below)
    */
-   bool Fit(const BinData & data) {
+   bool Fit(const BinData & data, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoLeastSquareFit();
+      return DoLeastSquareFit(executionPolicy);
    }
-   bool Fit(const std::shared_ptr<BinData> & data) {
+   bool Fit(const std::shared_ptr<BinData> & data, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoLeastSquareFit();
+      return DoLeastSquareFit(executionPolicy);
    }
 
    /**
        Fit a binned data set using a least square fit
    */
-   bool LeastSquareFit(const BinData & data) {
-      return Fit(data);
+   bool LeastSquareFit(const BinData & data, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
+      return Fit(data, executionPolicy);
    }
 
    /**
        fit an unbinned data set using loglikelihood method
    */
-   bool Fit(const UnBinData & data, bool extended = false) {
+   bool Fit(const UnBinData & data, bool extended = false, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoUnbinnedLikelihoodFit(extended);
+      return DoUnbinnedLikelihoodFit(extended, executionPolicy);
    }
 
    /**
       Binned Likelihood fit. Default is extended
     */
-   bool LikelihoodFit(const BinData & data, bool extended = true) {
+   bool LikelihoodFit(const BinData & data, bool extended = true, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoBinnedLikelihoodFit(extended);
+      return DoBinnedLikelihoodFit(extended, executionPolicy);
    }
-   bool LikelihoodFit(const std::shared_ptr<BinData> & data, bool extended = true) {
+   bool LikelihoodFit(const std::shared_ptr<BinData> & data, bool extended = true, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoBinnedLikelihoodFit(extended);
+      return DoBinnedLikelihoodFit(extended, executionPolicy);
    }
    /**
       Unbinned Likelihood fit. Default is not extended
     */
-   bool LikelihoodFit(const UnBinData & data, bool extended = false) {
+   bool LikelihoodFit(const UnBinData & data, bool extended = false, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoUnbinnedLikelihoodFit(extended);
+      return DoUnbinnedLikelihoodFit(extended, executionPolicy);
    }
-   bool LikelihoodFit(const std::shared_ptr<UnBinData> & data, bool extended = false) {
+   bool LikelihoodFit(const std::shared_ptr<UnBinData> & data, bool extended = false, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial) {
       SetData(data);
-      return DoUnbinnedLikelihoodFit(extended);
+      return DoUnbinnedLikelihoodFit(extended, executionPolicy);
    }
 
 
@@ -430,11 +434,11 @@ protected:
 
 
    /// least square fit
-   bool DoLeastSquareFit();
+   bool DoLeastSquareFit(const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial);
    /// binned likelihood fit
-   bool DoBinnedLikelihoodFit( bool extended = true);
+   bool DoBinnedLikelihoodFit( bool extended = true, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial);
    /// un-binned likelihood fit
-   bool DoUnbinnedLikelihoodFit( bool extended = false);
+   bool DoUnbinnedLikelihoodFit( bool extended = false, const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial);
    /// linear least square fit
    bool DoLinearFit();
 
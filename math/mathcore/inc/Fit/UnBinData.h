@@ -286,6 +286,18 @@ public:
          return fDataWrapper->Coords(ipoint);
    }
 
+   /**
+      copy the coordinates of the points [ipoint, ipoint+n) in the array x using a
+      structure-of-arrays layout: coordinate i of point j is stored in x[i*n + j]
+    */
+   void GetCoordsSoA(unsigned int ipoint, unsigned int n, double * x) const {
+      for (unsigned int j = 0; j < n; ++j) {
+         const double * xj = Coords(ipoint + j);
+         for (unsigned int i = 0; i < fDim; ++i)
+            x[i*n + j] = xj[i];
+      }
+   }
+
    bool IsWeighted() const {
       return (fPointSize == fDim+1);
    }
@@ -56,6 +56,19 @@ namespace Math {
             specified value of maxpts.
           3 n<2 or n>15
 
+   Parallel evaluation:
+
+      With SetNRegionsBatch(k), k > 1, at each iteration the k regions with the largest errors
+      are divided together and the rule points of all the new sub-regions are evaluated in one
+      batch, using the array evaluation IMultiGenFunction::EvalVec. When implicit multi-threading
+      is enabled (ROOT::EnableImplicitMT) the batch is split in tasks evaluated in parallel, so
+      the function must then be thread safe. The same stopping criteria and status codes are used,
+      but the integral can require slightly more function evaluations since some regions might be
+      divided after the requested accuracy is reached.
+      The number of regions can also be given with the integer extra option "NRegionsBatch" of
+      IntegratorMultiDimOptions, e.g. for all the adaptive integrators created by IntegratorMultiDim with
+      ROOT::Math::IntegratorMultiDimOptions::Default("ADAPTIVE").SetValue("NRegionsBatch", 64).
+
    Method:
 
       An integration rule of degree seven is used together with a certain
@@ -161,6 +174,14 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// set the number of regions divided and evaluated together at each iteration
+   /// (0 or 1 : one region at a time, as in the original algorithm). The default is given by the
+   /// extra option "NRegionsBatch" of the "ADAPTIVE" integrator
+   void SetNRegionsBatch(unsigned int n) { fNRegionsBatch = n; }
+
+   /// return the number of regions divided and evaluated together at each iteration
+   unsigned int NRegionsBatch() const { return fNRegionsBatch; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt);
 
@@ -172,6 +193,9 @@ protected:
    // internal function to compute the integral (if absVal is true compute abs value of function integral
    double DoIntegral(const double* xmin, const double * xmax, bool absVal = false);
 
+   // internal function to compute the integral dividing and evaluating several regions together
+   double DoIntegralBatch(const double* xmin, const double * xmax, bool absVal);
+
  private:
 
    unsigned int fDim;     // dimentionality of integrand
@@ -186,6 +210,7 @@ protected:
    double fRelError;      // Relative error
    int    fNEval;        // number of function evaluation
    int fStatus;   // status of algorithm (error if not zero)
+   unsigned int fNRegionsBatch;  // number of regions divided together at each iteration
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
 
@@ -97,6 +97,15 @@ public:
    /// Return the Interpolated z value corresponding to the (x,y) point
    double  Interpolate(double x, double y);
 
+   /// Compute the interpolated z values for the n points (x[i],y[i]),
+   /// in parallel when implicit multi-threading is enabled
+   void    Interpolate(int n, const double * x, const double * y, double * z);
+
+   /// Set the triangles from the indices of their vertices (three per triangle), e.g. saved from
+   /// a previous triangulation of the same points. They are used instead of computing the
+   /// triangulation the next time the triangles are needed.
+   void    SetTriangles(const std::vector<UInt_t> & vertices);
+
    /// Find all triangles 
    void      FindAllTriangles();
 
@@ -138,6 +147,11 @@ private:
    /// internal method to compute the interpolation
    double  DoInterpolateNormalized(double x, double y);
 
+#ifndef HAS_CGAL
+   /// internal function to build the triangles and the localisation grid from the vertex indices
+   void DoBuildTriangles(const std::vector<UInt_t> & vertices);
+#endif
+
 
    
 private:
@@ -183,6 +197,7 @@ protected:
 
 
    Triangles   fTriangles;   //!Triangles of Triangulation
+   std::vector<UInt_t> fInputVertices; //!Vertices of the triangles given with SetTriangles
 
 #ifdef HAS_CGAL
 
@@ -266,12 +281,17 @@ protected:
    /* To speed up localisation of points a grid is layed over normalized space
     *
     * A reference to triangle ABC is added to _all_ grid cells that include ABC's bounding box
+    *
+    * The number of cells grows with the number of triangles, such that a cell references
+    * only a few triangles. The references are stored contiguously, cell after cell:
+    * the triangles of cell c are fCellTriangles[fCellStart[c]] ... fCellTriangles[fCellStart[c+1]-1]
     */
 
-   static const int fNCells = 25; //! number of cells to divide the normalized space
+   int fNCells;       //! number of cells to divide the normalized space
    double fXCellStep; //! inverse denominator to calculate X cell = fNCells / (fXNmax - fXNmin)
    double fYCellStep; //! inverse denominator to calculate X cell = fNCells / (fYNmax - fYNmin)
-   std::set<UInt_t> fCells[(fNCells+1)*(fNCells+1)]; //! grid cells with containing triangles
+   std::vector<UInt_t> fCellStart;     //! index of the first triangle of each grid cell in fCellTriangles
+   std::vector<UInt_t> fCellTriangles; //! triangles contained in the grid cells
 
    inline unsigned int Cell(UInt_t x, UInt_t y) const {
 	   return x*(fNCells+1) + y;
@@ -36,6 +36,8 @@
 #include "Math/IFunctionfwd.h"
 #endif
 
+#include <vector>
+
 
 namespace ROOT {
 namespace Math {
@@ -93,6 +95,16 @@ namespace Math {
          return DoEval(x);
       }
 
+      /**
+         Evaluate the function at n points, storing the results in f[0],...,f[n-1].
+         The coordinates are given in structure-of-arrays layout: coordinate i of point j is x[i*n + j],
+         so that an implementation can evaluate all the points in a single (vectorizable) loop.
+         Use the virtual private method DoEvalVec, which by default calls DoEval for each point
+      */
+      void EvalVec(unsigned int n, const double * x, double * f) const {
+         DoEvalVec(n, x, f);
+      }
+
 #ifdef LATER
       /**
          Template method to eveluate the function using the begin of an iterator
@@ -113,6 +125,26 @@ namespace Math {
       */
       virtual double DoEval(const double * x) const = 0;
 
+      /**
+         Implementation of the evaluation for an array of points.
+         The default implementation evaluates the points one at a time with DoEval
+      */
+      virtual void DoEvalVec(unsigned int n, const double * x, double * f) const {
+         const unsigned int ndim = NDim();
+         double xbuf[8];
+         std::vector<double> xvec;
+         double * point = xbuf;
+         if (ndim > 8) {
+            xvec.resize(ndim);
+            point = xvec.data();
+         }
+         for (unsigned int j = 0; j < n; ++j) {
+            for (unsigned int i = 0; i < ndim; ++i)
+               point[i] = x[i*n + j];
+            f[j] = DoEval(point);
+         }
+      }
+
 
   };
 
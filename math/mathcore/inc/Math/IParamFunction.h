@@ -27,6 +27,7 @@
 
 
 #include <cassert>
+#include <vector>
 
 /**
    @defgroup ParamFunc Parameteric Function Evaluation Interfaces.
@@ -128,6 +129,17 @@ public:
 
    using BaseFunc::operator();
 
+   /**
+      Evaluate the function at n points for the parameters p, storing the results in f[0],...,f[n-1].
+      The coordinates are given in structure-of-arrays layout: coordinate i of point j is x[i*n + j],
+      so that an implementation can evaluate all the points in a single (vectorizable) loop.
+      If p is null the cached parameter values are used.
+      Use the virtual function DoEvalParVec to implement it
+   */
+   void EvalPar(unsigned int n, const double * x, const double * p, double * f) const {
+      DoEvalParVec(n, x, p, f);
+   }
+
 
 private:
 
@@ -137,6 +149,27 @@ private:
    */
    virtual double DoEvalPar(const double * x, const double * p) const = 0;
 
+   /**
+      Implementation of the evaluation for an array of points.
+      The default implementation evaluates the points one at a time with DoEvalPar
+   */
+   virtual void DoEvalParVec(unsigned int n, const double * x, const double * p, double * f) const {
+      if (p == 0) p = Parameters();
+      const unsigned int ndim = NDim();
+      double xbuf[8];
+      std::vector<double> xvec;
+      double * point = xbuf;
+      if (ndim > 8) {
+         xvec.resize(ndim);
+         point = xvec.data();
+      }
+      for (unsigned int j = 0; j < n; ++j) {
+         for (unsigned int i = 0; i < ndim; ++i)
+            point[i] = x[i*n + j];
+         f[j] = DoEvalPar(point, p);
+      }
+   }
+
    /**
       Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
    */
@@ -144,6 +177,14 @@ private:
       return DoEvalPar( x, Parameters() );
    }
 
+   /**
+      Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEvalVec using the array evaluation
+      with the cached parameter values
+   */
+   virtual void DoEvalVec(unsigned int n, const double * x, double * f) const {
+      DoEvalParVec(n, x, 0, f);
+   }
+
 };
 
 //___________________________________________________________________
@@ -360,6 +360,25 @@ public:
       return false;
    }
 
+   /**
+      minos errors for the variables ivars. valid[i] is true when the error of ivars[i] is valid
+      (see GetMinosError). Return true if at least one error is valid.
+      The default implementation calls GetMinosError for each variable; a minimizer can override it
+      to compute the errors of all the requested variables together.
+   */
+   virtual bool GetMinosErrors(const std::vector<unsigned int> & ivars, std::vector<double> & errLow,
+                               std::vector<double> & errUp, std::vector<bool> & valid) {
+      errLow.assign(ivars.size(), 0.);
+      errUp.assign(ivars.size(), 0.);
+      valid.assign(ivars.size(), false);
+      bool ok = false;
+      for (unsigned int i = 0; i < ivars.size(); ++i) {
+         valid[i] = GetMinosError(ivars[i], errLow[i], errUp[i]);
+         ok |= valid[i];
+      }
+      return ok;
+   }
+
    /**
       perform a full calculation of the Hessian matrix for error calculation
     */
@@ -190,6 +190,16 @@ namespace Math {
 
   double crystalball_function(double x, double alpha, double n, double sigma, double x0 = 0);
 
+  /**
+     Crystal ball function evaluated for the npoints values of the array x.
+     The results, computed in the gaussian core with a vectorizable approximation of exp,
+     agree with the ones of the scalar function within a few units in the last place and
+     are stored in result (which can be the same array as x)
+
+     @ingroup PdfFunc
+  */
+  void crystalball_function_array(unsigned int npoints, const double * x, double * result, double alpha, double n, double sigma, double x0 = 0);
+
    /**
        pdf definition of the crystal_ball which is defined only for n > 1 otherwise integral is diverging
     */
@@ -251,6 +261,17 @@ namespace Math {
 
   double gamma_pdf(double x, double alpha, double theta, double x0 = 0);
 
+  /**
+     Probability density function of the gamma distribution evaluated for the npoints
+     values of the array x. The results are stored in result (which can be the same
+     array as x). They are computed with vectorizable approximations of exp and log:
+     as for the scalar function, the relative precision is of the order of 1E-16 times
+     the magnitude of the exponent
+
+     @ingroup PdfFunc
+  */
+  void gamma_pdf_array(unsigned int npoints, const double * x, double * result, double alpha, double theta, double x0 = 0);
+
 
 
 
@@ -314,6 +335,15 @@ namespace Math {
 
    double landau_pdf(double x, double xi = 1, double x0 = 0);
 
+   /**
+      Probability density function of the Landau distribution evaluated for the npoints
+      values of the array x. The results, identical to the ones of the scalar function,
+      are stored in result (which can be the same array as x)
+
+      @ingroup PdfFunc
+   */
+   void landau_pdf_array(unsigned int npoints, const double * x, double * result, double xi = 1, double x0 = 0);
+
 
 
   /**
@@ -354,6 +384,16 @@ namespace Math {
 
   double normal_pdf(double x, double sigma =1, double x0 = 0);
 
+  /**
+     Probability density function of the normal (Gaussian) distribution evaluated for
+     the npoints values of the array x. The results, computed with a vectorizable
+     approximation of exp, agree with the ones of the scalar function within a few units
+     in the last place and are stored in result (which can be the same array as x)
+
+     @ingroup PdfFunc
+  */
+  void normal_pdf_array(unsigned int npoints, const double * x, double * result, double sigma = 1, double x0 = 0);
+
 
   /**
 
@@ -0,0 +1,190 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2016  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// counter-based random engine (Philox4x32-10)
+
+#ifndef ROOT_Math_PhiloxEngine
+#define ROOT_Math_PhiloxEngine
+
+#include <cstdint>
+#include <string>
+
+#ifndef ROOT_Math_TRandomEngine
+#include "Math/TRandomEngine.h"
+#endif
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+         Counter-based random number engine implementing the Philox4x32-10 algorithm
+         from
+
+         J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+         Parallel random numbers: as easy as 1, 2, 3,
+         Proceedings of SC11 (2011), http://dx.doi.org/10.1145/2063384.2063405
+
+         The n-th random number of a sequence is a pure function of the key (the seed),
+         of the stream identifier and of the counter n; there is no other state.
+         This gives:
+
+         - jump ahead of any amount at no cost (Skip, SetCounter)
+         - independent substreams selected by a 64 bit identifier, for example built from
+           the run and event number (SetStream), without the need of seeding different
+           generators
+
+         For parallel Monte Carlo each task can therefore select its own substream, e.g.
+         the event number, and the results are reproducible independently of the number of
+         threads and of the scheduling of the tasks.
+
+         Each application of the Philox function produces 128 random bits, which are used to
+         generate two double numbers with 53 random bits each.
+
+         @ingroup Random
+      */
+
+      class PhiloxEngine : public TRandomEngine {
+
+      public:
+
+         typedef  TRandomEngine BaseType;
+         typedef  uint64_t Result_t;
+         typedef  uint64_t StateInt_t;
+
+         PhiloxEngine(uint64_t seed = 1) : fKey(seed), fStream(0), fCounter(0), fOutput() { }
+
+         virtual ~PhiloxEngine() {}
+
+         /// set the generator seed (the key). The stream and the counter are reset to zero
+         void SetSeed(uint64_t seed) {
+            fKey = seed;
+            fStream = 0;
+            fCounter = 0;
+         }
+
+         /// select the substream. The counter is reset to zero
+         void SetStream(uint64_t stream) {
+            fStream = stream;
+            fCounter = 0;
+         }
+
+         /// select the substream identified by a (run, event) pair
+         void SetStream(uint32_t run, uint32_t event) {
+            SetStream( (uint64_t(run) << 32) | event );
+         }
+
+         /// set the position in the current substream (number of generated numbers)
+         void SetCounter(uint64_t n) {
+            fCounter = n;
+            // the second number of a block is read from the cached block
+            if (fCounter & 1) Generate(fCounter >> 1);
+         }
+
+         /// skip the next n numbers of the current substream
+         void Skip(uint64_t n) { SetCounter(fCounter + n); }
+
+         virtual double Rndm() {
+            return Rndm_impl();
+         }
+         inline double operator() () { return Rndm_impl(); }
+
+         /// generate an array of random numbers in ]0,1]
+         void RndmArray(int n, double * array) {
+            int i = 0;
+            // complete the current block
+            if (n > 0 && (fCounter & 1)) array[i++] = Rndm_impl();
+            // full blocks: each one is independent of the others
+            for ( ; i + 1 < n; i += 2) {
+               Generate(fCounter >> 1);
+               array[i]   = ToDouble(fOutput[0]);
+               array[i+1] = ToDouble(fOutput[1]);
+               fCounter += 2;
+            }
+            if (i < n) array[i] = Rndm_impl();
+         }
+
+         /// generate a 64 bit integer number
+         uint64_t IntRndm() {
+            if ((fCounter & 1) == 0) Generate(fCounter >> 1);
+            return fOutput[fCounter++ & 1];
+         }
+
+         /// minimum integer that can be generated
+         static uint64_t MinInt() { return 0; }
+         /// maximum integer that can be generated
+         static uint64_t MaxInt() { return UINT64_MAX; }  //  2^64 -1
+         /// Size of the generator state (key, stream and counter)
+         static int Size() { return 3; }
+         /// Name of the generator
+         static std::string Name() { return "PhiloxEngine"; }
+
+         /// current position in the substream (number of generated numbers)
+         uint64_t Counter() const { return fCounter; }
+         /// current substream
+         uint64_t Stream() const { return fStream; }
+
+         /// apply the Philox4x32-10 function to the counter (ctr) using the key (key)
+         static void Philox(uint32_t ctr[4], const uint32_t key[2]) {
+            const uint32_t kM0 = 0xD2511F53;
+            const uint32_t kM1 = 0xCD9E8D57;
+            const uint32_t kW0 = 0x9E3779B9;
+            const uint32_t kW1 = 0xBB67AE85;
+            uint32_t k0 = key[0];
+            uint32_t k1 = key[1];
+            for (int round = 0; round < 10; ++round) {
+               const uint64_t p0 = uint64_t(kM0) * ctr[0];
+               const uint64_t p1 = uint64_t(kM1) * ctr[2];
+               const uint32_t c1 = ctr[1];
+               const uint32_t c3 = ctr[3];
+               ctr[0] = uint32_t(p1 >> 32) ^ c1 ^ k0;
+               ctr[1] = uint32_t(p1);
+               ctr[2] = uint32_t(p0 >> 32) ^ c3 ^ k1;
+               ctr[3] = uint32_t(p0);
+               k0 += kW0;
+               k1 += kW1;
+            }
+         }
+
+      private:
+
+         // compute the block with the given index of the current stream
+         void Generate(uint64_t block) {
+            uint32_t ctr[4] = { uint32_t(block), uint32_t(block >> 32),
+                                uint32_t(fStream), uint32_t(fStream >> 32) };
+            const uint32_t key[2] = { uint32_t(fKey), uint32_t(fKey >> 32) };
+            Philox(ctr, key);
+            fOutput[0] = (uint64_t(ctr[1]) << 32) | ctr[0];
+            fOutput[1] = (uint64_t(ctr[3]) << 32) | ctr[2];
+         }
+
+         // use the 53 most significant bits, giving a number in ]0,1]
+         static double ToDouble(uint64_t x) {
+            const double kCONS = 1.1102230246251565E-16; // 1/pow(2,53)
+            return ((x >> 11) + 1) * kCONS;
+         }
+
+         double Rndm_impl() {
+            if ((fCounter & 1) == 0) Generate(fCounter >> 1);
+            return ToDouble(fOutput[fCounter++ & 1]);
+         }
+
+         uint64_t fKey;        // key of the generator (seed)
+         uint64_t fStream;     // substream identifier
+         uint64_t fCounter;    // number of generated numbers in the substream
+         uint64_t fOutput[2];  // output of the current block
+      };
+
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_PhiloxEngine */
@@ -481,6 +481,16 @@ namespace Math {
    */
 
    double normal_cdf(double x, double sigma = 1, double x0 = 0);
+
+   /**
+      Cumulative distribution function of the normal (Gaussian) distribution evaluated
+      for the npoints values of the array x. The results, computed with a vectorizable
+      approximation of erfc, agree with the ones of the scalar function within a few units
+      in the last place and are stored in result (which can be the same array as x)
+
+      @ingroup ProbFunc
+   */
+   void normal_cdf_array(unsigned int npoints, const double * x, double * result, double sigma = 1, double x0 = 0);
    /// Alternative name for same function
    inline double gaussian_cdf(double x, double sigma = 1, double x0 = 0) {
       return normal_cdf(x,sigma,x0);
@@ -60,6 +60,16 @@ namespace Math {
 
    double erf(double x);
 
+   /**
+      Error function evaluated for the npoints values of the array x.
+      The results, computed with a vectorizable form of the approximation used by erf,
+      agree with the ones of the scalar function within a few units in the last place
+      and are stored in result (which can be the same array as x)
+
+      @ingroup SpecFunc
+   */
+   void erf_array(unsigned int npoints, const double * x, double * result);
+
 
 
    /**
@@ -109,6 +119,14 @@ namespace Math {
    */
    double lgamma(double x);
 
+   /**
+      Logarithm of the gamma function evaluated for the npoints values of the array x.
+      The results are stored in result (which can be the same array as x)
+
+      @ingroup SpecFunc
+   */
+   void lgamma_array(unsigned int npoints, const double * x, double * result);
+
 
    /**
       Calculates the normalized (regularized) lower incomplete gamma function (lower integral)
@@ -91,6 +91,11 @@ namespace ROOT {
             return Rndm(); 
          }
 
+         /// generate an array of random numbers in ]0,1]
+         void RndmArray(int n, double * array) {
+            for (int i = 0; i < n; ++i) array[i] = Rndm();
+         }
+
          static std::string Name()  {
             return StdEngineType<Generator>::Name(); 
          }
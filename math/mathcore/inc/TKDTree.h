@@ -50,6 +50,7 @@ public:
    Index   GetBucketSize() {return fBucketSize;}
 
    void    FindNearestNeighbors(const Value *point, Int_t k, Index *ind, Value *dist);
+   void    FindNearestNeighbors(Index npoints, const Value *points, Int_t k, Index *ind, Value *dist);
    Index   FindNode(const Value * point) const;
    void    FindPoint(Value * point, Index &index, Int_t &iter);
    void    FindInRange(Value *point, Value range, std::vector<Index> &res);
@@ -71,6 +72,8 @@ public:
    TKDTree(const TKDTree &); // not implemented
    TKDTree<Index, Value>& operator=(const TKDTree<Index, Value>&); // not implemented
    void CookBoundaries(const Int_t node, Bool_t left);
+   void BuildSubtree(Int_t node, Int_t row, Int_t pos, Int_t npoints);
+   void DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints, Int_t &nleft, Int_t &nright);
 
    void UpdateNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Value *dist);
    void UpdateRange(Index inode, Value *point, Value range, std::vector<Index> &res);
@@ -273,9 +273,11 @@ namespace TMath {
    Double_t FDist(Double_t F, Double_t N, Double_t M);
    Double_t FDistI(Double_t F, Double_t N, Double_t M);
    Double_t Gaus(Double_t x, Double_t mean=0, Double_t sigma=1, Bool_t norm=kFALSE);
+   void     GausArray(Long64_t n, const Double_t *x, Double_t *result, Double_t mean=0, Double_t sigma=1, Bool_t norm=kFALSE);
    Double_t KolmogorovProb(Double_t z);
    Double_t KolmogorovTest(Int_t na, const Double_t *a, Int_t nb, const Double_t *b, Option_t *option);
    Double_t Landau(Double_t x, Double_t mpv=0, Double_t sigma=1, Bool_t norm=kFALSE);
+   void     LandauArray(Long64_t n, const Double_t *x, Double_t *result, Double_t mpv=0, Double_t sigma=1, Bool_t norm=kFALSE);
    Double_t LandauI(Double_t x);
    Double_t LaplaceDist(Double_t x, Double_t alpha=0, Double_t beta=1);
    Double_t LaplaceDistI(Double_t x, Double_t alpha=0, Double_t beta=1);
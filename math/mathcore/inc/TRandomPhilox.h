@@ -0,0 +1,56 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TRandomPhilox
+#define ROOT_TRandomPhilox
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TRandomPhilox                                                        //
+//                                                                      //
+// random number generator class: counter-based Philox4x32-10 with      //
+// jump ahead and keyed substreams                                      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_TRandomGen
+#include "TRandomGen.h"
+#endif
+
+#ifndef ROOT_Math_PhiloxEngine
+#include "Math/PhiloxEngine.h"
+#endif
+
+#include <functional>
+
+class TRandomPhilox : public TRandomGen<ROOT::Math::PhiloxEngine> {
+
+public:
+   TRandomPhilox(ULong_t seed=1) : TRandomGen<ROOT::Math::PhiloxEngine>(seed) { fSeed = seed; }
+   virtual ~TRandomPhilox() {}
+
+   virtual  void      SetSeed(ULong_t seed=0) { fSeed = seed; fEngine.SetSeed(seed); }
+   // select an independent substream; the position in the stream is reset
+   void               SetStream(ULong64_t stream) { fEngine.SetStream(stream); }
+   void               SetStream(UInt_t run, UInt_t event) { fEngine.SetStream(run, event); }
+   ULong64_t          GetStream() const { return fEngine.Stream(); }
+   // jump ahead in the current substream
+   void               Skip(ULong64_t n) { fEngine.Skip(n); }
+   void               SetCounter(ULong64_t n) { fEngine.SetCounter(n); }
+   ULong64_t          GetCounter() const { return fEngine.Counter(); }
+
+   // generate nevents events by groups, each with its own substream (in parallel with implicit MT)
+   static void        GenerateStreams(ULong64_t seed, Long64_t nevents,
+                                      const std::function<void(TRandomPhilox &rndm, Long64_t first, Long64_t n)> &generate);
+
+   ClassDef(TRandomPhilox,1)  //Counter-based Philox random number generator
+};
+
+#endif
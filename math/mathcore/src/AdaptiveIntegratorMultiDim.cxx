@@ -4,15 +4,254 @@
 #include "Math/IFunction.h"
 #include "Math/AdaptiveIntegratorMultiDim.h"
 #include "Math/IntegratorOptions.h"
+#include "Math/GenAlgoOptions.h"
 #include "Math/Error.h"
 
+#include "RConfigure.h"
+
 #include <cmath>
 #include <algorithm>
+#include <vector>
+#include <utility>
+#include <memory>
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 namespace ROOT {
 namespace Math {
 
+// minimum number of function evaluations in a task when the regions are evaluated in parallel
+const unsigned int kAdaptiveIntegratorPointsPerTask = 512;
+
+namespace {
+
+   // abscissas and weights of the degree seven rule of Genz and Malik, used for each region
+
+   const double xl2 = 0.358568582800318073;//lambda_2
+   const double xl4 = 0.948683298050513796;//lambda_4
+   const double xl5 = 0.688247201611685289;//lambda_5
+   const double w2  = 980./6561; //weights/2^n
+   const double w4  = 200./19683;
+   const double wp2 = 245./486;//error weights/2^n
+   const double wp4 = 25./729;
+
+   const double wn1[14] = {     -0.193872885230909911, -0.555606360818980835,
+                                -0.876695625666819078, -1.15714067977442459,  -1.39694152314179743,
+                                -1.59609815576893754,  -1.75461057765584494,  -1.87247878880251983,
+                                -1.94970278920896201,  -1.98628257887517146,  -1.98221815780114818,
+                                -1.93750952598689219,  -1.85215668343240347,  -1.72615963013768225};
+
+   const double wn3[14] = {     0.0518213686937966768,  0.0314992633236803330,
+                                0.0111771579535639891,-0.00914494741655235473,-0.0294670527866686986,
+                                -0.0497891581567850424,-0.0701112635269013768, -0.0904333688970177241,
+                                -0.110755474267134071, -0.131077579637250419,  -0.151399685007366752,
+                                -0.171721790377483099, -0.192043895747599447,  -0.212366001117715794};
+
+   const double wn5[14] = {         0.871183254585174982e-01,  0.435591627292587508e-01,
+                                    0.217795813646293754e-01,  0.108897906823146873e-01,  0.544489534115734364e-02,
+                                    0.272244767057867193e-02,  0.136122383528933596e-02,  0.680611917644667955e-03,
+                                    0.340305958822333977e-03,  0.170152979411166995e-03,  0.850764897055834977e-04,
+                                    0.425382448527917472e-04,  0.212691224263958736e-04,  0.106345612131979372e-04};
+
+   const double wpn1[14] = {   -1.33196159122085045, -2.29218106995884763,
+                               -3.11522633744855959, -3.80109739368998611, -4.34979423868312742,
+                               -4.76131687242798352, -5.03566529492455417, -5.17283950617283939,
+                               -5.17283950617283939, -5.03566529492455417, -4.76131687242798352,
+                               -4.34979423868312742, -3.80109739368998611, -3.11522633744855959};
+
+   const double wpn3[14] = {     0.0445816186556927292, -0.0240054869684499309,
+                                 -0.0925925925925925875, -0.161179698216735251,  -0.229766803840877915,
+                                 -0.298353909465020564,  -0.366941015089163228,  -0.435528120713305891,
+                                 -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
+                                 -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
+
+
+   // sub-region of the integration domain with the result of the rule
+   struct IntegrationRegion {
+      std::vector<double> fCenter;   // center of the region
+      std::vector<double> fWidth;    // half width of the region
+      double fValue;                 // estimate of the integral in the region
+      double fError;                 // estimate of the error in the region
+      unsigned int fDivAxis;         // axis (starting from 1) along which the region is divided
+      bool fZero;                    // all the function values in the region are zero
+   };
+
+   // ordering of the heap of regions: the region with the largest error is on top
+   struct IntegrationRegionLess {
+      bool operator() (const IntegrationRegion & r1, const IntegrationRegion & r2) const {
+         return r1.fError < r2.fError;
+      }
+   };
+
+   // fill the rule points of a region, in the same order as they are evaluated in
+   // AdaptiveIntegratorMultiDim::DoIntegral. Point j is stored in x[j*n], ..., x[j*n+n-1].
+   // Return the number of points
+   unsigned int FillRulePoints(unsigned int n, const double * ctr, const double * wth, double * x)
+   {
+      double wthl[15], z[15];
+      unsigned int np = 0;
+      unsigned int j;
+      for (j = 0; j < n; j++) z[j] = ctr[j];
+      std::copy(z, z+n, x + n*np++);
+      for (j = 0; j < n; j++) {
+         z[j] = ctr[j] - xl2*wth[j];
+         std::copy(z, z+n, x + n*np++);
+         z[j] = ctr[j] + xl2*wth[j];
+         std::copy(z, z+n, x + n*np++);
+         wthl[j] = xl4*wth[j];
+         z[j] = ctr[j] - wthl[j];
+         std::copy(z, z+n, x + n*np++);
+         z[j] = ctr[j] + wthl[j];
+         std::copy(z, z+n, x + n*np++);
+         z[j] = ctr[j];
+      }
+      for (j = 1; j < n; j++) {
+         unsigned int j1 = j-1;
+         for (unsigned int k = j; k < n; k++) {
+            for (unsigned int l = 0; l < 2; l++) {
+               wthl[j1] = -wthl[j1];
+               z[j1]    = ctr[j1] + wthl[j1];
+               for (unsigned int m = 0; m < 2; m++) {
+                  wthl[k] = -wthl[k];
+                  z[k]    = ctr[k] + wthl[k];
+                  std::copy(z, z+n, x + n*np++);
+               }
+            }
+            z[k] = ctr[k];
+         }
+         z[j1] = ctr[j1];
+      }
+      for (j = 0; j < n; j++) {
+         wthl[j] = -xl5*wth[j];
+         z[j] = ctr[j] + wthl[j];
+      }
+      // end nodes (gray code)
+      bool next = true;
+      while (next) {
+         std::copy(z, z+n, x + n*np++);
+         next = false;
+         for (j = 0; j < n; j++) {
+            wthl[j] = -wthl[j];
+            z[j] = ctr[j] + wthl[j];
+            if (wthl[j] > 0) { next = true; break; }
+         }
+      }
+      return np;
+   }
+
+   // apply the rule to the region using the np function values f at the points given by FillRulePoints
+   void ApplyRule(unsigned int n, unsigned int np, const double * f, IntegrationRegion & region)
+   {
+      double rgnvol = std::pow(2.0,static_cast<int>(n));
+      for (unsigned int j = 0; j < n; j++) rgnvol *= region.fWidth[j];
+
+      unsigned int ip = 0;
+      double sum1 = f[ip++];
+      double sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0, difmax = 0;
+      unsigned int idvaxn = 0;
+      for (unsigned int j = 0; j < n; j++) {
+         double f2 = f[ip] + f[ip+1];
+         double f3 = f[ip+2] + f[ip+3];
+         ip += 4;
+         sum2 += f2;
+         sum3 += f3;
+         double dif = std::abs(7*f2-f3-12*sum1);
+         if (dif >= difmax) {
+            difmax = dif;
+            idvaxn = j+1;
+         }
+      }
+      for (unsigned int i = 0; i < 2*n*(n-1); i++) sum4 += f[ip++];
+      while (ip < np) sum5 += f[ip++];
+
+      double rgncmp = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
+      double rgnval = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
+      rgnval *= rgnvol;
+      region.fValue = rgnval;
+      region.fError = std::abs(rgnval-rgncmp);
+      region.fDivAxis = idvaxn;
+      region.fZero = (sum1==0 && sum2==0 && sum3==0 && sum4==0 && sum5==0);
+   }
+
+#ifdef R__USE_IMT
+   typedef ROOT::TThreadExecutor RegionExecutor;
+#else
+   // placeholder, without imt support the regions are always evaluated serially
+   struct RegionExecutor {};
+#endif
+
+   void EvaluateRegions(const IMultiGenFunction & func, std::vector<IntegrationRegion> & regions, bool absValue,
+                        RegionExecutor * pool)
+   {
+      // evaluate the rule on all the given regions. The rule points of a group of regions are
+      // evaluated with a single call to IMultiGenFunction::EvalVec; when a thread pool is given
+      // the groups are evaluated in parallel
+      const unsigned int n = func.NDim();
+      const unsigned int irlcls = (1u << n) + 2*n*(n+1) + 1;
+      const unsigned int nregions = regions.size();
+
+      auto evalRegions = [&](unsigned int first, unsigned int last) {
+         std::vector<double> xrule(irlcls*n);
+         std::vector<double> x(irlcls*n*(last-first));
+         std::vector<double> f(irlcls*(last-first));
+         std::vector<unsigned int> npoints(last-first);
+         // collect the points of all the regions one after the other, then transpose them
+         // in the structure-of-arrays layout x[i*ntot + j] used by EvalVec
+         unsigned int ntot = 0;
+         for (unsigned int ireg = first; ireg < last; ++ireg) {
+            unsigned int np = FillRulePoints(n, regions[ireg].fCenter.data(), regions[ireg].fWidth.data(), xrule.data());
+            std::copy(xrule.begin(), xrule.begin() + np*n, x.begin() + ntot*n);
+            npoints[ireg-first] = np;
+            ntot += np;
+         }
+         std::vector<double> xsoa(ntot*n);
+         for (unsigned int j = 0; j < ntot; ++j)
+            for (unsigned int i = 0; i < n; ++i)
+               xsoa[i*ntot + j] = x[j*n + i];
+         func.EvalVec(ntot, xsoa.data(), f.data());
+         if (absValue) {
+            for (unsigned int j = 0; j < ntot; ++j) f[j] = std::abs(f[j]);
+         }
+         unsigned int offset = 0;
+         for (unsigned int ireg = first; ireg < last; ++ireg) {
+            ApplyRule(n, npoints[ireg-first], f.data() + offset, regions[ireg]);
+            offset += npoints[ireg-first];
+         }
+      };
+
+#ifdef R__USE_IMT
+      const unsigned int regionsPerTask = std::max(1u, kAdaptiveIntegratorPointsPerTask/irlcls);
+      if (pool && nregions > regionsPerTask) {
+         const unsigned int ntasks = (nregions + regionsPerTask - 1) / regionsPerTask;
+         auto evalTask = [&](unsigned int itask) {
+            const unsigned int first = itask*regionsPerTask;
+            evalRegions(first, std::min(first + regionsPerTask, nregions));
+            return 0;
+         };
+         pool->Map(evalTask, ROOT::TSeq<unsigned int>(ntasks));
+         return;
+      }
+#else
+      (void) pool;
+#endif
+      evalRegions(0, nregions);
+   }
 
+   unsigned int DefaultNRegionsBatch()
+   {
+      // number of regions divided together set in the default extra options of the
+      // "ADAPTIVE" integrator (IntegratorMultiDimOptions::Default("ADAPTIVE"))
+      const IOptions * opts = IntegratorMultiDimOptions::FindDefault("ADAPTIVE");
+      int nbatch = 0;
+      if (opts && opts->GetValue("NRegionsBatch", nbatch) && nbatch > 0) return nbatch;
+      return 0;
+   }
+
+}
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
    fDim(0),
@@ -25,6 +264,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fNRegionsBatch(0),
    fFun(0)
 {
    // constructor - without passing a function
@@ -32,6 +272,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    if (fRelTol < 0) fRelTol = ROOT::Math::IntegratorMultiDimOptions::DefaultRelTolerance();
    if (fMaxPts == 0) fMaxPts = ROOT::Math::IntegratorMultiDimOptions::DefaultNCalls();
    if (fSize   == 0) fSize = ROOT::Math::IntegratorMultiDimOptions::DefaultWKSize();
+   fNRegionsBatch = DefaultNRegionsBatch();
 }
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction &f, double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -45,6 +286,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fNRegionsBatch(0),
    fFun(&f)
 {
    // constructur passing a multi-dimensional function interface
@@ -53,6 +295,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    if (fRelTol < 0) fRelTol = ROOT::Math::IntegratorMultiDimOptions::DefaultRelTolerance();
    if (fMaxPts == 0) fMaxPts = ROOT::Math::IntegratorMultiDimOptions::DefaultNCalls();
    if (fSize   == 0) fSize = ROOT::Math::IntegratorMultiDimOptions::DefaultWKSize();
+   fNRegionsBatch = DefaultNRegionsBatch();
 }
 
 
@@ -83,6 +326,8 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    //   2.A. van Doren and L. de Ridder, An adaptive algorithm for numerical
    //     integration over an n-dimensional cube, J.Comput. Appl. Math. 2 (1976) 207-217.
 
+   if (fNRegionsBatch > 1) return DoIntegralBatch(xmin, xmax, absValue);
+
    //to be changed later
    unsigned int n=fDim;
    bool kFALSE = false;
@@ -98,44 +343,6 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
 
    double ctr[15], wth[15], wthl[15], z[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
-   static const double w2  = 980./6561; //weights/2^n
-   static const double w4  = 200./19683;
-   static const double wp2 = 245./486;//error weights/2^n
-   static const double wp4 = 25./729;
-
-   static const double wn1[14] = {     -0.193872885230909911, -0.555606360818980835,
-                                       -0.876695625666819078, -1.15714067977442459,  -1.39694152314179743,
-                                       -1.59609815576893754,  -1.75461057765584494,  -1.87247878880251983,
-                                       -1.94970278920896201,  -1.98628257887517146,  -1.98221815780114818,
-                                       -1.93750952598689219,  -1.85215668343240347,  -1.72615963013768225};
-
-   static const double wn3[14] = {     0.0518213686937966768,  0.0314992633236803330,
-                                       0.0111771579535639891,-0.00914494741655235473,-0.0294670527866686986,
-                                       -0.0497891581567850424,-0.0701112635269013768, -0.0904333688970177241,
-                                       -0.110755474267134071, -0.131077579637250419,  -0.151399685007366752,
-                                       -0.171721790377483099, -0.192043895747599447,  -0.212366001117715794};
-
-   static const double wn5[14] = {         0.871183254585174982e-01,  0.435591627292587508e-01,
-                                           0.217795813646293754e-01,  0.108897906823146873e-01,  0.544489534115734364e-02,
-                                           0.272244767057867193e-02,  0.136122383528933596e-02,  0.680611917644667955e-03,
-                                           0.340305958822333977e-03,  0.170152979411166995e-03,  0.850764897055834977e-04,
-                                           0.425382448527917472e-04,  0.212691224263958736e-04,  0.106345612131979372e-04};
-
-   static const double wpn1[14] = {   -1.33196159122085045, -2.29218106995884763,
-                                      -3.11522633744855959, -3.80109739368998611, -4.34979423868312742,
-                                      -4.76131687242798352, -5.03566529492455417, -5.17283950617283939,
-                                      -5.17283950617283939, -5.03566529492455417, -4.76131687242798352,
-                                      -4.34979423868312742, -3.80109739368998611, -3.11522633744855959};
-
-   static const double wpn3[14] = {     0.0445816186556927292, -0.0240054869684499309,
-                                        -0.0925925925925925875, -0.161179698216735251,  -0.229766803840877915,
-                                        -0.298353909465020564,  -0.366941015089163228,  -0.435528120713305891,
-                                        -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
-                                        -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
-
    double result = 0;
    double abserr = 0;
    fStatus  = 3;
@@ -382,6 +589,125 @@ L160: //to divide or not
 
 
 
+double AdaptiveIntegratorMultiDim::DoIntegralBatch(const double* xmin, const double * xmax, bool absValue)
+{
+   // Same algorithm as DoIntegral, but at each iteration the fNRegionsBatch regions with the
+   // largest errors are divided and the rule is applied to all the new sub-regions at once.
+   // The convergence criteria and the status codes are the same as in DoIntegral.
+
+   const unsigned int n = fDim;
+   fStatus = 3;
+   if (n < 2 || n > 15) {
+      MATH_WARN_MSGVAL("AdaptiveIntegratorMultiDim::Integral","Wrong function dimension",n);
+      return 0;
+   }
+
+   const unsigned int irgnst = 2*n+3;
+   const unsigned int irlcls = (1u << n) + 2*n*(n+1) + 1;
+
+   unsigned int minpts = fMinPts;
+   unsigned int maxpts = std::max(fMaxPts, irlcls);
+   if (minpts < 1)      minpts = irlcls;
+   if (maxpts < minpts) maxpts = 10*minpts;
+   // maximum number of stored regions, as given by the working space of DoIntegral
+   const unsigned int iwk = std::max( fSize, irgnst*(1 +maxpts/irlcls)/2 );
+   const unsigned int maxRegions = iwk/irgnst;
+
+   std::vector<IntegrationRegion> newRegions(1);
+   newRegions[0].fCenter.resize(n);
+   newRegions[0].fWidth.resize(n);
+   for (unsigned int j = 0; j < n; j++) {
+      newRegions[0].fCenter[j] = (xmax[j] + xmin[j])*0.5;
+      newRegions[0].fWidth[j]  = (xmax[j] - xmin[j])*0.5;
+   }
+
+   // heap of the regions ordered by their error
+   std::vector<IntegrationRegion> regions;
+   IntegrationRegionLess errorLess;
+
+   double result = 0;
+   double abserr = 0;
+   double relerr = 0;
+   unsigned int ifncls = 0;
+
+   // thread pool used by all the iterations, when implicit multi-threading is enabled
+   std::shared_ptr<RegionExecutor> pool;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) pool = ROOT::Internal::GetImplicitMTExecutor();
+#endif
+
+   while (true) {
+      EvaluateRegions(*fFun, newRegions, absValue, pool.get());
+
+      // as in DoIntegral, a null result is accepted when the rule gives zero for all the points
+      // of the last evaluated region (the upper half of the last divided region)
+      const bool lastZero = newRegions.back().fZero;
+      for (unsigned int ireg = 0; ireg < newRegions.size(); ++ireg) {
+         result += newRegions[ireg].fValue;
+         abserr += newRegions[ireg].fError;
+         regions.push_back(std::move(newRegions[ireg]));
+         std::push_heap(regions.begin(), regions.end(), errorLess);
+      }
+      ifncls += irlcls*newRegions.size();
+
+      double aresult = std::abs(result);
+      relerr = abserr;
+      if (aresult != 0)  relerr = abserr/aresult;
+
+      fStatus = 3;
+      if (relerr < 1e-1 && aresult < 1e-20) fStatus = 0;
+      if (relerr < 1e-3 && aresult < 1e-10) fStatus = 0;
+      if (relerr < 1e-5 && aresult < 1e-5)  fStatus = 0;
+      if (regions.size() + 1 > maxRegions) fStatus = 2;
+      if (ifncls+2*irlcls > maxpts) {
+         if (lastZero) {
+            fStatus = 0;
+            result = 0;
+         }
+         else
+            fStatus = 1;
+      }
+      if ( ( relerr < fRelTol || abserr < fAbsTol ) && ifncls >= minpts) fStatus = 0;
+
+      if (fStatus != 3) break;
+
+      // number of regions to divide, limited by the maximum number of function evaluations
+      // and by the maximum number of regions
+      unsigned int ndiv = std::min<unsigned int>(fNRegionsBatch, regions.size());
+      ndiv = std::min(ndiv, (maxpts - ifncls)/(2*irlcls));
+      ndiv = std::min(ndiv, maxRegions - (unsigned int) regions.size());
+      ndiv = std::max(ndiv, 1u);
+
+      newRegions.clear();
+      for (unsigned int idiv = 0; idiv < ndiv; ++idiv) {
+         std::pop_heap(regions.begin(), regions.end(), errorLess);
+         IntegrationRegion region = std::move(regions.back());
+         regions.pop_back();
+         result -= region.fValue;
+         abserr -= region.fError;
+         unsigned int iaxis = region.fDivAxis;
+         if (iaxis < 1) {
+            // Can happen for overflows / degenerate floats.
+            iaxis = 1;
+            ::Error("AdaptiveIntegratorMultiDim::DoIntegralBatch()", "Logic error: idvax0 < 1!");
+         }
+         region.fWidth[iaxis-1] *= 0.5;
+         region.fCenter[iaxis-1] -= region.fWidth[iaxis-1];
+         newRegions.push_back(region);
+         region.fCenter[iaxis-1] += 2*region.fWidth[iaxis-1];
+         newRegions.push_back(region);
+      }
+   }
+
+   fResult = result;
+   fError = abserr;
+   fRelError = relerr;
+   fNEval = ifncls;
+
+   return result;
+}
+
+
 double AdaptiveIntegratorMultiDim::Integral(const IMultiGenFunction &f, const double* xmin, const double * xmax)
 {
    // calculate integral passing a function object
@@ -398,6 +724,14 @@ ROOT::Math::IntegratorMultiDimOptions  AdaptiveIntegratorMultiDim::Options() con
    opt.SetNCalls(fMaxPts);
    opt.SetWKSize(fSize);
    opt.SetIntegrator("ADAPTIVE");
+   // specific options
+   if (opt.ExtraOptions())
+      opt.ExtraOptions()->SetValue("NRegionsBatch", int(fNRegionsBatch));
+   else {
+      GenAlgoOptions extraOpts;
+      extraOpts.SetValue("NRegionsBatch", int(fNRegionsBatch));
+      opt.SetExtraOptions(extraOpts);
+   }
    return opt;
 }
 
@@ -412,6 +746,10 @@ void AdaptiveIntegratorMultiDim::SetOptions(const ROOT::Math::IntegratorMultiDim
    SetRelTolerance( opt.RelTolerance() );
    SetMaxPts( opt.NCalls() );
    SetSize( opt.WKSize() );
+   // specific options
+   const IOptions * extraOpts = opt.ExtraOptions();
+   int nbatch = 0;
+   if (extraOpts && extraOpts->GetValue("NRegionsBatch", nbatch) ) SetNRegionsBatch( std::max(nbatch, 0) );
 }
 
 } // namespace Math
@@ -23,8 +23,16 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <stdlib.h>
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 namespace ROOT {
    
    namespace Math {
@@ -49,6 +57,7 @@ Delaunay2D::Delaunay2D(int n, const double * x, const double * y, const double *
    fXNmin        = 0;
    fYNmin        = 0;
    fYNmax        = 0; 
+   fZout         = 0;
 
    SetInputPoints(n,x,y,z,xmin,xmax,ymin,ymax);
 
@@ -65,6 +74,8 @@ void Delaunay2D::SetInputPoints(int n, const double * x, const double * y, const
    fInit         = kFALSE;
 #endif
 
+   fInputVertices.clear();
+
    if (n == 0 || !x || !y || !z ) return; 
 
    if (xmin >= xmax) {
@@ -94,8 +105,11 @@ void Delaunay2D::SetInputPoints(int n, const double * x, const double * y, const
 
 
 #ifndef HAS_CGAL
+   fNCells       = 0;
    fXCellStep    = 0.;
    fYCellStep    = 0.;
+   fCellStart.clear();
+   fCellTriangles.clear();
 #endif
 }
 
@@ -123,6 +137,60 @@ double Delaunay2D::Interpolate(double x, double y)
    return zz;
 }
 
+//______________________________________________________________________________
+void Delaunay2D::Interpolate(int n, const double * x, const double * y, double * z)
+{
+   // Compute the z values corresponding to the n points (x[i],y[i]).
+   // The triangles are found only once for all points; the lookup of the
+   // points only reads them, so that chunks of points can be interpolated
+   // in parallel when implicit multi-threading is enabled.
+
+   FindAllTriangles();
+
+   const int kPointsPerTask = 1024;
+   auto interpolateChunk = [&](unsigned int ichunk) {
+      int first = ichunk * kPointsPerTask;
+      int last = std::min(first + kPointsPerTask, n);
+      for (int i = first; i < last; ++i) {
+         double xx = Linear_transform(x[i], fOffsetX, fScaleFactorX);
+         double yy = Linear_transform(y[i], fOffsetY, fScaleFactorY);
+         double zz = DoInterpolateNormalized(xx, yy);
+         // see Interpolate(double, double)
+         if (zz==0) zz = DoInterpolateNormalized(xx+0.0001, yy);
+         z[i] = zz;
+      }
+      return 0;
+   };
+   unsigned int nchunks = (n + kPointsPerTask - 1) / kPointsPerTask;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1) {
+      auto pool = ROOT::Internal::GetImplicitMTExecutor();
+      pool->Map(interpolateChunk, ROOT::TSeq<unsigned int>(nchunks));
+      return;
+   }
+#endif
+   for (unsigned int ichunk = 0; ichunk < nchunks; ++ichunk)
+      interpolateChunk(ichunk);
+}
+
+//______________________________________________________________________________
+void Delaunay2D::SetTriangles(const std::vector<UInt_t> & vertices)
+{
+   // Set the triangles from the indices of their vertices. They are ignored if
+   // the triangles have already been found, if they do not refer to the input
+   // points or if CGAL computes the triangulation.
+
+   fInputVertices.clear();
+#ifdef THREAD_SAFE
+   if (fInit != Initialization::UNINITIALIZED) return;
+#else
+   if (fInit) return;
+#endif
+   if (vertices.empty() || vertices.size() % 3 != 0) return;
+   if (*std::max_element(vertices.begin(), vertices.end()) >= UInt_t(fNpoints)) return;
+   fInputVertices = vertices;
+}
+
 //______________________________________________________________________________
 void Delaunay2D::FindAllTriangles()
 {
@@ -245,10 +313,6 @@ void Delaunay2D::DoNormalizePoints() {
       fXN.push_back(Linear_transform(fX[n], fOffsetX, fScaleFactorX));
       fYN.push_back(Linear_transform(fY[n], fOffsetY, fScaleFactorY));
    }
-
-   //also initialize fXCellStep and FYCellStep
-   fXCellStep = fNCells / (fXNmax - fXNmin);
-   fYCellStep = fNCells / (fYNmax - fYNmin);
 }
 
 /// Triangle implementation for finding all the triangles 
@@ -307,6 +371,13 @@ void Delaunay2D::DoFindTriangles() {
       if(s.normlist != nullptr) free(s.normlist);             /* Used only with Voronoi diagram; out only */
    };
 
+   // triangles given with SetTriangles: no need to compute the triangulation
+   if (!fInputVertices.empty()) {
+      DoBuildTriangles(fInputVertices);
+      std::vector<UInt_t>().swap(fInputVertices);
+      return;
+   }
+
    struct triangulateio in, out;
    initStruct(in); initStruct(out);
 
@@ -322,24 +393,49 @@ void Delaunay2D::DoFindTriangles() {
 
    triangulate((char *) "zQN", &in, &out, nullptr);
 
-   fTriangles.resize(out.numberoftriangles);
-   for(int t = 0; t < out.numberoftriangles; ++t){
-      Triangle tri;
+   //each triangle has numberofcorners vertices ( = 3)
+   std::vector<UInt_t> vertices(3 * out.numberoftriangles);
+   for(int t = 0; t < out.numberoftriangles; ++t)
+      for(int v = 0; v < 3; ++v)
+         vertices[3*t + v] = out.trianglelist[t*out.numberofcorners + v];
 
-      auto transform = [&] (const unsigned int v) {
-         //each triangle as numberofcorners vertices ( = 3)
-         tri.idx[v] = out.trianglelist[t*out.numberofcorners + v];
+   freeStruct(in); freeStruct(out);
+
+   DoBuildTriangles(vertices);
+}
 
-         //printf("triangle %u vertex %u: point %u/%i\n", t, v, tri.idx[v], out.numberofpoints);
+/// Triangle implementation for building the triangles and the localisation grid
+/// from the indices of the vertices of the triangles
+void Delaunay2D::DoBuildTriangles(const std::vector<UInt_t> & vertices) {
 
-         //pointlist is [x0 y0 x1 y1 ...]
-         tri.x[v] = in.pointlist[tri.idx[v] * 2 + 0];
+   const int ntriangles = vertices.size() / 3;
 
-         //printf("\t x: %f\n", tri.x[v]);
+   // size the localisation grid for about two triangles per cell, with a minimum
+   // of 25x25 cells and a maximum of 1024x1024 cells
+   fNCells = std::max(25, std::min(1024, int(std::sqrt(0.5 * ntriangles))));
+   fXCellStep = fNCells / (fXNmax - fXNmin);
+   fYCellStep = fNCells / (fYNmax - fYNmin);
 
-         tri.y[v] = in.pointlist[tri.idx[v] * 2 + 1];
+   // grid cells covered by the bounding box of triangle t
+   auto cellRange = [&] (const Triangle & tri, int & cellXmin, int & cellXmax, int & cellYmin, int & cellYmax) {
+      auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
+      auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
+
+      cellXmin = std::max(0, CellX(bx.first));
+      cellXmax = std::min(fNCells, CellX(bx.second));
+
+      cellYmin = std::max(0, CellY(by.first));
+      cellYmax = std::min(fNCells, CellY(by.second));
+   };
 
-         //printf("\t y: %f\n", tri.y[v]);
+   fTriangles.resize(ntriangles);
+   for(int t = 0; t < ntriangles; ++t){
+      Triangle tri;
+
+      auto transform = [&] (const unsigned int v) {
+         tri.idx[v] = vertices[3*t + v];
+         tri.x[v] = fXN[tri.idx[v]];
+         tri.y[v] = fYN[tri.idx[v]];
       };
 
       transform(0);
@@ -350,25 +446,29 @@ void Delaunay2D::DoFindTriangles() {
       tri.invDenom = 1 / ( (tri.y[1] - tri.y[2])*(tri.x[0] - tri.x[2]) + (tri.x[2] - tri.x[1])*(tri.y[0] - tri.y[2]) );
 
       fTriangles[t] = tri;
+   }
 
-      auto bx = std::minmax({tri.x[0], tri.x[1], tri.x[2]});
-      auto by = std::minmax({tri.y[0], tri.y[1], tri.y[2]});
-
-      unsigned int cellXmin = CellX(bx.first);
-      unsigned int cellXmax = CellX(bx.second);
-
-      unsigned int cellYmin = CellY(by.first);
-      unsigned int cellYmax = CellY(by.second);
-
-      for(unsigned int i = cellXmin; i <= cellXmax; ++i) {
-         for(unsigned int j = cellYmin; j <= cellYmax; ++j) {
+   // fill the grid in two passes: count the triangles of each cell, then store them
+   fCellStart.assign((fNCells+1)*(fNCells+1) + 1, 0);
+   int cellXmin, cellXmax, cellYmin, cellYmax;
+   for(const Triangle & tri : fTriangles) {
+      cellRange(tri, cellXmin, cellXmax, cellYmin, cellYmax);
+      for(int i = cellXmin; i <= cellXmax; ++i)
+         for(int j = cellYmin; j <= cellYmax; ++j)
+            ++fCellStart[Cell(i,j) + 1];
+   }
+   for(unsigned int c = 1; c < fCellStart.size(); ++c)
+      fCellStart[c] += fCellStart[c-1];
+
+   fCellTriangles.resize(fCellStart.back());
+   std::vector<UInt_t> next(fCellStart.begin(), fCellStart.end() - 1);
+   for(unsigned int t = 0; t < fTriangles.size(); ++t) {
+      cellRange(fTriangles[t], cellXmin, cellXmax, cellYmin, cellYmax);
+      for(int i = cellXmin; i <= cellXmax; ++i)
+         for(int j = cellYmin; j <= cellYmax; ++j)
             //printf("(%u,%u) = %u\n", i, j, Cell(i,j));
-            fCells[Cell(i,j)].insert(t);
-         }
-      }
+            fCellTriangles[next[Cell(i,j)]++] = t;
    }
-
-   freeStruct(in); freeStruct(out);
 }
 
 /// Triangle implementation for interpolation
@@ -398,10 +498,12 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
    int cX = CellX(xx);
    int cY = CellY(yy);
 
-   if(cX < 0 || cX > fNCells || cY < 0 || cY > fNCells)
+   if(cX < 0 || cX > fNCells || cY < 0 || cY > fNCells || fCellStart.empty())
       return fZout; //TODO some more fancy interpolation here
 
-    for(unsigned int t : fCells[Cell(cX, cY)]){
+    const unsigned int cell = Cell(cX, cY);
+    for(unsigned int i = fCellStart[cell]; i < fCellStart[cell+1]; ++i){
+       const unsigned int t = fCellTriangles[i];
        auto coords = bayCoords(t);
 
        if(inTriangle(coords)){
@@ -424,14 +526,14 @@ double Delaunay2D::DoInterpolateNormalized(double xx, double yy)
           //brute force found a triangle -> grid not
           printf("Found triangle %u for (%f,%f) -> (%u,%u)\n", t, xx,yy, cX, cY);
           printf("Triangles in grid cell: ");
-          for(unsigned int x : fCells[Cell(cX, cY)])
-             printf("%u ", x);
+          for(unsigned int i = fCellStart[cell]; i < fCellStart[cell+1]; ++i)
+             printf("%u ", fCellTriangles[i]);
           printf("\n");
 
           printf("Triangle %u is in cells: ", t);
           for(unsigned int i = 0; i <= fNCells; ++i)
              for(unsigned int j = 0; j <= fNCells; ++j)
-                if(fCells[Cell(i,j)].count(t))
+                if(std::count(fCellTriangles.begin() + fCellStart[Cell(i,j)], fCellTriangles.begin() + fCellStart[Cell(i,j)+1], t))
                    printf("(%u,%u) ", i, j);
           printf("\n");
           for(unsigned int i = 0; i < 3; ++i)
@@ -211,13 +211,15 @@ void FitResult::FillResult(const std::shared_ptr<ROOT::Math::Minimizer> & min, c
 
       // minos errors
       if (fValid && fconfig.MinosErrors()) {
-         const std::vector<unsigned int> & ipars = fconfig.MinosParams();
-         unsigned int n = (ipars.size() > 0) ? ipars.size() : npar;
-         for (unsigned int i = 0; i < n; ++i) {
-          double elow, eup;
-          unsigned int index = (ipars.size() > 0) ? ipars[i] : i;
-          bool ret = min->GetMinosError(index, elow, eup);
-          if (ret) SetMinosError(index, elow, eup);
+         std::vector<unsigned int> ipars = fconfig.MinosParams();
+         if (ipars.empty()) {
+            for (unsigned int i = 0; i < npar; ++i) ipars.push_back(i);
+         }
+         std::vector<double> elow, eup;
+         std::vector<bool> valid;
+         min->GetMinosErrors(ipars, elow, eup, valid);
+         for (unsigned int i = 0; i < ipars.size(); ++i) {
+            if (valid[i]) SetMinosError(ipars[i], elow[i], eup[i]);
          }
       }
 
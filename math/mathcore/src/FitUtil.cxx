@@ -34,6 +34,11 @@
 #include <algorithm>
 //#include <memory>
 
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
 //#define DEBUG
 #ifdef DEBUG
 #define NSAMPLE 10
@@ -327,15 +332,111 @@ namespace ROOT {
 
 
 
-      } // end namespace  FitUtil
 
+         // number of points evaluated with a single call to the array interface of the model function
+         const unsigned int kEvalBlockSize = 256;
+
+         // evaluate the model function for the points [begin, begin+n) of the data set with a single call
+         // to IModelFunction::EvalPar. The coordinates are copied in SoA layout in xblock.
+         // If useBinCenter the function is evaluated at the bin centers
+         void EvaluateModelBlock(const IModelFunction & func, const BinData & data, const double * p,
+                                 unsigned int begin, unsigned int n, bool useBinCenter,
+                                 std::vector<double> & xblock, double * fval) {
+            const unsigned int ndim = data.NDim();
+            xblock.resize(ndim*n);
+            data.GetCoordsSoA(begin, n, xblock.data() );
+            if (useBinCenter) {
+               for (unsigned int j = 0; j < n; ++j) {
+                  const double * x2 = data.BinUpEdge(begin + j);
+                  for (unsigned int k = 0; k < ndim; ++k)
+                     xblock[k*n + j] = 0.5*(x2[k] + xblock[k*n + j]);
+               }
+            }
+#ifdef USE_PARAMCACHE
+            (void) p;
+            func.EvalPar(n, xblock.data(), 0, fval);  // use the cached parameter values
+#else
+            func.EvalPar(n, xblock.data(), p, fval);
+#endif
+         }
+
+         void EvaluateModelBlock(const IModelFunction & func, const UnBinData & data, const double * p,
+                                 unsigned int begin, unsigned int n,
+                                 std::vector<double> & xblock, double * fval) {
+            xblock.resize(data.NDim()*n);
+            data.GetCoordsSoA(begin, n, xblock.data() );
+#ifdef USE_PARAMCACHE
+            (void) p;
+            func.EvalPar(n, xblock.data(), 0, fval);  // use the cached parameter values
+#else
+            func.EvalPar(n, xblock.data(), p, fval);
+#endif
+         }
+
+         // partial result of the unbinned log-likelihood on a chunk of data points
+         struct LogLChunkResult {
+            double logl = 0;
+            double sumW = 0;   // needed for the extended weighted likelihood
+            double sumW2 = 0;
+            LogLChunkResult & operator+=(const LogLChunkResult & rhs) {
+               logl += rhs.logl; sumW += rhs.sumW; sumW2 += rhs.sumW2;
+               return *this;
+            }
+         };
+
+         // partial result of the Poisson log-likelihood on a chunk of bins
+         struct PoissonLogLChunkResult {
+            double nloglike = 0;
+            unsigned int nPoints = 0;
+            PoissonLogLChunkResult & operator+=(const PoissonLogLChunkResult & rhs) {
+               nloglike += rhs.nloglike; nPoints += rhs.nPoints;
+               return *this;
+            }
+         };
+
+         // evaluate a sum over the data points [0,n) by calling mapChunk(begin,end) on chunks of points.
+         // With the multithread policy the chunks are processed by the ROOT thread pool and the partial
+         // results are then added always in the same order. When not given the number of chunks depends
+         // only on n, so the result is reproducible and independent of the number of threads
+         template <class Result, class MapChunk>
+         Result EvaluateChunks(const MapChunk & mapChunk, unsigned int n, ROOT::Fit::ExecutionPolicy executionPolicy, unsigned nChunks) {
+            if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+#ifdef R__USE_IMT
+               // use at least ~1000 points per chunk
+               if (nChunks == 0) nChunks = std::min(64u, std::max(1u, n/1000));
+               nChunks = std::min(nChunks, n);
+               if (nChunks > 1) {
+                  auto chunkResult = [&](unsigned ichunk) {
+                     unsigned int begin = (unsigned long long) n * ichunk / nChunks;
+                     unsigned int end = (unsigned long long) n * (ichunk + 1) / nChunks;
+                     return mapChunk(begin, end);
+                  };
+                  std::vector<Result> results = ROOT::Internal::GetImplicitMTExecutor()->Map(chunkResult, ROOT::TSeq<unsigned>(nChunks));
+                  Result result = results[0];
+                  for (unsigned int ichunk = 1; ichunk < nChunks; ++ichunk)
+                     result += results[ichunk];
+                  return result;
+               }
+#else
+               static bool warn = true;
+               if (warn) {
+                  MATH_WARN_MSG("FitUtil::EvaluateChunks","Multithread execution policy requires ROOT built with imt support - use serial evaluation");
+                  warn = false;
+               }
+#endif
+            }
+            return mapChunk(0, n);
+         }
+
+      } // end namespace  FitUtil
 
 
 //___________________________________________________________________________________________________________________________
 // for chi2 functions
 //___________________________________________________________________________________________________________________________
 
-double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {
+double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints,
+                             ROOT::Fit::ExecutionPolicy executionPolicy, unsigned nChunks) {
    // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints
    // the actual number of used points
    // normal chi2 using only error on values (from fitting histogram)
@@ -343,7 +444,6 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
    unsigned int n = data.Size();
 
-   double chi2 = 0;
    nPoints = 0; // count the effective non-zero points
    // set parameters of the function to cache integral value
 #ifdef USE_PARAMCACHE
@@ -367,97 +467,105 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
    std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
 #endif
 
-#ifdef USE_PARAMCACHE
-   IntegralEvaluator<> igEval( func, 0, useBinIntegral); 
-#else
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
-#endif
    double maxResValue = std::numeric_limits<double>::max() /n;
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
-   for (unsigned int i = 0; i < n; ++ i) {
 
-      double y = 0, invError = 1.;
+   // evaluate the chi2 contribution of the points in [begin,end)
+   // integral evaluator and work space are local to allow evaluating the chunks in parallel
+   auto mapChunk = [&](unsigned int begin, unsigned int end) {
+#ifdef USE_PARAMCACHE
+      IntegralEvaluator<> igEval( func, 0, useBinIntegral);
+#else
+      IntegralEvaluator<> igEval( func, p, useBinIntegral);
+#endif
+      // function values for a block of points [blockBegin, blockEnd)
+      std::vector<double> xblock;
+      double fblock[kEvalBlockSize];
+      unsigned int blockBegin = begin, blockEnd = begin;
 
-      // in case of no error in y invError=1 is returned
-      const double * x1 = data.GetPoint(i,y, invError);
+      double chi2 = 0;
+      for (unsigned int i = begin; i < end; ++ i) {
 
-      double fval = 0;
+         double y = 0, invError = 1.;
 
-      double binVolume = 1.0;
-        if (useBinVolume) {
-         unsigned int ndim = data.NDim();
-         const double * x2 = data.BinUpEdge(i);
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
+         // in case of no error in y invError=1 is returned
+         const double * x1 = data.GetPoint(i,y, invError);
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+         double fval = 0;
 
-      if (!useBinIntegral) {
-#ifdef USE_PARAMCACHE
-         fval = func ( x );
-#else
-         fval = func ( x, p );
-#endif
-      }
-      else {
-         // calculate integral normalized by bin volume
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ;
-      }
-      // normalize result if requested according to bin volume
-      if (useBinVolume) fval *= binVolume;
+         double binVolume = 1.0;
+           if (useBinVolume) {
+            unsigned int ndim = data.NDim();
+            const double * x2 = data.BinUpEdge(i);
+            for (unsigned int j = 0; j < ndim; ++j)
+               binVolume *= std::abs( x2[j]-x1[j] );
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
+         }
 
-      // expected errors
-      if (useExpErrors) {
-         // we need first to check if a weight factor needs to be applied
-         // weight = sumw2/sumw = error**2/content
-         double invWeight = y * invError * invError;
-         if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
-         // compute expected error  as f(x) / weight
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
-         invError = std::sqrt(invError2);
-      }
+         if (!useBinIntegral) {
+            if (i == blockEnd) {
+               blockBegin = i;
+               blockEnd = std::min(i + kEvalBlockSize, end);
+               EvaluateModelBlock(func, data, p, blockBegin, blockEnd - blockBegin, useBinVolume, xblock, fblock);
+            }
+            fval = fblock[i - blockBegin];
+         }
+         else {
+            // calculate integral normalized by bin volume
+            // need to set function and parameters here in case loop is parallelized
+            fval = igEval( x1, data.BinUpEdge(i)) ;
+         }
+         // normalize result if requested according to bin volume
+         if (useBinVolume) fval *= binVolume;
+
+         // expected errors
+         if (useExpErrors) {
+            // we need first to check if a weight factor needs to be applied
+            // weight = sumw2/sumw = error**2/content
+            double invWeight = y * invError * invError;
+            if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
+            // compute expected error  as f(x) / weight
+            double invError2 = (fval > 0) ? invWeight / fval : 0.0;
+            invError = std::sqrt(invError2);
+         }
 
 //#define DEBUG
 #ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
+         std::cout << x1[0] << "  " << y << "  " << 1./invError << " params : ";
+         for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
+            std::cout << p[ipar] << "\t";
+         std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
 #endif
 //#undef DEBUG
 
 
-      if (invError > 0) {
-         nPoints++;
+         if (invError > 0) {
 
-         double tmp = ( y -fval )* invError;
-         double resval = tmp * tmp;
+            double tmp = ( y -fval )* invError;
+            double resval = tmp * tmp;
 
 
-         // avoid inifinity or nan in chi2 values due to wrong function values
-         if ( resval < maxResValue )
-            chi2 += resval;
-         else {
-            //nRejected++;
-            chi2 += maxResValue;
+            // avoid inifinity or nan in chi2 values due to wrong function values
+            if ( resval < maxResValue )
+               chi2 += resval;
+            else {
+               //nRejected++;
+               chi2 += maxResValue;
+            }
          }
-      }
 
 
-   }
+      }
+      return chi2;
+   };
+
+   double chi2 = EvaluateChunks<double>(mapChunk, n, executionPolicy, nChunks);
    nPoints=n;
 
 #ifdef DEBUG
@@ -891,7 +999,8 @@ double FitUtil::EvaluatePdf(const IModelFunction & func, const UnBinData & data,
 }
 
 double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * p,
-                                   int iWeight,  bool extended, unsigned int &nPoints) {
+                                   int iWeight,  bool extended, unsigned int &nPoints,
+                                   ROOT::Fit::ExecutionPolicy executionPolicy, unsigned nChunks) {
    // evaluate the LogLikelihood
 
    unsigned int n = data.Size();
@@ -936,48 +1045,60 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
       }
    }
 
-   // needed to compue effective global weight in case of extended likelihood
-   double sumW = 0;
-   double sumW2 = 0;
-
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x = data.Coords(i);
-#ifdef USE_PARAMCACHE
-       double fval = func ( x );
-#else
-       double fval = func ( x, p );
-#endif
-      if (normalizeFunc) fval = fval / norm;
+   // evaluate the log-likelihood of the points in [begin,end)
+   // needed also sum of weights to compute effective global weight in case of extended likelihood
+   auto mapChunk = [&](unsigned int begin, unsigned int end) {
+      // function values for a block of points [blockBegin, blockEnd)
+      std::vector<double> xblock;
+      double fblock[kEvalBlockSize];
+      unsigned int blockBegin = begin, blockEnd = begin;
+
+      LogLChunkResult res;
+      for (unsigned int i = begin; i < end; ++ i) {
+         if (i == blockEnd) {
+            blockBegin = i;
+            blockEnd = std::min(i + kEvalBlockSize, end);
+            EvaluateModelBlock(func, data, p, blockBegin, blockEnd - blockBegin, xblock, fblock);
+         }
+         double fval = fblock[i - blockBegin];
+         if (normalizeFunc) fval = fval / norm;
 
 #ifdef DEBUG
-      if (i == 0) { 
-         std::cout << "x [ " << data.NDim() << " ] = ";
-         for (unsigned int j = 0; j < data.NDim(); ++j)
-            std::cout << x[j] << "\t";
-         std::cout << "\tpar = [ " << func.NPar() << " ] =  ";
-         for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-            std::cout << p[ipar] << "\t";
-         std::cout << "\tfval = " << fval << std::endl;
-      } else {
-         std::cout << ".";
-      }
+         if (i == 0) { 
+            std::cout << "x [ " << data.NDim() << " ] = ";
+            for (unsigned int j = 0; j < data.NDim(); ++j)
+               std::cout << data.Coords(i)[j] << "\t";
+            std::cout << "\tpar = [ " << func.NPar() << " ] =  ";
+            for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
+               std::cout << p[ipar] << "\t";
+            std::cout << "\tfval = " << fval << std::endl;
+         } else {
+            std::cout << ".";
+         }
 #endif
-      // function EvalLog protects against negative or too small values of fval
-      double logval =  ROOT::Math::Util::EvalLog( fval);
-      if (iWeight > 0) {
-         double weight = data.Weight(i);
-         logval *= weight;
-         if (iWeight ==2) {
-            logval *= weight; // use square of weights in likelihood
-            if (extended) {
-               // needed sum of weights and sum of weight square if likelkihood is extended
-               sumW += weight;
-               sumW2 += weight*weight;
+         // function EvalLog protects against negative or too small values of fval
+         double logval =  ROOT::Math::Util::EvalLog( fval);
+         if (iWeight > 0) {
+            double weight = data.Weight(i);
+            logval *= weight;
+            if (iWeight ==2) {
+               logval *= weight; // use square of weights in likelihood
+               if (extended) {
+                  // needed sum of weights and sum of weight square if likelkihood is extended
+                  res.sumW += weight;
+                  res.sumW2 += weight*weight;
+               }
             }
          }
+         res.logl += logval;
       }
-      logl += logval;
-   }
+      return res;
+   };
+
+   LogLChunkResult result = EvaluateChunks<LogLChunkResult>(mapChunk, n, executionPolicy, nChunks);
+   logl = result.logl;
+   double sumW = result.sumW;
+   double sumW2 = result.sumW2;
 
 #ifdef DEBUG
    std::cout << std::endl;
@@ -1207,7 +1328,8 @@ double FitUtil::EvaluatePoissonBinPdf(const IModelFunction & func, const BinData
 }
 
 double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData & data,
-                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints ) {
+                                    const double * p, int iWeight, bool extended,  unsigned int &   nPoints,
+                                    ROOT::Fit::ExecutionPolicy executionPolicy, unsigned nChunks) {
    // evaluate the Poisson Log Likelihood
    // for binned likelihood fits
    // this is Sum ( f(x_i)  -  y_i * log( f (x_i) ) )
@@ -1243,10 +1365,8 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
    
    // normalize if needed by a reference volume value
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
 #ifdef DEBUG
@@ -1256,112 +1376,123 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
              << useBinVolume << " useW2 " << useW2 << " wrefVolume = " << wrefVolume << std::endl;
 #endif
 
-#ifdef USE_PARAMCACHE
-   IntegralEvaluator<> igEval( func, 0, useBinIntegral); 
-#else
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
-#endif
    // double nuTot = 0; // total number of expected events (needed for non-extended fits)
    // double wTot = 0; // sum of all weights
    // double w2Tot = 0; // sum of weight squared  (these are needed for useW2)
 
-
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-
-      double fval = 0;
-      double binVolume = 1.0;
-
-      if (useBinVolume) {
-         unsigned int ndim = data.NDim();
-         const double * x2 = data.BinUpEdge(i);
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
-         }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
-
-      const double * x = (useBinVolume) ? &xc.front() : x1;
-
-      if (!useBinIntegral) {
+   // evaluate the log-likelihood of the bins in [begin,end)
+   // integral evaluator and work space are local to allow evaluating the chunks in parallel
+   auto mapChunk = [&](unsigned int begin, unsigned int end) {
 #ifdef USE_PARAMCACHE
-         fval = func ( x );
+      IntegralEvaluator<> igEval( func, 0, useBinIntegral);
 #else
-         fval = func ( x, p );
+      IntegralEvaluator<> igEval( func, p, useBinIntegral);
 #endif
-      }
-      else {
-         // calculate integral (normalized by bin volume)
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, data.BinUpEdge(i)) ;
-      }
-      if (useBinVolume) fval *= binVolume;
+      // function values for a block of points [blockBegin, blockEnd)
+      std::vector<double> xblock;
+      double fblock[kEvalBlockSize];
+      unsigned int blockBegin = begin, blockEnd = begin;
+
+      PoissonLogLChunkResult res;
+      for (unsigned int i = begin; i < end; ++ i) {
+         const double * x1 = data.Coords(i);
+         double y = data.Value(i);
+
+         double fval = 0;
+         double binVolume = 1.0;
+
+         if (useBinVolume) {
+            unsigned int ndim = data.NDim();
+            const double * x2 = data.BinUpEdge(i);
+            for (unsigned int j = 0; j < ndim; ++j)
+               binVolume *= std::abs( x2[j]-x1[j] );
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
+         }
+
+         if (!useBinIntegral) {
+            if (i == blockEnd) {
+               blockBegin = i;
+               blockEnd = std::min(i + kEvalBlockSize, end);
+               EvaluateModelBlock(func, data, p, blockBegin, blockEnd - blockBegin, useBinVolume, xblock, fblock);
+            }
+            fval = fblock[i - blockBegin];
+         }
+         else {
+            // calculate integral (normalized by bin volume)
+            // need to set function and parameters here in case loop is parallelized
+            fval = igEval( x1, data.BinUpEdge(i)) ;
+         }
+         if (useBinVolume) fval *= binVolume;
 
 
 
 #ifdef DEBUG
-      int NSAMPLE = 100;
-      if (i%NSAMPLE == 0) {
-         std::cout << "evt " << i << " x1 = [ ";
-         for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x[j] << " , ";
-         std::cout << "]  ";
-         if (fitOpt.fIntegral) {
-            std::cout << "x2 = [ ";
-            for (unsigned int j=0; j < func.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
-            std::cout << "] ";
+         int NSAMPLE = 100;
+         if (i%NSAMPLE == 0) {
+            std::cout << "evt " << i << " x1 = [ ";
+            for (unsigned int j=0; j < func.NDim(); ++j) std::cout << x1[j] << " , ";
+            std::cout << "]  ";
+            if (fitOpt.fIntegral) {
+               std::cout << "x2 = [ ";
+               for (unsigned int j=0; j < func.NDim(); ++j) std::cout << data.BinUpEdge(i)[j] << " , ";
+               std::cout << "] ";
+            }
+            std::cout << "  y = " << y << " fval = " << fval << std::endl;
          }
-         std::cout << "  y = " << y << " fval = " << fval << std::endl;
-      }
 #endif
 
 
-      // EvalLog protects against 0 values of fval but don't want to add in the -log sum
-      // negative values of fval
-      fval = std::max(fval, 0.0);
-
-
-      double tmp = 0;
-      if (useW2) {
-         // apply weight correction . Effective weight is error^2/ y
-         // and expected events in bins is fval/weight
-         // can apply correction only when y is not zero otherwise weight is undefined
-         // (in case of weighted likelihood I don't care about the constant term due to
-         // the saturated model)
-         if (y != 0) {
-            double error = data.Error(i);
-            double weight = (error*error)/y;  // this is the bin effective weight
-            if (extended) {
-               tmp = fval * weight;
-               // wTot  += weight;
-               // w2Tot += weight*weight;
+         // EvalLog protects against 0 values of fval but don't want to add in the -log sum
+         // negative values of fval
+         fval = std::max(fval, 0.0);
+
+
+         double tmp = 0;
+         if (useW2) {
+            // apply weight correction . Effective weight is error^2/ y
+            // and expected events in bins is fval/weight
+            // can apply correction only when y is not zero otherwise weight is undefined
+            // (in case of weighted likelihood I don't care about the constant term due to
+            // the saturated model)
+            if (y != 0) {
+               double error = data.Error(i);
+               double weight = (error*error)/y;  // this is the bin effective weight
+               if (extended) {
+                  tmp = fval * weight;
+                  // wTot  += weight;
+                  // w2Tot += weight*weight;
+               }
+               tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
             }
-            tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
-         }
 
-         //  need to compute total weight and weight-square
-         // if (extended ) {
-         //    nuTot += fval;
-         // }
+            //  need to compute total weight and weight-square
+            // if (extended ) {
+            //    nuTot += fval;
+            // }
 
-      }
-      else {
-         // standard case no weights or iWeight=1
-         // this is needed for Poisson likelihood (which are extened and not for multinomial)
-         // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
-         // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
-         if (extended) tmp = fval -y ;
-         if (y >  0) {
-            tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));
-            nPoints++;
          }
-      }
+         else {
+            // standard case no weights or iWeight=1
+            // this is needed for Poisson likelihood (which are extened and not for multinomial)
+            // the formula below  include constant term due to likelihood of saturated model (f(x) = y)
+            // (same formula as in Baker-Cousins paper, page 439 except a factor of 2
+            if (extended) tmp = fval -y ;
+            if (y >  0) {
+               tmp +=  y *  (ROOT::Math::Util::EvalLog( y) - ROOT::Math::Util::EvalLog(fval));
+               res.nPoints++;
+            }
+         }
 
 
-      nloglike +=  tmp;
-   }
+         res.nloglike +=  tmp;
+      }
+      return res;
+   };
+
+   PoissonLogLChunkResult result = EvaluateChunks<PoissonLogLChunkResult>(mapChunk, n, executionPolicy, nChunks);
+   nloglike = result.nloglike;
+   nPoints = result.nPoints;
 
    // if (notExtended) {
    //    // not extended : remove from the Likelihood the global Poisson term
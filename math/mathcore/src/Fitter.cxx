@@ -325,7 +325,7 @@ bool Fitter::EvalFCN() {
 }
 
 
-bool Fitter::DoLeastSquareFit() {
+bool Fitter::DoLeastSquareFit(const ROOT::Fit::ExecutionPolicy &executionPolicy) {
    
    // perform a chi2 fit on a set of binned data
    std::shared_ptr<BinData> data = std::dynamic_pointer_cast<BinData>(fData);
@@ -347,7 +347,7 @@ bool Fitter::DoLeastSquareFit() {
    // check if fFunc provides gradient
    if (!fUseGradient) {
       // do minimzation without using the gradient
-      Chi2FCN<BaseFunc> chi2(data,fFunc);
+      Chi2FCN<BaseFunc> chi2(data,fFunc,executionPolicy);
       fFitType = chi2.Type();
       return DoMinimization (chi2);
    }
@@ -357,7 +357,7 @@ bool Fitter::DoLeastSquareFit() {
          MATH_INFO_MSG("Fitter::DoLeastSquareFit","use gradient from model function");
       std::shared_ptr<IGradModelFunction> gradFun = std::dynamic_pointer_cast<IGradModelFunction>(fFunc);
       if (gradFun) {
-         Chi2FCN<BaseGradFunc> chi2(data,gradFun);
+         Chi2FCN<BaseGradFunc> chi2(data,gradFun,executionPolicy);
          fFitType = chi2.Type();
          return DoMinimization (chi2);
       }
@@ -366,7 +366,7 @@ bool Fitter::DoLeastSquareFit() {
    return false;
 }
 
-bool Fitter::DoBinnedLikelihoodFit(bool extended) {
+bool Fitter::DoBinnedLikelihoodFit(bool extended, const ROOT::Fit::ExecutionPolicy &executionPolicy) {
    // perform a likelihood fit on a set of binned data
    // The fit is extended (Poisson logl_ by default
 
@@ -396,11 +396,11 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
    fDataSize = data->Size();
 
    // create a chi2 function to be used for the equivalent chi-square
-   Chi2FCN<BaseFunc> chi2(data,fFunc);
+   Chi2FCN<BaseFunc> chi2(data,fFunc,executionPolicy);
 
    if (!fUseGradient) {
       // do minimization without using the gradient
-      PoissonLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended);
+      PoissonLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended, executionPolicy);
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -423,7 +423,7 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
       if (!extended) {
          MATH_WARN_MSG("Fitter::DoBinnedLikelihoodFit","Not-extended binned fit with gradient not yet supported - do an extended fit");
       }
-      PoissonLikelihoodFCN<BaseGradFunc> logl(data,gradFun, useWeight, true);
+      PoissonLikelihoodFCN<BaseGradFunc> logl(data,gradFun, useWeight, true, executionPolicy);
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -436,7 +436,7 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
 }
 
 
-bool Fitter::DoUnbinnedLikelihoodFit(bool extended) {
+bool Fitter::DoUnbinnedLikelihoodFit(bool extended, const ROOT::Fit::ExecutionPolicy &executionPolicy) {
    // perform a likelihood fit on a set of unbinned data
 
    std::shared_ptr<UnBinData> data = std::dynamic_pointer_cast<UnBinData>(fData);
@@ -470,7 +470,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended) {
 
    if (!fUseGradient) {
       // do minimization without using the gradient
-      LogLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended);
+      LogLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended, executionPolicy);
       fFitType = logl.Type();
       if (!DoMinimization (logl) ) return false;
       if (useWeight) {
@@ -488,7 +488,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended) {
          if (extended) {
             MATH_WARN_MSG("Fitter::DoUnbinnedLikelihoodFit","Extended unbinned fit with gradient not yet supported - do a not-extended fit");
          }
-         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended);
+         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended, executionPolicy);
          fFitType = logl.Type();
          if (!DoMinimization (logl) ) return false;
          if (useWeight) {
@@ -623,15 +623,16 @@ bool Fitter::CalculateMinosErrors() {
    fConfig.SetMinosErrors(false);
 
 
-   const std::vector<unsigned int> & ipars = fConfig.MinosParams();
-   unsigned int n = (ipars.size() > 0) ? ipars.size() : fResult->Parameters().size();
-   bool ok = false;
-   for (unsigned int i = 0; i < n; ++i) {
-      double elow, eup;
-      unsigned int index = (ipars.size() > 0) ? ipars[i] : i;
-      bool ret = fMinimizer->GetMinosError(index, elow, eup);
-      if (ret) fResult->SetMinosError(index, elow, eup);
-      ok |= ret;
+   // compute the errors of all the requested parameters together
+   std::vector<unsigned int> ipars = fConfig.MinosParams();
+   if (ipars.empty()) {
+      for (unsigned int i = 0; i < fResult->Parameters().size(); ++i) ipars.push_back(i);
+   }
+   std::vector<double> elow, eup;
+   std::vector<bool> valid;
+   bool ok = fMinimizer->GetMinosErrors(ipars, elow, eup, valid);
+   for (unsigned int i = 0; i < ipars.size(); ++i) {
+      if (valid[i]) fResult->SetMinosError(ipars[i], elow[i], eup[i]);
    }
    if (!ok)
        MATH_ERROR_MSG("Fitter::CalculateMinosErrors","Minos error calculation failed for all parameters");
@@ -57,6 +57,7 @@ namespace ROOT {
       int Counter() { return -1; }
       void SetCounter(int) {}
       void Iterate() {} 
+      void FillFromState(int, double *) {}
    };
 
 
@@ -111,6 +112,14 @@ public:
    static int Size()  {
       return rng_get_N(); 
    }
+   // convert the next n numbers of the current state, starting from the counter
+   // position, without iterating. The caller must ensure counter + n <= N
+   void FillFromState(int n, double * array) {
+      const myuint * v = fRngState->V + fRngState->counter;
+      for (int i = 0; i < n; ++i)
+         array[i] = (int64_t)v[i] * (double)(INV_MERSBASE);
+      fRngState->counter += n;
+   }
 
    // to silent some warning
    void RndmArray(int n, double * array) {
@@ -12,6 +12,7 @@
 
 #include "Math/Math.h"
 #include "Math/SpecFuncMathCore.h"
+#include "SpecFuncVectorizable.h"
 #include <limits>
 
 
@@ -111,6 +112,35 @@ namespace Math {
          return AA * std::pow(arg,n);
       }
    }
+   void crystalball_function_array(unsigned int npoints, const double * x, double * result, double alpha, double n, double sigma, double mean) {
+      // evaluate the crystal ball function for an array of values.
+      // The parameter dependent quantities are computed only once. The gaussian core is
+      // computed for all the values with a vectorizable exp, and then replaced by the power
+      // law tail for the values in it
+      if (sigma < 0.) {
+         for (unsigned int i = 0; i < npoints; ++i) result[i] = 0.;
+         return;
+      }
+      using namespace Vectorizable;
+      const double sign = (alpha < 0) ? -1. : 1.;
+      const double abs_alpha = std::abs(alpha);
+      const double nDivAlpha = n/abs_alpha;
+      const double AA =  std::exp(-0.5*abs_alpha*abs_alpha);
+      const double B = nDivAlpha -abs_alpha;
+      ApplyInBlocks(npoints, x, result, [&](const double * in, double * out) {
+         double z[kBlockSize], t[kBlockSize];
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            z[i] = sign * ((in[i] - mean)/sigma);
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            t[i] = - 0.5 * z[i] * z[i];
+         Vectorizable::exp(t, out);
+         for (unsigned int i = 0; i < kBlockSize; ++i) {
+            if (!(z[i] > - abs_alpha))
+               out[i] = AA * std::pow(nDivAlpha/(B-z[i]),n);
+         }
+      });
+   }
+
    double crystalball_pdf(double x, double alpha, double n, double sigma, double mean) {
       // evaluation of the PDF ( is defined only for n >1)
       if (sigma < 0.)     return 0.;
@@ -172,6 +202,39 @@ namespace Math {
 
 
 
+   void gamma_pdf_array(unsigned int npoints, const double * x, double * result, double alpha, double theta, double x0) {
+      // lgamma(alpha) is computed only once for all the values
+      using namespace Vectorizable;
+      const double lgam = (alpha == 1) ? 0 : ROOT::Math::lgamma(alpha);
+      ApplyInBlocks(npoints, x, result, [&](const double * in, double * out) {
+         double d[kBlockSize], y[kBlockSize], t[kBlockSize];
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            d[i] = in[i] - x0;
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            y[i] = d[i]/theta;
+         if (alpha == 1) {
+            for (unsigned int i = 0; i < kBlockSize; ++i)
+               t[i] = -y[i];
+         } else {
+            Vectorizable::log(y, t);
+            for (unsigned int i = 0; i < kBlockSize; ++i)
+               t[i] = (alpha - 1) * t[i] - y[i] - lgam;
+         }
+         Vectorizable::exp(t, out);
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            out[i] /= theta;
+         // the density is 0 for x < x0, and for x = x0 when alpha != 1
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            out[i] = (d[i] < 0) ? 0.0 : out[i];
+         if (alpha != 1) {
+            for (unsigned int i = 0; i < kBlockSize; ++i)
+               out[i] = (d[i] == 0) ? 0.0 : out[i];
+         }
+      });
+   }
+
+
+
    double gaussian_pdf(double x, double sigma, double x0) {
 
       double tmp = (x-x0)/sigma;
@@ -188,34 +251,32 @@ namespace Math {
    }
 
 
-   double landau_pdf(double x, double xi, double x0) {
-      // LANDAU pdf : algorithm from CERNLIB G110 denlan
-      // same algorithm is used in GSL
+   // Landau density for xi = 1 and x0 = 0 : algorithm from CERNLIB G110 denlan
+   // same algorithm is used in GSL
+   static inline double landau_denlan(double v) {
 
-      static double p1[5] = {0.4259894875,-0.1249762550, 0.03984243700, -0.006298287635,   0.001511162253};
-      static double q1[5] = {1.0         ,-0.3388260629, 0.09594393323, -0.01608042283,    0.003778942063};
+      static const double p1[5] = {0.4259894875,-0.1249762550, 0.03984243700, -0.006298287635,   0.001511162253};
+      static const double q1[5] = {1.0         ,-0.3388260629, 0.09594393323, -0.01608042283,    0.003778942063};
 
-      static double p2[5] = {0.1788541609, 0.1173957403, 0.01488850518, -0.001394989411,   0.0001283617211};
-      static double q2[5] = {1.0         , 0.7428795082, 0.3153932961,   0.06694219548,    0.008790609714};
+      static const double p2[5] = {0.1788541609, 0.1173957403, 0.01488850518, -0.001394989411,   0.0001283617211};
+      static const double q2[5] = {1.0         , 0.7428795082, 0.3153932961,   0.06694219548,    0.008790609714};
 
-      static double p3[5] = {0.1788544503, 0.09359161662,0.006325387654, 0.00006611667319,-0.000002031049101};
-      static double q3[5] = {1.0         , 0.6097809921, 0.2560616665,   0.04746722384,    0.006957301675};
+      static const double p3[5] = {0.1788544503, 0.09359161662,0.006325387654, 0.00006611667319,-0.000002031049101};
+      static const double q3[5] = {1.0         , 0.6097809921, 0.2560616665,   0.04746722384,    0.006957301675};
 
-      static double p4[5] = {0.9874054407, 118.6723273,  849.2794360,   -743.7792444,      427.0262186};
-      static double q4[5] = {1.0         , 106.8615961,  337.6496214,    2016.712389,      1597.063511};
+      static const double p4[5] = {0.9874054407, 118.6723273,  849.2794360,   -743.7792444,      427.0262186};
+      static const double q4[5] = {1.0         , 106.8615961,  337.6496214,    2016.712389,      1597.063511};
 
-      static double p5[5] = {1.003675074,  167.5702434,  4789.711289,    21217.86767,     -22324.94910};
-      static double q5[5] = {1.0         , 156.9424537,  3745.310488,    9834.698876,      66924.28357};
+      static const double p5[5] = {1.003675074,  167.5702434,  4789.711289,    21217.86767,     -22324.94910};
+      static const double q5[5] = {1.0         , 156.9424537,  3745.310488,    9834.698876,      66924.28357};
 
-      static double p6[5] = {1.000827619,  664.9143136,  62972.92665,    475554.6998,     -5743609.109};
-      static double q6[5] = {1.0         , 651.4101098,  56974.73333,    165917.4725,     -2815759.939};
+      static const double p6[5] = {1.000827619,  664.9143136,  62972.92665,    475554.6998,     -5743609.109};
+      static const double q6[5] = {1.0         , 651.4101098,  56974.73333,    165917.4725,     -2815759.939};
 
-      static double a1[3] = {0.04166666667,-0.01996527778, 0.02709538966};
+      static const double a1[3] = {0.04166666667,-0.01996527778, 0.02709538966};
 
-      static double a2[2] = {-1.845568670,-4.284640743};
+      static const double a2[2] = {-1.845568670,-4.284640743};
 
-      if (xi <= 0) return 0;
-      double v = (x - x0)/xi;
       double u, ue, us, denlan;
       if (v < -5.5) {
          u   = std::exp(v+1.0);
@@ -250,11 +311,24 @@ namespace Math {
          u   = 1/(v-v*std::log(v)/(v+1));
          denlan = u*u*(1+(a2[0]+a2[1]*u)*u);
       }
-      return denlan/xi;
+      return denlan;
 
    }
 
+   double landau_pdf(double x, double xi, double x0) {
+      // LANDAU pdf : algorithm from CERNLIB G110 denlan
+      if (xi <= 0) return 0;
+      return landau_denlan((x - x0)/xi)/xi;
+   }
 
+   void landau_pdf_array(unsigned int npoints, const double * x, double * result, double xi, double x0) {
+      if (xi <= 0) {
+         for (unsigned int i = 0; i < npoints; ++i) result[i] = 0;
+         return;
+      }
+      for (unsigned int i = 0; i < npoints; ++i)
+         result[i] = landau_denlan((x[i] - x0)/xi)/xi;
+   }
 
 
 
@@ -280,6 +354,24 @@ namespace Math {
 
 
 
+   void normal_pdf_array(unsigned int npoints, const double * x, double * result, double sigma, double x0) {
+      // the normalization is computed only once for all the values
+      using namespace Vectorizable;
+      const double norm = 1.0/(std::sqrt(2 * M_PI) * std::fabs(sigma));
+      ApplyInBlocks(npoints, x, result, [&](const double * in, double * out) {
+         double t[kBlockSize];
+         for (unsigned int i = 0; i < kBlockSize; ++i) {
+            double tmp = (in[i]-x0)/sigma;
+            t[i] = -tmp*tmp/2;
+         }
+         Vectorizable::exp(t, out);
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            out[i] *= norm;
+      });
+   }
+
+
+
    double poisson_pdf(unsigned int n, double mu) {
 
       if (n >  0)
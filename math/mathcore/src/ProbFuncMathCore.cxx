@@ -7,6 +7,7 @@
 #include "Math/Error.h"
 #include "Math/ProbFuncMathCore.h"
 #include "Math/SpecFuncMathCore.h"
+#include "SpecFuncVectorizable.h"
 #include <stdio.h>
 #include <limits>
 using namespace std;
@@ -239,6 +240,23 @@ namespace Math {
    }
 
 
+   void normal_cdf_array(unsigned int npoints, const double * x, double * result, double sigma, double x0)
+   {
+      // 0.5*(1+erf(z)) = 0.5*erfc(-z) for all the values, where erfc(-z) for |z| < 1 is
+      // computed as 1 + erf(z)
+      using namespace Vectorizable;
+      const double s = sigma*kSqrt2;
+      ApplyInBlocks(npoints, x, result, [&](const double * in, double * out) {
+         double z[kBlockSize];
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            z[i] = -(in[i]-x0)/s;
+         Vectorizable::erfc(z, out);
+         for (unsigned int i = 0; i < kBlockSize; ++i)
+            out[i] *= 0.5;
+      });
+   }
+
+
    double tdistribution_cdf_c(double x, double r, double x0)
    {
       double p    = x-x0;
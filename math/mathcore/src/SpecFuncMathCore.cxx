@@ -14,6 +14,7 @@
 
 
 #include "SpecFuncCephes.h"
+#include "SpecFuncVectorizable.h"
 
 
 #include <cmath>
@@ -71,6 +72,15 @@ double erf(double x) {
 
 
 
+void erf_array(unsigned int npoints, const double * x, double * result) {
+   // same approximation of Cephes erf, in a form which can be vectorized
+   Vectorizable::ApplyInBlocks(npoints, x, result, [](const double * in, double * out) {
+      Vectorizable::erf(in, out);
+   });
+}
+
+
+
 double lgamma(double z) {
 
 #ifdef USE_CEPHES
@@ -81,6 +91,11 @@ double lgamma(double z) {
 
 }
 
+void lgamma_array(unsigned int npoints, const double * x, double * result) {
+   for (unsigned int i = 0; i < npoints; ++i)
+      result[i] = ROOT::Math::lgamma(x[i]);
+}
+
 
 
 
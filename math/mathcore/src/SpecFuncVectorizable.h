@@ -0,0 +1,277 @@
+// @(#)root/mathcore:$Id$
+
+// Vectorizable polynomial and rational approximations of exp, log, erf and erfc, used by
+// the array versions of the probability density and distribution functions.
+//
+// The functions work on blocks of kBlockSize values stored in local arrays. Each one is
+// made of loops of fixed length without function calls nor branches: the approximation is
+// computed for all the values, and the special ranges are then fixed in a separate loop.
+// Loops of this form are vectorized by the compiler already at -O2, while a single loop
+// selecting between the ranges would be compiled with branches, since the floating point
+// operations cannot be executed speculatively.
+// Only basic floating point and 64-bit integer operations are used.
+//
+// The approximations are the ones of the Cephes library (exp, erf and erfc, as in
+// SpecFuncCephes.cxx) and of fdlibm (log); they agree with the scalar functions within
+// a few units in the last place.
+
+#ifndef ROOT_Math_SpecFuncVectorizable
+#define ROOT_Math_SpecFuncVectorizable
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace ROOT {
+namespace Math {
+
+namespace Vectorizable {
+
+/// number of values of the blocks
+const unsigned int kBlockSize = 64;
+
+inline double bits_to_double(uint64_t i) { double x; std::memcpy(&x, &i, sizeof(x)); return x; }
+inline uint64_t double_to_bits(double x) { uint64_t i; std::memcpy(&i, &x, sizeof(i)); return i; }
+
+/// 2^k for an integer valued k in [-1022,1023]
+inline double pow2(double k) {
+   // adding 1.5*2^52 (6755399441055744) puts k in the lowest bits of the mantissa
+   return bits_to_double((double_to_bits(k + 6755399441055744.0) + 1023) << 52);
+}
+
+/// exp(x) for x in [-746,710], Pade approximation of Cephes exp after the reduction
+/// x = k*ln2 + r. Outside the range the result is meaningless
+inline double exp_kernel(double x) {
+   const double kP0 = 1.26177193074810590878E-4;
+   const double kP1 = 3.02994407707441961300E-2;
+   const double kP2 = 9.99999999999999999910E-1;
+   const double kQ0 = 3.00198505138664455042E-6;
+   const double kQ1 = 2.52448340349684104192E-3;
+   const double kQ2 = 2.27265548208155028766E-1;
+   const double kQ3 = 2.00000000000000000009E0;
+   const double kC1 = 6.93145751953125E-1;
+   const double kC2 = 1.42860682030941723212E-6;
+   const double kLog2e = 1.4426950408889634073599;
+   const double kShift = 6755399441055744.0;  // 1.5*2^52
+
+   // nearest integer of x/ln2
+   const double k = (x * kLog2e + kShift) - kShift;
+   double r = x - k * kC1;
+   r -= k * kC2;
+   const double rr = r * r;
+   const double p = r * ((kP0 * rr + kP1) * rr + kP2);
+   const double q = ((kQ0 * rr + kQ1) * rr + kQ2) * rr + kQ3;
+   const double e = 1.0 + 2.0 * p / (q - p);
+   // 2^k is applied in two factors, to reach the overflow and the subnormal ranges
+   const double k1 = (0.5 * k + kShift) - kShift;
+   return e * pow2(k1) * pow2(k - k1);
+}
+
+/// log(x) for positive normal x, fdlibm algorithm: x = 2^k * (1+f) with
+/// sqrt(2)/2 <= 1+f < sqrt(2) and log(1+f) = 2s + s*R(s^2), s = f/(2+f)
+inline double log_kernel(double x) {
+   const double kLn2Hi = 6.93147180369123816490e-01;
+   const double kLn2Lo = 1.90821492927058770002e-10;
+   const double kLg1 = 6.666666666666735130e-01;
+   const double kLg2 = 3.999999999940941908e-01;
+   const double kLg3 = 2.857142874366239149e-01;
+   const double kLg4 = 2.222219843214978396e-01;
+   const double kLg5 = 1.818357216161805012e-01;
+   const double kLg6 = 1.531383769920937332e-01;
+   const double kLg7 = 1.479819860511658591e-01;
+   const uint64_t kSqrtHalf = 0x3fe6a09e667f3bcdULL;
+
+   // exponent and mantissa moved to [sqrt(2)/2,sqrt(2))
+   const uint64_t ix = double_to_bits(x) + (0x3ff0000000000000ULL - kSqrtHalf);
+   const double k = bits_to_double((ix >> 52) | 0x4330000000000000ULL) - (4503599627370496.0 + 1023.);  // 2^52 + 1023
+   const double m = bits_to_double((ix & 0x000fffffffffffffULL) + kSqrtHalf);
+
+   const double f = m - 1.0;
+   const double hfsq = 0.5 * f * f;
+   const double s = f / (2.0 + f);
+   const double z = s * s;
+   const double w = z * z;
+   const double t1 = w * (kLg2 + w * (kLg4 + w * kLg6));
+   const double t2 = z * (kLg1 + w * (kLg3 + w * (kLg5 + w * kLg7)));
+   return s * (hfsq + t1 + t2) + k * kLn2Lo - hfsq + f + k * kLn2Hi;
+}
+
+/// erf(x) for |x| <= 1, rational approximation x*T(x^2)/U(x^2) of Cephes erf
+inline double erf_small_kernel(double x) {
+   const double z = x * x;
+   const double t = (((9.60497373987051638749E0 * z + 9.00260197203842689217E1) * z + 2.23200534594684319226E3) * z +
+                     7.00332514112805075473E3) * z + 5.55923013010394962768E4;
+   const double u = ((((z + 3.35617141647503099647E1) * z + 5.21357949780152679795E2) * z + 4.59432382970980127987E3) * z +
+                     2.26290000613890934246E4) * z + 4.92673942608635921086E4;
+   return x * t / u;
+}
+
+/// P(a)/Q(a) of Cephes erfc, used for 1 <= a < 8
+inline void erfc_pq_kernel(double a, double &p, double &q) {
+   p = (((((((2.46196981473530512524E-10 * a + 5.64189564831068821977E-1) * a + 7.46321056442269912687E0) * a +
+            4.86371970985681366614E1) * a + 1.96520832956077098242E2) * a + 5.26445194995477358631E2) * a +
+         9.34528527171957607540E2) * a + 1.02755188689515710272E3) * a + 5.57535335369399327526E2;
+   q = (((((((a + 1.32281951154744992508E1) * a + 8.67072140885989742329E1) * a + 3.54937778887819891062E2) * a +
+            9.75708501743205489753E2) * a + 1.82390916687909736289E3) * a + 2.24633760818710981792E3) * a +
+         1.65666309194161350182E3) * a + 5.57535340817727675546E2;
+}
+
+/// R(a)/S(a) of Cephes erfc, used for a >= 8
+inline void erfc_rs_kernel(double a, double &r, double &s) {
+   r = ((((5.64189583547755073984E-1 * a + 1.27536670759978104416E0) * a + 5.01905042251180477414E0) * a +
+          6.16021097993053585195E0) * a + 7.40974269950448939160E0) * a + 2.97886665372100240670E0;
+   s = (((((a + 2.26052863220117276590E0) * a + 9.39603524938001434673E0) * a + 1.20489539808096656605E1) * a +
+          1.70814450747565897222E1) * a + 9.60896809063285878198E0) * a + 3.36907645100081516050E0;
+}
+
+/// y[i] = cond(i) ? a[i] : b[i] for a block of local values (y can be the same array as a or b).
+/// The selection is done on the bits of the values with a mask: the optimizer turns a
+/// selection between two arrays into a conditional load, which cannot be vectorized, and
+/// moves the computations used only for one of the choices into a branch. For the same
+/// reason, in the functions below the loops computing the values are separated from the
+/// ones selecting between them.
+template <class Cond>
+inline void select(Cond cond, const double * a, const double * b, double * y) {
+   // a NaN with all the bits set
+   const double kAllBits = bits_to_double(~uint64_t(0));
+   double mask[kBlockSize];
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      mask[i] = cond(i) ? kAllBits : 0.0;
+   for (unsigned int i = 0; i < kBlockSize; ++i) {
+      const uint64_t m = double_to_bits(mask[i]);
+      y[i] = bits_to_double((double_to_bits(a[i]) & m) | (double_to_bits(b[i]) & ~m));
+   }
+}
+
+/// y = |x| for a block of values
+inline void abs(const double * x, double * y) {
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      y[i] = bits_to_double(double_to_bits(x[i]) & 0x7fffffffffffffffULL);
+}
+
+/// y = exp(x) for a block of values.
+/// Overflows to +inf and underflows gradually to 0 like std::exp, a NaN is propagated
+inline void exp(const double * x, double * y) {
+   const double kInf = std::numeric_limits<double>::infinity();
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      y[i] = exp_kernel(x[i]);
+   // the values computed outside [-746,710] are replaced by +inf or 0
+   // (the conditions are false for a NaN)
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      y[i] = (x[i] > 710.) ? kInf : y[i];
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      y[i] = (x[i] < -746.) ? 0.0 : y[i];
+}
+
+/// y = log(x) for a block of values.
+/// Returns -inf for 0, NaN for negative arguments, and x for +inf and NaN
+inline void log(const double * x, double * y) {
+   const double kInf = std::numeric_limits<double>::infinity();
+   const double kNaN = std::numeric_limits<double>::quiet_NaN();
+   const double kMinNormal = std::numeric_limits<double>::min();
+   // the work is done on local copies: the function is not always inlined, and the
+   // selections between the values of arrays passed as arguments are not vectorized
+   double xl[kBlockSize], xs[kBlockSize], yl[kBlockSize], ys[kBlockSize];
+   std::copy(x, x + kBlockSize, xl);
+   auto subnormal = [&](unsigned int i) { return xl[i] < kMinNormal; };
+   // subnormal numbers are scaled by 2^54
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      xs[i] = xl[i] * 18014398509481984.0;
+   select(subnormal, xs, xl, xs);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      yl[i] = log_kernel(xs[i]);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      ys[i] = yl[i] - 54. * 6.93147180559945309417e-01;
+   select(subnormal, ys, yl, yl);
+   // special values
+   select([&](unsigned int i) { return xl[i] < kInf; }, yl, xl, yl);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      yl[i] = (xl[i] == 0) ? -kInf : yl[i];
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      yl[i] = (xl[i] < 0) ? kNaN : yl[i];
+   std::copy(yl, yl + kBlockSize, y);
+}
+
+/// y = erfc(a) for a block of values a >= 1, as in Cephes erfc.
+/// The result is 0 when exp(-a^2) is not a normal number
+inline void erfc_large(const double * a, double * y) {
+   double al[kBlockSize], z[kBlockSize], e[kBlockSize], yl[kBlockSize], ys[kBlockSize];
+   std::copy(a, a + kBlockSize, al);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      z[i] = -al[i] * al[i];
+   Vectorizable::exp(z, e);
+   for (unsigned int i = 0; i < kBlockSize; ++i) {
+      double p, q;
+      erfc_pq_kernel(al[i], p, q);
+      yl[i] = p / q;
+   }
+   for (unsigned int i = 0; i < kBlockSize; ++i) {
+      double r, s;
+      erfc_rs_kernel(al[i], r, s);
+      ys[i] = r / s;
+   }
+   select([&](unsigned int i) { return al[i] < 8.0; }, yl, ys, yl);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      yl[i] *= e[i];
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      yl[i] = (z[i] < -709.782712893383973096206318587) ? 0.0 : yl[i];
+   std::copy(yl, yl + kBlockSize, y);
+}
+
+/// y = erf(x) for a block of values
+inline void erf(const double * x, double * y) {
+   double xl[kBlockSize], a[kBlockSize], c[kBlockSize], yl[kBlockSize];
+   std::copy(x, x + kBlockSize, xl);
+   Vectorizable::abs(xl, a);
+   erfc_large(a, yl);
+   // erf(x) = 1 - erfc(x) for |x| > 1, with erfc(x) = 2 - erfc(-x) for x < 0
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      c[i] = 1.0 - (2.0 - yl[i]);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      yl[i] = 1.0 - yl[i];
+   select([&](unsigned int i) { return xl[i] < 0; }, c, yl, yl);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      c[i] = erf_small_kernel(xl[i]);
+   select([&](unsigned int i) { return a[i] > 1.0; }, yl, c, yl);
+   std::copy(yl, yl + kBlockSize, y);
+}
+
+/// y = erfc(x) for a block of values
+inline void erfc(const double * x, double * y) {
+   double xl[kBlockSize], a[kBlockSize], c[kBlockSize], yl[kBlockSize];
+   std::copy(x, x + kBlockSize, xl);
+   Vectorizable::abs(xl, a);
+   erfc_large(a, yl);
+   // erfc(x) = 2 - erfc(-x) for x < 0 and erfc(x) = 1 - erf(x) for |x| < 1
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      c[i] = 2.0 - yl[i];
+   select([&](unsigned int i) { return xl[i] < 0; }, c, yl, yl);
+   for (unsigned int i = 0; i < kBlockSize; ++i)
+      c[i] = 1.0 - erf_small_kernel(xl[i]);
+   select([&](unsigned int i) { return a[i] < 1.0; }, c, yl, yl);
+   std::copy(yl, yl + kBlockSize, y);
+}
+
+/// Apply func(in, out) to the npoints values of x in blocks of kBlockSize values, storing
+/// the results in result. The last block is completed with zeros. result can be the same
+/// array as x
+template <class Int, class Func>
+inline void ApplyInBlocks(Int npoints, const double * x, double * result, Func func) {
+   double in[kBlockSize];
+   double out[kBlockSize];
+   for (Int i = 0; i < npoints; i += kBlockSize) {
+      const unsigned int m = (npoints - i < Int(kBlockSize)) ? (unsigned int)(npoints - i) : kBlockSize;
+      std::copy(x + i, x + i + m, in);
+      std::fill(in + m, in + kBlockSize, 0.0);
+      func(in, out);
+      std::copy(out, out + m, result + i);
+   }
+}
+
+} // end namespace Vectorizable
+
+} // end namespace Math
+} // end namespace ROOT
+
+#endif
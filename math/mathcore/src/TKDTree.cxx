@@ -15,9 +15,34 @@
 #include "TString.h"
 #include <string.h>
 #include <limits>
+#include <algorithm>
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
 
 templateClassImp(TKDTree)
 
+namespace {
+   // minimal number of points for building the tree in parallel
+   const Int_t kKDTreeParallelMinPoints = 1<<16;
+   // number of subtrees built as independent tasks
+   const UInt_t kKDTreeBuildTasks = 64;
+   // number of queries processed by each task of the parallel nearest neighbor search
+   const Int_t kKNNQueriesPerTask = 256;
+
+   // subtree still to be built: root node, row, position in fIndPoints and number of points
+   struct KDSubtree {
+      Int_t fNode;
+      Int_t fRow;
+      Int_t fPos;
+      Int_t fNPoints;
+   };
+}
+
 
 /**
 \class TKDTree
@@ -406,6 +431,9 @@ TKDTree<Index, Value>::~TKDTree()
 ///
 /// The tree is divided recursively. See class description, section 4b for the details
 /// of the division alogrithm
+///
+/// With implicit multithreading enabled, the subtrees below the first rows are built
+/// in parallel for large number of points
 
 template <typename  Index, typename Value>
 void TKDTree<Index, Value>::Build()
@@ -449,76 +477,74 @@ void TKDTree<Index, Value>::Build()
    //
    //
    //4.
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fNPoints >= kKDTreeParallelMinPoints) {
+      // divide the nodes of the first rows serially, until there are enough subtrees.
+      // The subtrees use disjoint parts of fIndPoints, fAxis and fValue and are then
+      // built in parallel; the tree is the same as the one built serially
+      std::vector<KDSubtree> subtrees(1);
+      subtrees[0].fNode = 0; subtrees[0].fRow = 0; subtrees[0].fPos = 0; subtrees[0].fNPoints = fNPoints;
+      Bool_t divided = kTRUE;
+      while (divided && subtrees.size() < kKDTreeBuildTasks) {
+         divided = kFALSE;
+         std::vector<KDSubtree> next;
+         for (const KDSubtree &sub : subtrees) {
+            if (sub.fNPoints <= (Int_t)fBucketSize) {
+               next.push_back(sub); // terminal node
+               continue;
+            }
+            Int_t nleft, nright;
+            DivideNode(sub.fNode, sub.fRow, sub.fPos, sub.fNPoints, nleft, nright);
+            KDSubtree left  = { GetLeft(sub.fNode),  sub.fRow+1, sub.fPos,       nleft  };
+            KDSubtree right = { GetRight(sub.fNode), sub.fRow+1, sub.fPos+nleft, nright };
+            next.push_back(left);
+            next.push_back(right);
+            divided = kTRUE;
+         }
+         subtrees.swap(next);
+      }
+      auto buildSubtree = [&](UInt_t i) {
+         BuildSubtree(subtrees[i].fNode, subtrees[i].fRow, subtrees[i].fPos, subtrees[i].fNPoints);
+         return 0;
+      };
+      ROOT::Internal::GetImplicitMTExecutor()->Map(buildSubtree, ROOT::TSeq<UInt_t>(subtrees.size()));
+      return;
+   }
+#endif
+   BuildSubtree(0, 0, 0, fNPoints);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Non recursive building of the subtree with root node, starting at row row and
+/// containing the npoints points starting at position pos in fIndPoints
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildSubtree(Int_t node, Int_t row, Int_t pos, Int_t npoints)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   Int_t iter =0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = row;
+   nodeStack[0]   = node;
+   npointStack[0] = npoints;
+   posStack[0]    = pos;
    //
-   Int_t nbucketsall =0;
    while (currentIndex>=0){
-      iter++;
       //
-      Int_t npoints  = npointStack[currentIndex];
-      if (npoints<=fBucketSize) {
-         //printf("terminal node : index %d iter %d\n", currentIndex, iter);
+      Int_t cpoints  = npointStack[currentIndex];
+      if (cpoints<=fBucketSize) {
          currentIndex--;
-         nbucketsall++;
          continue; // terminal node
       }
       Int_t crow     = rowStack[currentIndex];
       Int_t cpos     = posStack[currentIndex];
       Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
       //
-      // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
       Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      DivideNode(cnode, crow, cpos, cpoints, nleft, nright);
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
@@ -529,13 +555,63 @@ void TKDTree<Index, Value>::Build()
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos+nleft;
       nodeStack[currentIndex]   = (cnode*2)+2;
-      //
-      if (0){
-         // consistency check
-         Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
-         if (nleft<nright) Warning("Build", "Problem Left-Right");
-         if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Divide the npoints points of node cnode (in row crow, starting at position cpos
+/// in fIndPoints) along the axis with the biggest spread. The number of points
+/// going to the left and right daughters are returned in nleft and nright
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints, Int_t &nleft, Int_t &nright)
+{
+   // divide points
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+      nright = npoints-nleft;
+   }else{
+      nright = nfull*fBucketSize/2;
+      nleft  = npoints-nright;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
       }
+      if(cnode) continue;
+      //printf("set %d %6.3f %6.3f\n", idim, min, max);
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
+   }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
+   //
+   if (0){
+      // consistency check
+      Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
+      if (nleft<nright) Warning("Build", "Problem Left-Right");
+      if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
    }
 }
 
@@ -561,6 +637,52 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors for each of the npoints points stored one after the
+///other in the array points (point i starts at points[i*ndim]).
+///The indexes and distances of the neighbors of point i are returned in ind[i*kNN]
+///and dist[i*kNN], arrays that are provided by the user and are assumed to be at
+///least npoints*kNN elements long.
+///With implicit multithreading enabled the queries are processed in parallel;
+///the results are the same as calling FindNearestNeighbors for each point.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighbors(Index npoints, const Value *points, const Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighbors", "Working arrays must be allocated by the user!");
+      return;
+   }
+   // the boundaries are built before the queries, which then only read the tree
+   MakeBoundariesExact();
+
+   auto findRange = [&](Index first, Index last) {
+      for (Index ipoint = first; ipoint < last; ipoint++) {
+         Index *pind = ind + ipoint*kNN;
+         Value *pdist = dist + ipoint*kNN;
+         for (Int_t i=0; i<kNN; i++){
+            pdist[i]=std::numeric_limits<Value>::max();
+            pind[i]=-1;
+         }
+         UpdateNearestNeighbors(0, points + ipoint*fNDim, kNN, pind, pdist);
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && npoints >= 2*kKNNQueriesPerTask) {
+      const UInt_t ntasks = (npoints + kKNNQueriesPerTask - 1) / kKNNQueriesPerTask;
+      auto findTask = [&](UInt_t itask) {
+         const Index first = itask*kKNNQueriesPerTask;
+         findRange(first, std::min<Index>(first + kKNNQueriesPerTask, npoints));
+         return 0;
+      };
+      ROOT::Internal::GetImplicitMTExecutor()->Map(findTask, ROOT::TSeq<UInt_t>(ntasks));
+      return;
+   }
+#endif
+   findRange(0, npoints);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
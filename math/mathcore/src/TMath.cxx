@@ -28,6 +28,7 @@
 #include <Math/SpecFuncMathCore.h>
 #include <Math/PdfFuncMathCore.h>
 #include <Math/ProbFuncMathCore.h>
+#include "SpecFuncVectorizable.h"
 
 //const Double_t
 //   TMath::Pi = 3.14159265358979323846,
@@ -460,6 +461,32 @@ Double_t TMath::Gaus(Double_t x, Double_t mean, Double_t sigma, Bool_t norm)
    return res/(2.50662827463100024*sigma); //sqrt(2*Pi)=2.50662827463100024
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate a gaussian function with mean and sigma for the n values of the
+/// array x. The results, which agree with the ones of the scalar function within
+/// a few units in the last place, are stored in result (which can be the same
+/// array as x).
+
+void TMath::GausArray(Long64_t n, const Double_t *x, Double_t *result, Double_t mean, Double_t sigma, Bool_t norm)
+{
+   if (sigma == 0) {
+      for (Long64_t i = 0; i < n; i++) result[i] = 1.e30;
+      return;
+   }
+   using namespace ::ROOT::Math::Vectorizable;
+   const Double_t den = norm ? 2.50662827463100024*sigma : 1.; //sqrt(2*Pi)=2.50662827463100024
+   ApplyInBlocks(n, x, result, [&](const Double_t *in, Double_t *out) {
+      Double_t t[kBlockSize];
+      for (UInt_t i = 0; i < kBlockSize; i++) {
+         Double_t arg = (in[i]-mean)/sigma;
+         t[i] = -0.5*arg*arg;
+      }
+      // for |arg| > 39 the exponential underflows to zero
+      ::ROOT::Math::Vectorizable::exp(t, out);
+      for (UInt_t i = 0; i < kBlockSize; i++) out[i] /= den;
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The LANDAU function.
 /// mu is a location parameter and correspond approximately to the most probable value
@@ -477,6 +504,28 @@ Double_t TMath::Landau(Double_t x, Double_t mu, Double_t sigma, Bool_t norm)
    return den/sigma;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// The LANDAU function evaluated for the n values of the array x.
+/// The results, identical to the ones of the scalar function, are stored
+/// in result (which can be the same array as x).
+
+void TMath::LandauArray(Long64_t n, const Double_t *x, Double_t *result, Double_t mu, Double_t sigma, Bool_t norm)
+{
+   if (sigma <= 0) {
+      for (Long64_t i = 0; i < n; i++) result[i] = 0;
+      return;
+   }
+   for (Long64_t i = 0; i < n; i++) result[i] = (x[i]-mu)/sigma;
+   // the ROOT::Math batch function takes at most kMaxUInt values at the time
+   for (Long64_t first = 0; first < n; first += kMaxUInt) {
+      const UInt_t npoints = (n - first < kMaxUInt) ? (UInt_t)(n - first) : kMaxUInt;
+      ::ROOT::Math::landau_pdf_array(npoints, result + first, result + first);
+   }
+   if (norm) {
+      for (Long64_t i = 0; i < n; i++) result[i] /= sigma;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Computation of ln[gamma(z)] for all z.
 ///
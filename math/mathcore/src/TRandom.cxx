@@ -139,8 +139,16 @@ A TRandom object may be written to a Root file
 #include "Math/QuantFuncMathCore.h"
 #include "TUUID.h"
 
+#include <algorithm>
+#include <vector>
+
 ClassImp(TRandom)
 
+namespace {
+   // number of uniform numbers generated in one go by the array methods
+   const Int_t kRndmArrayBlock = 256;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor. For seed see SetSeed().
 
@@ -216,6 +224,19 @@ Double_t TRandom::Exp(Double_t tau)
    return t;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of n exponential deviates, exp( -t/tau ).
+///
+/// The uniform numbers are generated in blocks with RndmArray and then
+/// transformed, giving the same sequence as calling Exp(tau) n times.
+
+void TRandom::ExpArray(Int_t n, Double_t *array, Double_t tau)
+{
+   RndmArray(n, array);              // uniform on ] 0, 1 ]
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = -tau * TMath::Log(array[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Samples a random number from the standard Normal (Gaussian) Distribution
 /// with the given mean and sigma.
@@ -314,6 +335,40 @@ Double_t TRandom::Gaus(Double_t mean, Double_t sigma)
    return mean + sigma * result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of n numbers distributed following a gaussian with the
+/// given mean and sigma.
+///
+/// Contrary to Gaus(), which uses an acceptance-complement method consuming a
+/// variable number of uniform numbers, this uses the Box-Muller transformation:
+/// each pair of gaussian numbers is computed from exactly two uniform numbers,
+/// which are generated in blocks with RndmArray. The transformation loop has no
+/// branches, and the generated sequence only depends on the seed and on n (if n
+/// is odd, the last number of the last pair is discarded).
+/// The numbers are not the same as the ones returned by Gaus().
+
+void TRandom::GausArray(Int_t n, Double_t *array, Double_t mean, Double_t sigma)
+{
+   const Double_t kTwoPi = TMath::TwoPi();
+   Double_t u[kRndmArrayBlock];
+   Double_t g[kRndmArrayBlock];
+   Int_t i = 0;
+   while (i < n) {
+      const Int_t m     = std::min(n - i, kRndmArrayBlock);
+      const Int_t npair = (m + 1) / 2;
+      RndmArray(2 * npair, u);        // uniform on ] 0, 1 ]
+      for (Int_t k = 0; k < npair; ++k) {
+         const Double_t r   = TMath::Sqrt(-2 * TMath::Log(u[2 * k]));
+         const Double_t phi = kTwoPi * u[2 * k + 1];
+         g[2 * k]     = r * TMath::Sin(phi);
+         g[2 * k + 1] = r * TMath::Cos(phi);
+      }
+      for (Int_t k = 0; k < m; ++k)
+         array[i + k] = mean + sigma * g[k];
+      i += m;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns a random integer on [ 0, imax-1 ].
 
@@ -404,6 +459,49 @@ Int_t TRandom::Poisson(Double_t mean)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of n random integers distributed according to a Poisson law.
+/// Prob(N) = exp(-mean)*mean^N/Factorial(N)
+///
+/// For mean < 25 the numbers are generated by inversion of the cumulative
+/// distribution, which is tabulated once: each number needs exactly one uniform
+/// number, generated in blocks with RndmArray, and a binary search in the
+/// table. For larger values Poisson() is called for each number.
+/// The numbers are not the same as the ones returned by Poisson().
+
+void TRandom::PoissonArray(Int_t n, Int_t *array, Double_t mean)
+{
+   if (mean <= 0 || mean >= 25) {
+      for (Int_t i = 0; i < n; ++i)
+         array[i] = Poisson(mean);
+      return;
+   }
+
+   // tabulate the cumulative distribution until the tail becomes negligible
+   std::vector<Double_t> cdf;
+   Double_t p = TMath::Exp(-mean);
+   Double_t sum = p;
+   cdf.push_back(sum);
+   for (Int_t k = 1; k <= mean || p > 1.E-17 * sum; ++k) {
+      p *= mean / k;
+      sum += p;
+      cdf.push_back(sum);
+   }
+   const Int_t kmax = cdf.size() - 1;
+
+   Double_t u[kRndmArrayBlock];
+   Int_t i = 0;
+   while (i < n) {
+      const Int_t m = std::min(n - i, kRndmArrayBlock);
+      RndmArray(m, u);
+      for (Int_t k = 0; k < m; ++k) {
+         const Int_t ik = std::lower_bound(cdf.begin(), cdf.end(), u[k]) - cdf.begin();
+         array[i + k] = std::min(ik, kmax);
+      }
+      i += m;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates a random number according to a Poisson law.
 /// Prob(N) = exp(-mean)*mean^N/Factorial(N)
@@ -531,28 +629,26 @@ Double_t TRandom::Rndm( )
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return an array of n random numbers uniformly distributed in ]0,1].
+///
+/// The numbers are obtained calling Rndm(), so that a derived class overriding only
+/// Rndm() gets the same sequence from RndmArray and from the array methods using it
+/// (ExpArray, GausArray, ...). Derived classes should override also RndmArray with
+/// a faster implementation giving the same sequence as Rndm().
 
 void TRandom::RndmArray(Int_t n, Double_t *array)
 {
-   const Double_t kCONS = 4.6566128730774E-10; // (1/pow(2,31))
-   Int_t i=0;
-   while (i<n) {
-      fSeed = (1103515245 * fSeed + 12345) & 0x7fffffffUL;
-      if (fSeed) {array[i] = kCONS*fSeed; i++;}
-   }
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = Rndm();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Return an array of n random numbers uniformly distributed in ]0,1].
+/// The numbers are obtained calling Rndm(), see RndmArray(Int_t, Double_t *).
 
 void TRandom::RndmArray(Int_t n, Float_t *array)
 {
-   const Double_t kCONS = 4.6566128730774E-10; // (1/pow(2,31))
-   Int_t i=0;
-   while (i<n) {
-      fSeed = (1103515245 * fSeed + 12345) & 0x7fffffffUL;
-      if (fSeed) {array[i] = Float_t(kCONS*fSeed); i++;}
-   }
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = Float_t(Rndm());
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,77 @@
+// @(#)root/mathcore:$Id$
+
+/**
+
+\class TRandomPhilox
+
+Random number generator class based on the counter-based Philox4x32-10
+generator of Salmon et al. (see ROOT::Math::PhiloxEngine).
+
+The generated number is a function of the seed, of a 64 bit substream
+identifier and of the position in the substream only. Jumping ahead
+(Skip, SetCounter) is therefore immediate, and independent substreams can be
+selected for each event or each task, e.g.
+
+~~~ {.cpp}
+   TRandomPhilox r(seed);
+   r.SetStream(runNumber, eventNumber);
+   double x = r.Gaus(0,1);
+~~~
+
+so that parallel toys and simulation give the same results independently of
+the number of threads. GenerateStreams implements this scheme for the
+generators producing many events at once.
+
+@ingroup Random
+
+*/
+
+#include "TRandomPhilox.h"
+
+#include <algorithm>
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+
+namespace {
+   // number of events generated with the same substream by GenerateStreams
+   const Long64_t kEventsPerStream = 4096;
+}
+
+ClassImp(TRandomPhilox)
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate nevents events with independent random numbers: the events are divided
+/// in consecutive groups of a fixed size, and generate(rndm, first, n) is called for
+/// the n events of each group starting at event first, with a generator initialized
+/// with seed on the substream of the group.
+/// When implicit multi-threading is enabled (ROOT::EnableImplicitMT) the groups are
+/// generated in parallel, so generate must be thread safe. Since the groups do not
+/// depend on the number of threads, neither do the generated events.
+
+void TRandomPhilox::GenerateStreams(ULong64_t seed, Long64_t nevents,
+                                    const std::function<void(TRandomPhilox &rndm, Long64_t first, Long64_t n)> &generate)
+{
+   if (nevents <= 0) return;
+   const UInt_t nstreams = (nevents + kEventsPerStream - 1) / kEventsPerStream;
+
+   auto generateStream = [&](UInt_t istream) {
+      TRandomPhilox rndm(seed);
+      rndm.SetStream(istream);
+      const Long64_t first = istream*kEventsPerStream;
+      generate(rndm, first, std::min(kEventsPerStream, nevents - first));
+      return 0;
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nstreams > 1) {
+      ROOT::Internal::GetImplicitMTExecutor()->Map(generateStream, ROOT::TSeq<UInt_t>(nstreams));
+      return;
+   }
+#endif
+   for (UInt_t istream = 0; istream < nstreams; ++istream) generateStream(istream);
+}
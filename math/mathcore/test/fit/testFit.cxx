@@ -14,6 +14,7 @@
 #include "Fit/UnBinData.h"
 #include "HFitInterface.h"
 #include "Fit/Fitter.h"
+#include "Fit/FitUtil.h"
 
 #include "Math/WrappedMultiTF1.h"
 #include "Math/WrappedParamFunction.h"
@@ -914,6 +915,122 @@ int testGraphFit() {
 }
 
 
+double gausFunc(const double * x, const double * p) {
+   return p[0] * std::exp(-0.5*(x[0]-p[1])*(x[0]-p[1])/(p[2]*p[2]) );
+}
+
+int testParallelEval() {
+   // compare the serial and the multithread (chunked) evaluation of the fit method functions.
+   // The chunked evaluation must be reproducible and agree with the serial one up to rounding
+
+   int iret = 0;
+   TRandom3 rndm;
+
+   const int n = 20000;
+   double p[3] = {100,0.,1.};
+   ROOT::Math::WrappedParamFunction<> f(&gausFunc, 1, 3);
+   f.SetParameters(p);
+
+   ROOT::Fit::BinData bd(n);
+   ROOT::Fit::UnBinData ud(n);
+   for (int i = 0; i < n; ++i) {
+      double x = -5. + 10.*(i+0.5)/n;
+      double y = rndm.Poisson(f(&x) );
+      bd.Add(x, y, (y > 0) ? std::sqrt(y) : 1.);
+      ud.Add(rndm.Gaus(0,1) );
+   }
+
+   const ROOT::Fit::ExecutionPolicy kMT = ROOT::Fit::ExecutionPolicy::kMultithread;
+   double q[3] = {90,0.1,1.2};
+   unsigned int np1 = 0, np2 = 0, np3 = 0;
+
+   double v1 = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, q, np1);
+   double v2 = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, q, np2, kMT);
+   double v3 = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, q, np3, kMT);
+   iret |= compareResult(v2, v1, "multithread chi2", 1.E-10);
+   if (v2 != v3 || np1 != np2) {
+      std::cerr << "multithread chi2 is not reproducible " << v2 << "  " << v3 << std::endl;
+      iret |= 1;
+   }
+
+   v1 = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, q, 0, true, np1);
+   v2 = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, q, 0, true, np2, kMT);
+   v3 = ROOT::Fit::FitUtil::EvaluatePoissonLogL(f, bd, q, 0, true, np3, kMT, 7);
+   iret |= compareResult(v2, v1, "multithread Poisson likelihood", 1.E-10);
+   iret |= compareResult(v3, v1, "multithread Poisson likelihood (7 chunks)", 1.E-10);
+   if (np1 != np2 || np1 != np3) {
+      std::cerr << "multithread Poisson likelihood has wrong number of points " << np1 << "  " << np2 << "  " << np3 << std::endl;
+      iret |= 1;
+   }
+
+   v1 = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, q, 0, false, np1);
+   v2 = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, q, 0, false, np2, kMT);
+   v3 = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, q, 0, false, np3, kMT);
+   iret |= compareResult(v2, v1, "multithread unbinned likelihood", 1.E-10);
+   if (v2 != v3) {
+      std::cerr << "multithread unbinned likelihood is not reproducible " << v2 << "  " << v3 << std::endl;
+      iret |= 1;
+   }
+
+   // compare a TH1::Fit using the multithread option
+   TH1D * h1 = new TH1D("hmt","hmt",n,-5.,5.);
+   for (int i = 0; i < 20*n; ++i)
+      h1->Fill( rndm.Gaus(0,1) );
+
+   TF1 * func = (TF1*)gROOT->GetFunction("gaus");
+   func->SetParameters(p);
+   h1->Fit(func,"Q0");
+   double chi2ref = func->GetChisquare();
+   func->SetParameters(p);
+   h1->Fit(func,"Q0 MULTITHREAD");
+   iret |= compareResult(func->GetChisquare(), chi2ref, "TH1::Fit multithread", 1.E-6);
+
+   delete h1;
+   return iret;
+}
+
+int testVectorEval() {
+   // compare the evaluation of the model functions on arrays of points (SoA layout)
+   // with the evaluation point by point, for a formula based TF1 and for a generic function
+
+   int iret = 0;
+   const unsigned int n = 1000;
+   double p[3] = {10,0.5,2.};
+
+   TF1 * func = (TF1*)gROOT->GetFunction("gaus");
+   func->SetParameters(p);
+   ROOT::Math::WrappedMultiTF1 wf(*func);
+   ROOT::Math::WrappedParamFunction<> gf(&gausFunc, 1, 3);
+   gf.SetParameters(p);
+
+   ROOT::Fit::BinData d(n);
+   for (unsigned int i = 0; i < n; ++i)
+      d.Add(-10. + 20.*i/n, 1., 1.);
+
+   std::vector<double> x(n), f1(n), f2(n);
+   d.GetCoordsSoA(0, n, x.data() );
+   wf.EvalPar(n, x.data(), 0, f1.data() );
+   gf.EvalPar(n, x.data(), p, f2.data() );
+   double chi2ref = 0;
+   for (unsigned int i = 0; i < n; ++i) {
+      if (std::abs(f1[i] - wf(&x[i]) ) > 1.E-12 * std::abs(f1[i]) || f2[i] != gf(&x[i], p) ) {
+         std::cerr << "array evaluation differs at x = " << x[i] << " : " << f1[i] << "  " << f2[i]
+                   << " should be " << wf(&x[i]) << std::endl;
+         iret |= 1;
+         break;
+      }
+      chi2ref += (1. - f1[i])*(1. - f1[i]);
+   }
+
+   // the chi2 is evaluated using the array interface of the model function
+   unsigned int np = 0;
+   double chi2 = ROOT::Fit::FitUtil::EvaluateChi2(wf, d, p, np);
+   iret |= compareResult(chi2, chi2ref, "chi2 from array evaluation", 1.E-10);
+
+   return iret;
+}
+
+
 template<typename Test>
 int testFit(Test t, std::string name) {
    std::cout << name << "\n\t\t";
@@ -934,6 +1051,8 @@ int main() {
    iret |= testFit( testHisto2DFit, "Histogram2D Gradient Fit");
    iret |= testFit( testUnBin1DFit, "Unbin 1D Fit");
    iret |= testFit( testGraphFit, "Graph 1D Fit");
+   iret |= testFit( testParallelEval, "Multithread Evaluation");
+   iret |= testFit( testVectorEval, "Vector Evaluation");
 
    std::cout << "\n******************************\n";
    if (iret) std::cerr << "\n\t testFit FAILED !!!!!!!!!!!!!!!! \n";
@@ -447,6 +447,29 @@ void TestNeighbors()
 
    printf("Nearest neighbors found for %d random points\n", ntimes);
    printf("%d neighbors are wrong compared to \"brute force\" method\n", diff1);
+
+//Batch query for all the points, compared with the single point queries
+   Int_t nquery = 1000;
+   Double_t *queries = new Double_t[3*nquery];
+   Int_t *index3 = new Int_t[nquery*nn];
+   Double_t *dist3 = new Double_t[nquery*nn];
+   for (Int_t iq=0; iq<nquery; iq++){
+      queries[3*iq]   = x[iq];
+      queries[3*iq+1] = y[iq];
+      queries[3*iq+2] = z[iq];
+   }
+   kdtree->FindNearestNeighbors(nquery, queries, nn, index3, dist3);
+   Int_t diff3=0;
+   for (Int_t iq=0; iq<nquery; iq++){
+      kdtree->FindNearestNeighbors(queries+3*iq, nn, index2, dist2);
+      for (Int_t inn=0; inn<nn; inn++){
+         if (index2[inn]!=index3[iq*nn+inn] || dist2[inn]!=dist3[iq*nn+inn]) diff3++;
+      }
+   }
+   printf("%d neighbors are different between batch and single point queries\n", diff3);
+   delete [] queries;
+   delete [] index3;
+   delete [] dist3;
 //   printf("Old: %d neighbors are wrong compared to brute-force method\n", diff2);
 
 //    printf("\n");
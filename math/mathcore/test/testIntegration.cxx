@@ -1,8 +1,16 @@
 #include "Math/Integrator.h"
 #include "Math/IntegratorMultiDim.h"
+#include "Math/AdaptiveIntegratorMultiDim.h"
 #include "Math/AllIntegrationTypes.h"
 #include "Math/Functor.h"
 #include "Math/GaussIntegrator.h"
+#include "Math/IntegratorOptions.h"
+#include "Math/IOptions.h"
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
 
 #include <cmath>
 
@@ -17,6 +25,13 @@ double f2(const double * x) {
    return x[0] + x[1];
 }
 
+// narrow gaussian peak, which needs many regions
+double f3(const double * x) {
+   double r2 = 0;
+   for (int i = 0; i < 3; ++i) r2 += (x[i]-0.3)*(x[i]-0.3);
+   return std::exp(-r2/(2*0.05*0.05));
+}
+
 void printTestResult(std::ostream & os, const char * type, int status) {
    os << "Test of " << type  << "\t: \t";
    if (!status)       os << "OK" << std::endl;
@@ -81,6 +96,60 @@ int testIntegrationMultiDim() {
    std::cout << "Cernlib Adaptive integral result is " << val << std::endl;
    status += std::fabs(val-RESULT) > ERRORLIMIT;
 
+   // divide and evaluate several regions together
+   ROOT::Math::AdaptiveIntegratorMultiDim ig1;
+   ig1.SetNRegionsBatch(16);
+   ig1.SetFunction(wf);
+   val = ig1.Integral(a,b);
+   std::cout << "Adaptive batch integral result is  " << val << std::endl;
+   status += std::fabs(val-RESULT) > ERRORLIMIT;
+
+   // many regions evaluated together: the result must be as accurate as the one of the
+   // serial algorithm, and identical with and without implicit multi-threading
+   ROOT::Math::Functor wf3(&f3,3);
+   double a3[3] = {0,0,0};
+   double b3[3] = {1,1,1};
+   const double RESULT3 = std::pow(std::sqrt(2*M_PI)*0.05, 3);
+   ROOT::Math::AdaptiveIntegratorMultiDim igs(1E-12, 1E-6, 1000000);
+   igs.SetFunction(wf3);
+   double vals = igs.Integral(a3, b3);
+   ROOT::Math::AdaptiveIntegratorMultiDim igb(1E-12, 1E-6, 1000000);
+   igb.SetNRegionsBatch(64);
+   igb.SetFunction(wf3);
+   double valb = igb.Integral(a3, b3);
+   std::cout << "Adaptive 3D integral result is     " << vals << " batch : " << valb
+             << " ( status " << igs.Status() << " " << igb.Status() << " , nevals " << igs.NEval()
+             << " " << igb.NEval() << " )" << std::endl;
+   status += (igs.Status() != 0 || igb.Status() != 0);
+   status += std::fabs(vals-RESULT3) > 1E-4*RESULT3;
+   status += std::fabs(valb-RESULT3) > 1E-4*RESULT3;
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   ROOT::Math::AdaptiveIntegratorMultiDim igmt(1E-12, 1E-6, 1000000);
+   igmt.SetNRegionsBatch(64);
+   igmt.SetFunction(wf3);
+   double valmt = igmt.Integral(a3, b3);
+   ROOT::DisableImplicitMT();
+   std::cout << "Adaptive 3D integral with imt is   " << valmt << " ( nevals " << igmt.NEval() << " )" << std::endl;
+   status += (valmt != valb || igmt.Error() != igb.Error() || igmt.NEval() != igb.NEval());
+#endif
+
+   // the regions divided together can be set with the extra options of IntegratorMultiDim
+   ROOT::Math::IntegratorMultiDim igo(wf3, ROOT::Math::IntegrationMultiDim::kADAPTIVE, 1E-12, 1E-6, 1000000);
+   ROOT::Math::IntegratorMultiDimOptions opt = igo.Options();
+   opt.ExtraOptions()->SetValue("NRegionsBatch", 64);
+   igo.SetOptions(opt);
+   double valo = igo.Integral(a3, b3);
+   int nbatch = 0;
+   igo.Options().ExtraOptions()->GetValue("NRegionsBatch", nbatch);
+   ROOT::Math::IntegratorMultiDimOptions::Default("ADAPTIVE").SetValue("NRegionsBatch", 64);
+   ROOT::Math::IntegratorMultiDim igd(wf3, ROOT::Math::IntegrationMultiDim::kADAPTIVE, 1E-12, 1E-6, 1000000);
+   double vald = igd.Integral(a3, b3);
+   ROOT::Math::IntegratorMultiDimOptions::Default("ADAPTIVE").SetValue("NRegionsBatch", 0);
+   std::cout << "Adaptive 3D integral with options  " << valo << " default options : " << vald
+             << " ( NRegionsBatch " << nbatch << " )" << std::endl;
+   status += (valo != valb || vald != valb || nbatch != 64);
+
    ROOT::Math::IntegratorMultiDim ig2(ROOT::Math::IntegrationMultiDim::kVEGAS);
    ig2.SetFunction(wf);
    val = ig2.Integral(a,b);
@@ -2,6 +2,7 @@
 #include "Math/TRandomEngine.h"
 #include "Math/MersenneTwisterEngine.h"
 #include "Math/MixMaxEngine.h"
+#include "Math/PhiloxEngine.h"
 //#include "Math/MyMixMaxEngine.h"
 //#include "Math/GSLRndmEngines.h"
 #include "Math/GoFTest.h"
@@ -12,12 +13,15 @@
 #include "TRandom1.h"
 #include "TRandom2.h"
 #include "TRandom3.h"
+#include "TRandomGen.h"
+#include "TRandomPhilox.h"
 //#include "TRandomNew3.h"
 
 #include "TStopwatch.h"
 #include <iostream>
 
 #include <random>
+#include <algorithm>
 
 using namespace ROOT::Math;
 
@@ -192,6 +196,115 @@ bool test4() {
    return ret; 
 }
 
+// generator overriding only Rndm(), the array methods of TRandom must use it
+class TRandomOnlyRndm : public TRandom {
+public:
+   TRandomOnlyRndm(UInt_t seed) : fGen(seed) {}
+   using TRandom::Rndm;
+   virtual Double_t Rndm() { return fGen.Rndm(); }
+private:
+   TRandom3 fGen;
+};
+
+bool test5() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting TRandom array methods for MIXMAX256" << std::endl;
+
+   // RndmArray must give the same sequence as Rndm
+   TRandomMixMax256 r1(1111);
+   TRandomMixMax256 r2(1111);
+   std::vector<double> x(NR);
+   std::vector<double> y(NR);
+   const int nblock = 1000;
+   for (int i = 0; i < NR; i += nblock) {
+      r1.RndmArray(nblock, x.data() + i);
+      for (int j = i; j < i + nblock; ++j)
+         y[j] = r2.Rndm();
+   }
+   if (x != y) {
+      std::cout << "RndmArray and Rndm sequences are different" << std::endl;
+      ret = false;
+   }
+
+   // ExpArray of a generator implementing only Rndm gives the same sequence as Exp
+   TRandomOnlyRndm r3(1111);
+   TRandomOnlyRndm r4(1111);
+   const int nexp = 10000;
+   r3.ExpArray(nexp, x.data(), 2.);
+   for (int i = 0; i < nexp; ++i)
+      y[i] = r4.Exp(2.);
+   if (!std::equal(x.begin(), x.begin() + nexp, y.begin())) {
+      std::cout << "ExpArray and Exp sequences are different for a generator overriding only Rndm" << std::endl;
+      ret = false;
+   }
+
+   // GausArray and Gaus must be compatible
+   TStopwatch w; w.Start();
+   r1.GausArray(NR, x.data());
+   w.Stop();
+   std::cout << "time for GausArray filled for " << r1.GetName();
+   w.Print();
+   w.Start();
+   for (int i = 0; i < NR; ++i)
+      y[i] = r2.Gaus(0,1);
+   w.Stop();
+   std::cout << "time for GAUS filled for " << r2.GetName();
+   w.Print();
+   for (int i = 0; i < NR; ++i) {
+      x[i] = ROOT::Math::normal_cdf(x[i],1);
+      y[i] = ROOT::Math::normal_cdf(y[i],1);
+   }
+   ret &= testCompatibility(x,y);
+
+   return ret;
+}
+
+bool test6() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting Philox substreams and jump ahead" << std::endl;
+
+   // numbers of each event substream do not depend on the order in which
+   // the events are generated nor on the amount of numbers drawn before
+   const int nevt = 100;
+   const int nperevt = 50;
+   std::vector<double> x(nevt*nperevt);
+   std::vector<double> y(nevt*nperevt);
+   TRandomPhilox r1(1111);
+   TRandomPhilox r2(1111);
+   for (int ievt = 0; ievt < nevt; ++ievt) {
+      r1.SetStream(1, ievt);
+      for (int i = 0; i < nperevt; ++i)
+         x[ievt*nperevt + i] = r1.Rndm();
+   }
+   for (int ievt = nevt-1; ievt >= 0; --ievt) {
+      r2.SetStream(1, ievt);
+      r2.RndmArray(nperevt, y.data() + ievt*nperevt);
+   }
+   if (x != y) {
+      std::cout << "Philox substreams are not reproducible" << std::endl;
+      ret = false;
+   }
+
+   // jump ahead
+   r2.SetStream(1, nevt-1);
+   r2.Skip(nperevt - 3);
+   for (int i = nperevt - 3; i < nperevt; ++i) {
+      if (r2.Rndm() != x[(nevt-1)*nperevt + i]) {
+         std::cout << "Philox jump ahead gives a different sequence" << std::endl;
+         ret = false;
+      }
+   }
+
+   Random<PhiloxEngine> rph(1111);
+   Random<MersenneTwisterEngine> rmt;
+   ret &= testUniform(rph, rmt);
+   ret &= testGauss(rph, rmt);
+   return ret;
+}
 
 bool testMathRandom() {
 
@@ -203,6 +316,8 @@ bool testMathRandom() {
    ret &= test2(); 
    ret &= test3(); 
    ret &= test4(); 
+   ret &= test5();
+   ret &= test6();
 
    if (!ret) Error("testMathRandom","Test Failed");
    else
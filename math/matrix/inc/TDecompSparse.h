@@ -179,6 +179,8 @@ public :
 
    void Print(Option_t *opt ="") const; // *MENU*
 
+   static Bool_t SolveConjugateGradient(const TMatrixDSparse &a,TVectorD &b,Double_t tol=1.0e-10,Int_t maxIter=0);
+
    TDecompSparse &operator= (const TDecompSparse &source);
 
    ClassDef(TDecompSparse,1) // Matrix Decompositition LU
@@ -26,9 +26,26 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include <memory>
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 ClassImp(TDecompChol)
 
+namespace {
+
+// number of rows of U completed together before they update the rows below them
+const Int_t kCholBlock = 64;
+// minimum number of rows to update for running the update in parallel, and rows per task
+const Int_t kCholParallelMinRows = 256;
+const Int_t kCholRowsPerTask     = 16;
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor for (nrows x nrows) matrix
 
@@ -112,35 +129,67 @@ Bool_t TDecompChol::Decompose()
       return kFALSE;
    }
 
-   Int_t i,j,icol,irow;
+   Int_t j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
-         Error("Decompose()","matrix not positive definite");
-         return kFALSE;
-      }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
-
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
-               const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
-            }
+
+   // The rows of U are computed in blocks of kCholBlock rows: a block is first completed with
+   // the contributions of its own rows and then subtracts its contributions from all rows below,
+   // in parallel when implicit multi-threading is enabled. The inner loops run along rows and
+   // every element receives its contributions in the same order as in the unblocked algorithm.
+#ifdef R__USE_IMT
+   std::shared_ptr<ROOT::TThreadExecutor> pool;
+   if (ROOT::IsImplicitMTEnabled() && n-TMath::Min(kCholBlock,n) >= kCholParallelMinRows)
+      pool = ROOT::Internal::GetImplicitMTExecutor();
+#endif
+   for (Int_t k0 = 0; k0 < n; k0 += kCholBlock) {
+      const Int_t k1 = TMath::Min(k0+kCholBlock,n);
+      for (icol = k0; icol < k1; icol++) {
+         const Int_t rowOff = icol*n;
+         for (irow = k0; irow < icol; irow++) {
+            const Int_t rowOff2 = irow*n;
+            const Double_t uij = pU[rowOff2+icol];
+            for (j = icol; j < n; j++)
+               pU[rowOff+j] -= pU[rowOff2+j]*uij;
+         }
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
          }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
          for (j = icol+1; j < n; j++)
             pU[rowOff+j] /= ujj;
       }
+
+      auto update = [&](Int_t rowFirst,Int_t rowLast) {
+         for (Int_t r = rowFirst; r < rowLast; r++) {
+            Double_t * const pr = pU+r*n;
+            for (Int_t k = k0; k < k1; k++) {
+               const Double_t * const pk = pU+k*n;
+               const Double_t ukr = pk[r];
+               for (Int_t jj = r; jj < n; jj++)
+                  pr[jj] -= pk[jj]*ukr;
+            }
+         }
+      };
+
+#ifdef R__USE_IMT
+      if (pool && n-k1 >= kCholParallelMinRows) {
+         const Int_t ntasks = (n-k1+kCholRowsPerTask-1)/kCholRowsPerTask;
+         auto task = [&](Int_t it) {
+            update(k1+it*kCholRowsPerTask,TMath::Min(k1+(it+1)*kCholRowsPerTask,n));
+            return 0;
+         };
+         pool->Map(task,ROOT::TSeqI(ntasks));
+         continue;
+      }
+#endif
+      update(k1,n);
    }
 
    for (irow = 0; irow < n; irow++) {
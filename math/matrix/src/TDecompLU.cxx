@@ -11,9 +11,25 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include <memory>
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 ClassImp(TDecompLU)
 
+namespace {
+
+// minimum number of multiply-adds in the sub-diagonal part of a column of the Crout
+// decomposition for computing it in parallel, and number of rows per task
+const Long64_t kCroutParallelMinOps = 1 << 16;
+const Int_t    kCroutRowsPerTask    = 32;
+
+}
+
 /** \class TDecompLU
     \ingroup Matrix
 
@@ -603,13 +619,23 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
    Double_t *pLU   = lu.GetMatrixArray();
 
    Double_t work[kWorkMax];
+   Double_t workCol[kWorkMax];
    Bool_t isAllocated = kFALSE;
    Double_t *scale = work;
+   // upper part of the current column, so that the dot products run over contiguous elements
+   Double_t *colj  = workCol;
    if (n > kWorkMax) {
       isAllocated = kTRUE;
       scale = new Double_t[n];
+      colj  = new Double_t[n];
    }
 
+#ifdef R__USE_IMT
+   std::shared_ptr<ROOT::TThreadExecutor> pool;
+   if (ROOT::IsImplicitMTEnabled() && Long64_t(n)*n >= 4*kCroutParallelMinOps)
+      pool = ROOT::Internal::GetImplicitMTExecutor();
+#endif
+
    sign    = 1.0;
    nrZeros = 0;
    // Find implicit scaling factors for each row
@@ -630,29 +656,44 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       for (Int_t i = 0; i < j; i++) {
          const Int_t off_i = i*n;
          Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < i; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
-         }
+         for (Int_t k = 0; k < i; k++)
+            r -= pLU[off_i+k]*colj[k];
          pLU[off_i+j] = r;
+         colj[i] = r;
       }
 
       // Run down jth subdiag to form the residuals after the elimination of
       // the first j-1 subdiags.  These residuals divided by the appropriate
       // diagonal term will become the multipliers in the elimination of the jth.
-      // subdiag. Find fIndex of largest scaled term in imax.
+      // subdiag. The rows are independent and are computed in parallel for large
+      // matrices when implicit multi-threading is enabled.
 
+      auto residuals = [&](Int_t iFirst,Int_t iLast) {
+         for (Int_t i = iFirst; i < iLast; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = 0; k < j; k++)
+               r -= pLU[off_i+k]*colj[k];
+            pLU[off_i+j] = r;
+         }
+      };
+#ifdef R__USE_IMT
+      if (pool && Long64_t(n-j)*j >= kCroutParallelMinOps) {
+         const Int_t ntasks = (n-j+kCroutRowsPerTask-1)/kCroutRowsPerTask;
+         auto task = [&](Int_t it) {
+            residuals(j+it*kCroutRowsPerTask,TMath::Min(j+(it+1)*kCroutRowsPerTask,n));
+            return 0;
+         };
+         pool->Map(task,ROOT::TSeqI(ntasks));
+      } else
+#endif
+      residuals(j,n);
+
+      // Find fIndex of largest scaled term in imax.
       Double_t max = 0.0;
       Int_t imax = 0;
       for (Int_t i = j; i < n; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < j; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
-         }
-         pLU[off_i+j] = r;
-         const Double_t tmp = scale[i]*TMath::Abs(r);
+         const Double_t tmp = scale[i]*TMath::Abs(pLU[i*n+j]);
          if (tmp >= max) {
             max = tmp;
             imax = i;
@@ -685,13 +726,18 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
          }
       } else {
          ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
-         if (isAllocated)  delete [] scale;
+         if (isAllocated) {
+            delete [] scale;
+            delete [] colj;
+         }
          return kFALSE;
       }
    }
 
-   if (isAllocated)
+   if (isAllocated) {
       delete [] scale;
+      delete [] colj;
+   }
 
    return kTRUE;
 }
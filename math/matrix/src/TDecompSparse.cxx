@@ -22,6 +22,12 @@ ClassImp(TDecompSparse)
  Solve a sparse symmetric system of linear equations using a method
  based on Gaussian elimination as discussed in Duff and Reid,
  ACM Trans. Math. Software 9 (1983), 302-325.
+ The pivot sequence is chosen in the analysis phase with a minimum degree
+ ordering, which limits the fill-in of the factors.
+
+ For large positive-definite systems the iterative solver
+ SolveConjugateGradient() avoids the factorization altogether; its sparse
+ matrix-vector products run in parallel when implicit multi-threading is enabled.
 */
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -335,6 +341,78 @@ Bool_t TDecompSparse::Decompose()
    return ok;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Solve Ax=b with the Jacobi-preconditioned conjugate gradient method, for a symmetric
+/// positive-definite sparse matrix A. Solution returned in b.
+/// The iteration stops when |b-Ax| < tol*|b| or after maxIter iterations (default 2*n).
+/// Returns kFALSE if the iteration did not converge or A is found not positive definite.
+
+Bool_t TDecompSparse::SolveConjugateGradient(const TMatrixDSparse &a,TVectorD &b,Double_t tol,Int_t maxIter)
+{
+   R__ASSERT(a.IsValid());
+   R__ASSERT(b.IsValid());
+   if (a.GetNrows() != a.GetNcols() || a.GetRowLwb() != a.GetColLwb()) {
+      ::Error("TDecompSparse::SolveConjugateGradient","matrix should be square");
+      return kFALSE;
+   }
+   if (a.GetNrows() != b.GetNrows() || a.GetRowLwb() != b.GetLwb()) {
+      ::Error("TDecompSparse::SolveConjugateGradient","vector and matrix incompatible");
+      return kFALSE;
+   }
+
+   const Int_t n   = a.GetNrows();
+   const Int_t lwb = b.GetLwb();
+   const Int_t upb = b.GetUpb();
+   if (maxIter <= 0) maxIter = 2*n;
+
+   const Double_t bnorm = TMath::Sqrt(b.Norm2Sqr());
+   if (bnorm == 0.0)
+      return kTRUE; // the solution is the null vector b
+
+   // inverse of the diagonal as preconditioner
+   TVectorD invDiag(lwb,upb);
+   invDiag = TMatrixDSparseDiag_const(a);
+   Double_t *pD = invDiag.GetMatrixArray();
+   for (Int_t i = 0; i < n; i++)
+      pD[i] = (pD[i] > 0.0) ? 1.0/pD[i] : 1.0;
+
+   TVectorD x(lwb,upb);
+   TVectorD r = b;
+   TVectorD z = r; ElementMult(z,invDiag);
+   TVectorD p = z;
+   TVectorD ap(lwb,upb);
+   Double_t rz = Dot(r,z);
+
+   Bool_t converged = kFALSE;
+   for (Int_t iter = 0; iter < maxIter; iter++) {
+      Add(ap,0.0,a,p);
+      const Double_t pap = Dot(p,ap);
+      if (pap <= 0.0) {
+         ::Error("TDecompSparse::SolveConjugateGradient","matrix not positive definite");
+         b = x;
+         return kFALSE;
+      }
+      const Double_t alpha = rz/pap;
+      Add(x,alpha,p);
+      Add(r,-alpha,ap);
+      if (TMath::Sqrt(r.Norm2Sqr()) < tol*bnorm) {
+         converged = kTRUE;
+         break;
+      }
+      z = r; ElementMult(z,invDiag);
+      const Double_t rzNew = Dot(r,z);
+      p *= rzNew/rz;
+      p += z;
+      rz = rzNew;
+   }
+
+   if (!converged)
+      ::Warning("TDecompSparse::SolveConjugateGradient","no convergence after %d iterations",maxIter);
+
+   b = x;
+   return converged;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Solve Ax=b . Solution returned in b.
 
@@ -29,6 +29,12 @@
 #include "TMatrixDEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 templateClassImp(TMatrixT)
 
@@ -3070,13 +3076,116 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
    return target;
 }
 
+namespace {
+
+// Products with at least this number of multiply-adds use the cache-blocked kernels below,
+// which run in parallel on the ROOT thread pool when implicit multi-threading is enabled
+const Long64_t kBlockedMultMinOps = 64*64*64;
+// Rows of the result computed per task, and block sizes in the inner (k) and column (j) dimensions
+const Int_t kMultRowBlock   = 32;
+const Int_t kMultInnerBlock = 128;
+const Int_t kMultColBlock   = 512;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the rows [0,nrows) of a product, calling kernel(rowFirst,rowLast) on blocks
+/// of kMultRowBlock rows in parallel when implicit multi-threading is enabled.
+
+template<class Kernel>
+void MultRows(Int_t nrows,Kernel kernel)
+{
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nrows > kMultRowBlock) {
+      const Int_t nblocks = (nrows+kMultRowBlock-1)/kMultRowBlock;
+      auto task = [&](Int_t ib) {
+         kernel(ib*kMultRowBlock,TMath::Min((ib+1)*kMultRowBlock,nrows));
+         return 0;
+      };
+      ROOT::Internal::GetImplicitMTExecutor()->Map(task,ROOT::TSeqI(nblocks));
+      return;
+   }
+#endif
+   kernel(0,nrows);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache-blocked kernel for the rows [rowFirst,rowLast) of C = op(A)*B, with
+/// op(A)(i,k) = ap[i*aRowStride+k*aColStride] and B a nk x ncolsb matrix.
+/// The innermost loop runs over contiguous elements of B and C and can be vectorized,
+/// while each element still accumulates its products in increasing k like the plain loop.
+
+template<class Element>
+void MultRowsBlocked(const Element * const ap,Int_t aRowStride,Int_t aColStride,
+                     const Element * const bp,Int_t nk,Int_t ncolsb,
+                     Element *cp,Int_t rowFirst,Int_t rowLast)
+{
+   for (Int_t i = rowFirst; i < rowLast; i++) {
+      Element * const crp = cp+i*ncolsb;
+      for (Int_t j = 0; j < ncolsb; j++)
+         crp[j] = 0;
+   }
+
+   for (Int_t k0 = 0; k0 < nk; k0 += kMultInnerBlock) {
+      const Int_t k1 = TMath::Min(k0+kMultInnerBlock,nk);
+      for (Int_t j0 = 0; j0 < ncolsb; j0 += kMultColBlock) {
+         const Int_t j1 = TMath::Min(j0+kMultColBlock,ncolsb);
+         for (Int_t i = rowFirst; i < rowLast; i++) {
+            Element * const crp = cp+i*ncolsb;
+            for (Int_t k = k0; k < k1; k++) {
+               const Element aik = ap[i*aRowStride+k*aColStride];
+               const Element * const brp = bp+k*ncolsb;
+               for (Int_t j = j0; j < j1; j++)
+                  crp[j] += aik*brp[j];
+            }
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Cache-blocked kernel for the rows [rowFirst,rowLast) of C = A*B^T, where the rows of
+/// A and the nrowsb rows of B have nk elements. Blocks of rows of B are kept in cache
+/// while the contiguous row-row dot products are computed.
+
+template<class Element>
+void MultRowsBtBlocked(const Element * const ap,const Element * const bp,Int_t nrowsb,Int_t nk,
+                       Element *cp,Int_t rowFirst,Int_t rowLast)
+{
+   const Int_t jblock = TMath::Max(1,kMultInnerBlock*kMultColBlock/TMath::Max(1,nk));
+   for (Int_t j0 = 0; j0 < nrowsb; j0 += jblock) {
+      const Int_t j1 = TMath::Min(j0+jblock,nrowsb);
+      for (Int_t i = rowFirst; i < rowLast; i++) {
+         const Element * const arp = ap+i*nk;
+         Element * const crp = cp+i*nrowsb;
+         for (Int_t j = j0; j < j1; j++) {
+            const Element * const brp = bp+j*nk;
+            Element cij = 0;
+            for (Int_t k = 0; k < nk; k++)
+               cij += arp[k]*brp[k];
+            crp[j] = cij;
+         }
+      }
+   }
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+/// Large products are computed with a cache-blocked kernel, multithreaded when
+/// implicit multi-threading is enabled (ROOT::EnableImplicitMT).
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsa > 0 && Long64_t(na)*ncolsb >= kBlockedMultMinOps) {
+      auto kernel = [&](Int_t rowFirst,Int_t rowLast) {
+         MultRowsBlocked(ap,ncolsa,1,bp,ncolsa,ncolsb,cp,rowFirst,rowLast);
+      };
+      MultRows(na/ncolsa,kernel);
+      return;
+   }
+
    const Element *arp0 = ap;                     // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3095,11 +3204,21 @@ void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A^T*B
+/// Large products are computed with a cache-blocked kernel, multithreaded when
+/// implicit multi-threading is enabled (ROOT::EnableImplicitMT).
 
 template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsb > 0 && Long64_t(ncolsa)*nb >= kBlockedMultMinOps) {
+      auto kernel = [&](Int_t rowFirst,Int_t rowLast) {
+         MultRowsBlocked(ap,1,ncolsa,bp,nb/ncolsb,ncolsb,cp,rowFirst,rowLast);
+      };
+      MultRows(ncolsa,kernel);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+ncolsa) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3119,11 +3238,21 @@ void AtMultB(const Element * const ap,Int_t ncolsa,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B^T
+/// Large products are computed with a cache-blocked kernel, multithreaded when
+/// implicit multi-threading is enabled (ROOT::EnableImplicitMT).
 
 template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsa > 0 && Long64_t(na)*(nb/TMath::Max(1,ncolsb)) >= kBlockedMultMinOps) {
+      auto kernel = [&](Int_t rowFirst,Int_t rowLast) {
+         MultRowsBtBlocked(ap,bp,nb/ncolsb,ncolsb,cp,rowFirst,rowLast);
+      };
+      MultRows(na/ncolsa,kernel);
+      return;
+   }
+
    const Element *arp0 = ap;                    // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       const Element *brp0 = bp;                  // Pointer to  B[j,0];
@@ -81,9 +81,93 @@
 #include "TBuffer.h"
 #include "TMatrixT.h"
 #include "TMath.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include <vector>
+#include "TROOT.h"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 templateClassImp(TMatrixTSparse)
 
+namespace {
+
+// minimum number of result elements (rows x columns) for computing a product in parallel
+// when implicit multi-threading is enabled, and number of rows per task
+const Long64_t kSparseMultParallelMinElements = 1 << 16;
+const Int_t    kSparseMultRowsPerTask         = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the non-zero values elem(irow,icol) of a nrows x ncols product in the sparse
+/// arrays of C, row by row, and return their number. For large products the values of
+/// blocks of rows are computed in parallel when implicit multi-threading is enabled,
+/// and then copied in place.
+
+template<class Element,class ElemFunc>
+Int_t FillProductRows(Int_t nrows,Int_t ncols,ElemFunc elem,Int_t *pRowIndexc,Int_t *pColIndexc,Element *pDatac)
+{
+   Int_t indexc_r = 0;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && Long64_t(nrows)*ncols >= kSparseMultParallelMinElements &&
+       nrows > kSparseMultRowsPerTask) {
+      struct RowBlock {
+         std::vector<Int_t>   fRowEnd;
+         std::vector<Int_t>   fCols;
+         std::vector<Element> fValues;
+      };
+      auto task = [&](Int_t it) {
+         RowBlock block;
+         const Int_t rowLast = TMath::Min((it+1)*kSparseMultRowsPerTask,nrows);
+         for (Int_t irowc = it*kSparseMultRowsPerTask; irowc < rowLast; irowc++) {
+            for (Int_t icolc = 0; icolc < ncols; icolc++) {
+               const Element sum = elem(irowc,icolc);
+               if (sum != 0.0) {
+                  block.fCols.push_back(icolc);
+                  block.fValues.push_back(sum);
+               }
+            }
+            block.fRowEnd.push_back(block.fCols.size());
+         }
+         return block;
+      };
+      std::vector<Int_t> tasks((nrows+kSparseMultRowsPerTask-1)/kSparseMultRowsPerTask);
+      for (UInt_t it = 0; it < tasks.size(); it++)
+         tasks[it] = it;
+      const std::vector<RowBlock> blocks = ROOT::Internal::GetImplicitMTExecutor()->Map(task,tasks);
+
+      Int_t irowc = 0;
+      for (UInt_t it = 0; it < blocks.size(); it++) {
+         const RowBlock &block = blocks[it];
+         Int_t index = 0;
+         for (UInt_t ir = 0; ir < block.fRowEnd.size(); ir++) {
+            for (; index < block.fRowEnd[ir]; index++) {
+               pColIndexc[indexc_r] = block.fCols[index];
+               pDatac[indexc_r] = block.fValues[index];
+               indexc_r++;
+            }
+            pRowIndexc[++irowc] = indexc_r;
+         }
+      }
+      return indexc_r;
+   }
+#endif
+   for (Int_t irowc = 0; irowc < nrows; irowc++) {
+      for (Int_t icolc = 0; icolc < ncols; icolc++) {
+         const Element sum = elem(irowc,icolc);
+         if (sum != 0.0) {
+            pColIndexc[indexc_r] = icolc;
+            pDatac[indexc_r] = sum;
+            indexc_r++;
+         }
+      }
+      pRowIndexc[irowc+1] = indexc_r;
+   }
+   return indexc_r;
+}
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Space is allocated for row/column indices and data, but the sparse structure
@@ -559,33 +643,26 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMa
    const Element * const pDataa = a.GetMatrixArray();
    const Element * const pDatab = b.GetMatrixArray();
    Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
+   auto elem = [&](Int_t irowc,Int_t icolc) {
       const Int_t sIndexa = pRowIndexa[irowc];
       const Int_t eIndexa = pRowIndexa[irowc+1];
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t sIndexb = pRowIndexb[icolc];
-         const Int_t eIndexb = pRowIndexb[icolc+1];
-         Element sum = 0.0;
-         Int_t indexb = sIndexb;
-         for (Int_t indexa = sIndexa; indexa < eIndexa && indexb < eIndexb; indexa++) {
-            const Int_t icola = pColIndexa[indexa];
-            while (indexb < eIndexb && pColIndexb[indexb] <= icola) {
-               if (icola == pColIndexb[indexb]) {
-                 sum += pDataa[indexa]*pDatab[indexb];
-                 break;
-               }
-               indexb++;
+      const Int_t sIndexb = pRowIndexb[icolc];
+      const Int_t eIndexb = pRowIndexb[icolc+1];
+      Element sum = 0.0;
+      Int_t indexb = sIndexb;
+      for (Int_t indexa = sIndexa; indexa < eIndexa && indexb < eIndexb; indexa++) {
+         const Int_t icola = pColIndexa[indexa];
+         while (indexb < eIndexb && pColIndexb[indexb] <= icola) {
+            if (icola == pColIndexb[indexb]) {
+              sum += pDataa[indexa]*pDatab[indexb];
+              break;
             }
-         }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
+            indexb++;
          }
       }
-      pRowIndexc[irowc+1] = indexc_r;
-   }
+      return sum;
+   };
+   const Int_t indexc_r = FillProductRows(this->GetNrows(),this->GetNcols(),elem,pRowIndexc,pColIndexc,pDatac);
 
    if (constr)
       SetSparseIndex(indexc_r);
@@ -658,25 +735,19 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixTSparse<Element> &a,const TMa
    const Element * const pDataa = a.GetMatrixArray();
    const Element * const pDatab = b.GetMatrixArray();
    Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
+   const Int_t ncolsb = b.GetNcols();
+   auto elem = [&](Int_t irowc,Int_t icolc) {
       const Int_t sIndexa = pRowIndexa[irowc];
       const Int_t eIndexa = pRowIndexa[irowc+1];
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t off = icolc*b.GetNcols();
-         Element sum = 0.0;
-         for (Int_t indexa = sIndexa; indexa < eIndexa; indexa++) {
-            const Int_t icola = pColIndexa[indexa];
-            sum += pDataa[indexa]*pDatab[off+icola];
-         }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
-         }
+      const Int_t off = icolc*ncolsb;
+      Element sum = 0.0;
+      for (Int_t indexa = sIndexa; indexa < eIndexa; indexa++) {
+         const Int_t icola = pColIndexa[indexa];
+         sum += pDataa[indexa]*pDatab[off+icola];
       }
-      pRowIndexc[irowc+1]= indexc_r;
-   }
+      return sum;
+   };
+   const Int_t indexc_r = FillProductRows(this->GetNrows(),this->GetNcols(),elem,pRowIndexc,pColIndexc,pDatac);
 
    if (constr)
       SetSparseIndex(indexc_r);
@@ -750,25 +821,19 @@ void TMatrixTSparse<Element>::AMultBt(const TMatrixT<Element> &a,const TMatrixTS
    const Element * const pDataa = a.GetMatrixArray();
    const Element * const pDatab = b.GetMatrixArray();
    Element * const pDatac = this->GetMatrixArray();
-   Int_t indexc_r = 0;
-   for (Int_t irowc = 0; irowc < this->GetNrows(); irowc++) {
-      const Int_t off = irowc*a.GetNcols();
-      for (Int_t icolc = 0; icolc < this->GetNcols(); icolc++) {
-         const Int_t sIndexb = pRowIndexb[icolc];
-         const Int_t eIndexb = pRowIndexb[icolc+1];
-         Element sum = 0.0;
-         for (Int_t indexb = sIndexb; indexb < eIndexb; indexb++) {
-            const Int_t icolb = pColIndexb[indexb];
-            sum += pDataa[off+icolb]*pDatab[indexb];
-         }
-         if (sum != 0.0) {
-            pColIndexc[indexc_r] = icolc;
-            pDatac[indexc_r] = sum;
-            indexc_r++;
-         }
-      }
-      pRowIndexc[irowc+1] = indexc_r;
-   }
+   const Int_t ncolsa = a.GetNcols();
+   auto elem = [&](Int_t irowc,Int_t icolc) {
+      const Int_t off = irowc*ncolsa;
+      const Int_t sIndexb = pRowIndexb[icolc];
+      const Int_t eIndexb = pRowIndexb[icolc+1];
+      Element sum = 0.0;
+      for (Int_t indexb = sIndexb; indexb < eIndexb; indexb++) {
+         const Int_t icolb = pColIndexb[indexb];
+         sum += pDataa[off+icolb]*pDatab[indexb];
+      }
+      return sum;
+   };
+   const Int_t indexc_r = FillProductRows(this->GetNrows(),this->GetNcols(),elem,pRowIndexc,pColIndexc,pDatac);
 
    if (constr)
       SetSparseIndex(indexc_r);
@@ -40,9 +40,66 @@
 #include "TMath.h"
 #include "TROOT.h"
 #include "Varargs.h"
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 
 templateClassImp(TVectorT)
 
+namespace {
+
+// minimum number of non-zero elements of a sparse matrix for computing its product with
+// a vector in parallel when implicit multi-threading is enabled, and number of rows per task
+const Int_t kSparseParallelMinNonZeros = 1 << 15;
+const Int_t kSparseRowsPerTask         = 512;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the row products sum = A(irow,.) * sp of a sparse matrix and pass them to
+/// store(irow,sum). Large matrices are processed in parallel when implicit multi-threading
+/// is enabled and parallel is true (the target must not overlap with sp).
+
+template<class Element,class Store>
+void SparseRowProducts(const TMatrixTSparse<Element> &a,const Element * const sp,Store store,Bool_t parallel)
+{
+   const Int_t   * const pRowIndex = a.GetRowIndexArray();
+   const Int_t   * const pColIndex = a.GetColIndexArray();
+   const Element * const mp        = a.GetMatrixArray();
+
+   auto rows = [&](Int_t rowFirst,Int_t rowLast) {
+      for (Int_t irow = rowFirst; irow < rowLast; irow++) {
+         const Int_t sIndex = pRowIndex[irow];
+         const Int_t eIndex = pRowIndex[irow+1];
+         Element sum = 0.0;
+         for (Int_t index = sIndex; index < eIndex; index++) {
+            const Int_t icol = pColIndex[index];
+            sum += mp[index]*sp[icol];
+         }
+         store(irow,sum);
+      }
+   };
+
+   const Int_t nrows = a.GetNrows();
+#ifdef R__USE_IMT
+   if (parallel && ROOT::IsImplicitMTEnabled() && a.GetNoElements() >= kSparseParallelMinNonZeros &&
+       nrows > kSparseRowsPerTask) {
+      const Int_t ntasks = (nrows+kSparseRowsPerTask-1)/kSparseRowsPerTask;
+      auto task = [&](Int_t it) {
+         rows(it*kSparseRowsPerTask,TMath::Min((it+1)*kSparseRowsPerTask,nrows));
+         return 0;
+      };
+      ROOT::Internal::GetImplicitMTExecutor()->Map(task,ROOT::TSeqI(ntasks));
+      return;
+   }
+#else
+   (void)parallel;
+#endif
+   rows(0,nrows);
+}
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete data pointer m, if it was assigned on the heap
@@ -1048,23 +1105,10 @@ TVectorT<Element> &TVectorT<Element>::operator*=(const TMatrixTSparse<Element> &
    }
    memset(fElements,0,fNrows*sizeof(Element));
 
-   const Int_t   * const pRowIndex = a.GetRowIndexArray();
-   const Int_t   * const pColIndex = a.GetColIndexArray();
-   const Element * const mp        = a.GetMatrixArray();     // Matrix row ptr
-
    const Element * const sp = elements_old;
          Element *       tp = this->GetMatrixArray(); // Target vector ptr
 
-   for (Int_t irow = 0; irow < fNrows; irow++) {
-      const Int_t sIndex = pRowIndex[irow];
-      const Int_t eIndex = pRowIndex[irow+1];
-      Element sum = 0.0;
-      for (Int_t index = sIndex; index < eIndex; index++) {
-         const Int_t icol = pColIndex[index];
-         sum += mp[index]*sp[icol];
-      }
-      tp[irow] = sum;
-   }
+   SparseRowProducts(a,sp,[tp](Int_t irow,Element sum) { tp[irow] = sum; },kTRUE);
 
    if (isAllocated)
       delete [] elements_old;
@@ -1779,58 +1823,19 @@ TVectorT<Element> &Add(TVectorT<Element> &target,Element scalar,
       }
    }
 
-   const Int_t   * const pRowIndex = a.GetRowIndexArray();
-   const Int_t   * const pColIndex = a.GetColIndexArray();
-   const Element * const mp        = a.GetMatrixArray();     // Matrix row ptr
-
    const Element * const sp = source.GetMatrixArray(); // Source vector ptr
          Element *       tp = target.GetMatrixArray(); // Target vector ptr
 
-   if (scalar == 1.0) {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-         const Int_t sIndex = pRowIndex[irow];
-         const Int_t eIndex = pRowIndex[irow+1];
-         Element sum = 0.0;
-         for (Int_t index = sIndex; index < eIndex; index++) {
-            const Int_t icol = pColIndex[index];
-            sum += mp[index]*sp[icol];
-         }
-         tp[irow] += sum;
-      }
-   } else if (scalar == 0.0) {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-         const Int_t sIndex = pRowIndex[irow];
-         const Int_t eIndex = pRowIndex[irow+1];
-         Element sum = 0.0;
-         for (Int_t index = sIndex; index < eIndex; index++) {
-            const Int_t icol = pColIndex[index];
-            sum += mp[index]*sp[icol];
-         }
-         tp[irow]  = sum;
-      }
-   } else if (scalar == -1.0) {
-     for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-        const Int_t sIndex = pRowIndex[irow];
-        const Int_t eIndex = pRowIndex[irow+1];
-        Element sum = 0.0;
-        for (Int_t index = sIndex; index < eIndex; index++) {
-           const Int_t icol = pColIndex[index];
-           sum += mp[index]*sp[icol];
-        }
-        tp[irow] -= sum;
-      }
-   } else {
-      for (Int_t irow = 0; irow < a.GetNrows(); irow++) {
-        const Int_t sIndex = pRowIndex[irow];
-        const Int_t eIndex = pRowIndex[irow+1];
-        Element sum = 0.0;
-        for (Int_t index = sIndex; index < eIndex; index++) {
-           const Int_t icol = pColIndex[index];
-           sum += mp[index]*sp[icol];
-        }
-        tp[irow] += scalar * sum;
-      }
-   }
+   // the rows can only be computed in parallel when the target is not also the source
+   const Bool_t parallel = (sp != tp);
+   if (scalar == 1.0)
+      SparseRowProducts(a,sp,[tp](Int_t irow,Element sum) { tp[irow] += sum; },parallel);
+   else if (scalar == 0.0)
+      SparseRowProducts(a,sp,[tp](Int_t irow,Element sum) { tp[irow] = sum; },parallel);
+   else if (scalar == -1.0)
+      SparseRowProducts(a,sp,[tp](Int_t irow,Element sum) { tp[irow] -= sum; },parallel);
+   else
+      SparseRowProducts(a,sp,[tp,scalar](Int_t irow,Element sum) { tp[irow] += scalar * sum; },parallel);
 
    return target;
 }
@@ -21,6 +21,10 @@
 #include "Minuit2/MnUserParameterState.h"
 #endif
 
+#ifndef ROOT_Minuit2_MinosError
+#include "Minuit2/MinosError.h"
+#endif
+
 #ifndef ROOT_Math_IFunctionfwd
 #include "Math/IFunctionfwd.h"
 #endif
@@ -56,6 +60,13 @@ namespace ROOT {
    Using a string  (used by the plugin manager) or via an enumeration
    an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan and Fumili).
 
+   When ROOT is built with imt support, the extra "Minuit2" integer options "ParallelGradient",
+   "ParallelHessian" and "ParallelMinos" enable the evaluation on the ROOT thread pool of, respectively,
+   the numerical gradient, the Hessian elements in Hesse and the Minos crossings of the
+   parameters requested in GetMinosErrors. The objective function must then be thread safe. The options are ignored for the
+   fit method functions (ROOT::Math::FitMethodFunction, e.g. the chi2 and likelihood functions of
+   ROOT::Fit), which set the parameters of the model function at each evaluation.
+
    @ingroup Minuit
 */
 class Minuit2Minimizer : public ROOT::Math::Minimizer {
@@ -247,9 +258,20 @@ public:
        status = 4    : new minimum found when running for upper error
        status = 5    : any other failure
 
+      With the "ParallelMinos" option the lower and upper crossings are found concurrently and the
+      errors are stored: the following calls with the same tolerance and maximum number of calls
+      return them until the next minimization or Hesse.
    */
    virtual bool GetMinosError(unsigned int i, double & errLow, double & errUp, int = 0);
 
+   /**
+      get the minos errors for the parameters ivars (see GetMinosError).
+      With the "ParallelMinos" option the crossings of all the requested parameters are found
+      concurrently at once.
+   */
+   virtual bool GetMinosErrors(const std::vector<unsigned int> & ivars, std::vector<double> & errLow,
+                               std::vector<double> & errUp, std::vector<bool> & valid);
+
    /**
       scan a parameter i around the minimum. A minimization must have been done before,
       return false if it is not the case
@@ -312,9 +334,13 @@ private:
 
    unsigned int fDim;       // dimension of the function to be minimized
    bool fUseFumili;
+   bool fFitMethodFCN;      // function is a fit method function (cannot be evaluated concurrently)
 
    ROOT::Minuit2::MnUserParameterState fState;
-   // std::vector<ROOT::Minuit2::MinosError> fMinosErrors;
+   std::vector<ROOT::Minuit2::MinosError> fMinosErrors;   // Minos errors found concurrently
+   std::vector<unsigned int> fMinosParams;  // parameters whose Minos errors are requested together
+   int fMinosMaxFcn;                        // maximum number of calls used for fMinosErrors
+   double fMinosTolerance;                  // tolerance used for fMinosErrors
    ROOT::Minuit2::ModularFunctionMinimizer * fMinimizer;
    ROOT::Minuit2::FCNBase * fMinuitFCN;
    ROOT::Minuit2::FunctionMinimum * fMinimum;
@@ -14,6 +14,7 @@
 #include "Minuit2/MnMatrix.h"
 
 #include <vector>
+#include <atomic>
 
 namespace ROOT {
 
@@ -37,6 +38,8 @@ public:
    /// constructor of
    explicit MnFcn(const FCNBase& fcn, int ncall = 0) : fFCN(fcn), fNumCall(ncall) {}
 
+   MnFcn(const MnFcn& fcn) : fFCN(fcn.fFCN), fNumCall(fcn.NumOfCalls()) {}
+
   virtual ~MnFcn();
 
   virtual double operator()(const MnAlgebraicVector&) const;
@@ -56,7 +59,8 @@ private:
 
 protected:
 
-  mutable int fNumCall;
+  // atomic since the function can be called concurrently (e.g. in the parallel gradient calculation)
+  mutable std::atomic<int> fNumCall;
 };
 
   }  // namespace Minuit2
@@ -13,6 +13,7 @@
 #include "Minuit2/MnStrategy.h"
 
 #include <utility>
+#include <vector>
 
 namespace ROOT {
 
@@ -60,6 +61,10 @@ public:
    /// can be printed via std::cout
    MinosError Minos(unsigned int, unsigned int maxcalls = 0, double toler = 0.1) const;
 
+   /// ask for MinosError (Lower + Upper) of a set of parameters
+   /// the crossings are run concurrently if MnStrategy::ParallelMinos() is set
+   std::vector<MinosError> Minos(const std::vector<unsigned int> & pars, unsigned int maxcalls = 0, double toler = 0.1) const;
+
 protected:
 
    /// internal method to get crossing value via MnFunctionCross
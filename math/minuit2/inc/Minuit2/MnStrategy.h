@@ -49,6 +49,14 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   /// flag to compute the numerical gradient in parallel (one task per parameter).
+   /// Requires ROOT built with imt support and a thread-safe FCN
+   bool ParallelGradient() const { return fParallelGradient; }
+   /// flag to compute the diagonal and the off-diagonal Hessian elements in parallel (MnHesse)
+   bool ParallelHessian() const { return fParallelHessian; }
+   /// flag to run the Minos crossings (lower and upper, different parameters) concurrently (MnMinos)
+   bool ParallelMinos() const { return fParallelMinos; }
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +77,14 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // compute the derivatives for the different parameters in parallel using the ROOT thread pool.
+   // Setting it declares that the FCN can be evaluated concurrently. This is not the case for the
+   // ROOT::Fit chi2 and likelihood functions, which modify the parameters of the model function
+   void SetParallelGradient(bool on = true) { fParallelGradient = on; }
+   void SetParallelHessian(bool on = true) { fParallelHessian = on; }
+   void SetParallelMinos(bool on = true) { fParallelMinos = on; }
+
 private:
 
    unsigned int fStrategy;
@@ -81,6 +97,9 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   bool fParallelGradient;
+   bool fParallelHessian;
+   bool fParallelMinos;
 };
 
   }  // namespace Minuit2
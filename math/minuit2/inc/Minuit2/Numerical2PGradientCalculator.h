@@ -18,6 +18,8 @@
 #include "Minuit2/GradientCalculator.h"
 #endif
 
+#include "Minuit2/MnMatrix.h"
+
 #include <vector>
 
 namespace ROOT {
@@ -69,6 +71,11 @@ public:
 
 private:
 
+  /// iterate the two-point derivative of internal parameter i, updating the estimates grd, g2 and gstep.
+  /// x is a work copy of the parameter values (restored on return)
+  void ParameterDerivative(unsigned int i, MnAlgebraicVector& x, double fcnmin, double dfmin, double vrysml,
+                           double& grd, double& g2, double& gstep) const;
+
   const MnFcn& fFcn;
   const MnUserTransformation& fTransformation;
   const MnStrategy& fStrategy;
@@ -45,6 +45,7 @@
 #include <functional>
 
 #ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
 #include "TROOT.h"
 #include "TMinuit2TraceObject.h"
 #endif
@@ -76,15 +77,38 @@ void RestoreGlobalPrintLevel(int value) {
    void RestoreGlobalPrintLevel(int ) {}
 #endif
 
+   // read a flag enabling the parallel execution of a Minuit2 algorithm (e.g. "ParallelGradient")
+   // from the Minuit2 extra options. The FCN must then be thread safe: this is not the case
+   // for the fit method functions, which set the parameters of the shared model function
+   // at each evaluation, so the option is then ignored
+   bool GetParallelOption(const char * name, bool fitMethodFCN) {
+      ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+      int value = 0;
+      if (!minuit2Opt || !minuit2Opt->GetValue(name,value) || !value) return false;
+#ifdef R__USE_IMT
+      if (fitMethodFCN) {
+         MN_INFO_VAL2("Minuit2Minimizer: option is ignored since the fit method function is not thread safe ",name);
+         return false;
+      }
+      return true;
+#else
+      MN_INFO_VAL2("Minuit2Minimizer: option is ignored since ROOT is built without imt support ",name);
+      return false;
+#endif
+   }
+
 
 
 
 Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type ) :
    Minimizer(),
    fDim(0),
+   fFitMethodFCN(false),
    fMinimizer(0),
    fMinuitFCN(0),
-   fMinimum(0)
+   fMinimum(0),
+   fMinosMaxFcn(0),
+   fMinosTolerance(0)
 {
    // Default constructor implementation depending on minimizer type
    SetMinimizerType(type);
@@ -93,9 +117,12 @@ Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type ) :
 Minuit2Minimizer::Minuit2Minimizer(const char *  type ) :
    Minimizer(),
    fDim(0),
+   fFitMethodFCN(false),
    fMinimizer(0),
    fMinuitFCN(0),
-   fMinimum(0)
+   fMinimum(0),
+   fMinosMaxFcn(0),
+   fMinosTolerance(0)
 {
    // constructor from a string
 
@@ -170,6 +197,7 @@ void Minuit2Minimizer::Clear() {
    // clear also the function minimum
    if (fMinimum) delete fMinimum;
    fMinimum = 0;
+   fMinosErrors.clear();
 }
 
 
@@ -345,6 +373,8 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGenFunction & func)
    // set function to be minimized
    if (fMinuitFCN) delete fMinuitFCN;
    fDim = func.NDim();
+   fMinosErrors.clear();
+   fFitMethodFCN = (dynamic_cast<const ROOT::Math::FitMethodFunction *>(&func) != 0);
    if (!fUseFumili) {
       fMinuitFCN = new ROOT::Minuit2::FCNAdapter<ROOT::Math::IMultiGenFunction> (func, ErrorDef() );
    }
@@ -363,6 +393,8 @@ void Minuit2Minimizer::SetFunction(const  ROOT::Math::IMultiGradFunction & func)
    // set function to be minimized
    fDim = func.NDim();
    if (fMinuitFCN) delete fMinuitFCN;
+   fMinosErrors.clear();
+   fFitMethodFCN = (dynamic_cast<const ROOT::Math::FitMethodGradFunction *>(&func) != 0);
    if (!fUseFumili) {
       fMinuitFCN = new ROOT::Minuit2::FCNGradAdapter<ROOT::Math::IMultiGradFunction> (func, ErrorDef() );
    }
@@ -390,6 +422,7 @@ bool Minuit2Minimizer::Minimize() {
    // delete result of previous minimization
    if (fMinimum) delete fMinimum;
    fMinimum = 0;
+   fMinosErrors.clear();
 
 
    int maxfcn = MaxFunctionCalls();
@@ -456,6 +489,10 @@ bool Minuit2Minimizer::Minimize() {
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
 
+      // compute the numerical gradient in parallel (the FCN must be thread safe)
+      strategy.SetParallelGradient(GetParallelOption("ParallelGradient", fFitMethodFCN));
+      strategy.SetParallelHessian(GetParallelOption("ParallelHessian", fFitMethodFCN));
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -790,8 +827,10 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
 
    fMinuitFCN->SetErrorDef(ErrorDef() );
    // if error def has been changed update it in FunctionMinimum
-   if (ErrorDef() != fMinimum->Up() )
+   if (ErrorDef() != fMinimum->Up() ) {
       fMinimum->SetErrorDef(ErrorDef() );
+      fMinosErrors.clear();
+   }
 
    // switch off Minuit2 printing
    int prev_level = (PrintLevel() <= 0 ) ?   TurnOffPrintInfoLevel() : -2;
@@ -800,7 +839,10 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
    if (Precision() > 0) fState.SetPrecision(Precision());
 
 
-   ROOT::Minuit2::MnMinos minos( *fMinuitFCN, *fMinimum);
+   // use the default Minos strategy, with the crossings possibly searched concurrently
+   ROOT::Minuit2::MnStrategy minosStrategy(1);
+   minosStrategy.SetParallelMinos(GetParallelOption("ParallelMinos", fFitMethodFCN));
+   ROOT::Minuit2::MnMinos minos( *fMinuitFCN, *fMinimum, minosStrategy);
 
    // run MnCross
    MnCross low;
@@ -827,10 +869,42 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
    }
 
 
-   if (runLower) low = minos.Loval(i,maxfcn,tol);
-   if (runUpper) up  = minos.Upval(i,maxfcn,tol);
+   // in case both errors are needed MnMinos finds the crossings concurrently, together with the
+   // ones of the other parameters requested in GetMinosErrors. They are stored for the next calls
+   // with the same maximum number of calls and tolerance
+   bool runConcurrent = runLower && runUpper && minosStrategy.ParallelMinos();
+   if (runConcurrent) {
+      if (maxfcn != fMinosMaxFcn || tol != fMinosTolerance) {
+         fMinosErrors.clear();
+         fMinosMaxFcn = maxfcn;
+         fMinosTolerance = tol;
+      }
+      // parameters whose errors are not stored yet
+      std::vector<unsigned int> pars(1, i);
+      for (unsigned int ipar : fMinosParams) {
+         if (ipar >= fState.MinuitParameters().size() || fState.Parameter(ipar).IsConst() || fState.Parameter(ipar).IsFixed() )
+            continue;
+         if (std::find(pars.begin(), pars.end(), ipar) == pars.end()) pars.push_back(ipar);
+      }
+      for (unsigned int k = 0; k < fMinosErrors.size(); ++k) {
+         std::vector<unsigned int>::iterator itr = std::find(pars.begin(), pars.end(), fMinosErrors[k].Parameter());
+         if (itr != pars.end()) pars.erase(itr);
+      }
+      if (!pars.empty() && pars.front() == i) {
+         std::vector<ROOT::Minuit2::MinosError> errors = minos.Minos(pars,maxfcn,tol);
+         fMinosErrors.insert(fMinosErrors.end(), errors.begin(), errors.end());
+      }
+   }
+   else {
+      if (runLower) low = minos.Loval(i,maxfcn,tol);
+      if (runUpper) up  = minos.Upval(i,maxfcn,tol);
+   }
 
    ROOT::Minuit2::MinosError me(i, fMinimum->UserState().Value(i),low, up);
+   if (runConcurrent) {
+      for (unsigned int k = 0; k < fMinosErrors.size(); ++k)
+         if (fMinosErrors[k].Parameter() == i) me = fMinosErrors[k];
+   }
 
    if (prev_level > -2) RestoreGlobalPrintLevel(prev_level);
 
@@ -900,6 +974,17 @@ bool Minuit2Minimizer::GetMinosError(unsigned int i, double & errLow, double & e
    return isValid;
 }
 
+bool Minuit2Minimizer::GetMinosErrors(const std::vector<unsigned int> & ivars, std::vector<double> & errLow,
+                                      std::vector<double> & errUp, std::vector<bool> & valid) {
+   // return the minos errors for the parameters ivars
+   // the parameters are passed to GetMinosError, which with the "ParallelMinos" option
+   // finds the crossings of all of them concurrently at the first call
+   fMinosParams = ivars;
+   bool ok = ROOT::Math::Minimizer::GetMinosErrors(ivars, errLow, errUp, valid);
+   fMinosParams.clear();
+   return ok;
+}
+
 bool Minuit2Minimizer::Scan(unsigned int ipar, unsigned int & nstep, double * x, double * y, double xmin, double xmax) {
    // scan a parameter (variable) around the minimum value
    // the parameters must have been set before
@@ -1037,7 +1122,13 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse( strategy );
+   // compute the off-diagonal elements in parallel if requested (the FCN must be thread safe)
+   ROOT::Minuit2::MnStrategy hesseStrategy(strategy);
+   hesseStrategy.SetParallelHessian(GetParallelOption("ParallelHessian", fFitMethodFCN));
+   ROOT::Minuit2::MnHesse hesse( hesseStrategy );
+
+   // the Minos errors found before refer to the previous covariance matrix
+   fMinosErrors.clear();
 
 
    // case when function minimum exists
@@ -28,8 +28,17 @@
 #define WARNINGMSG
 #endif
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 #include "Minuit2/MPIProcess.h"
 
+#include <memory>
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -130,9 +139,25 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
 
-   for(unsigned int i = 0; i < n; i++) {
+#ifdef R__USE_IMT
+   // thread pool used for both the diagonal and the off-diagonal elements when they are computed
+   // in parallel (the FCN must be thread safe)
+   std::shared_ptr<ROOT::TThreadExecutor> pool;
+   if (fStrategy.ParallelHessian() && n > 1) pool = ROOT::Internal::GetImplicitMTExecutor();
+#endif
 
-      double xtf = x(i);
+   // result of the iterations on the second derivative of a parameter
+   struct DiagonalElement {
+      double g2, grd, gst, yy;
+      unsigned int ncalls;
+      bool failed;          // the second derivative is zero
+   };
+
+   // compute the second derivative of the internal parameter i, using xi as work copy of the
+   // parameter values (restored on return)
+   auto diagonalElement = [&](unsigned int i, MnAlgebraicVector & xi) {
+      DiagonalElement e = { g2(i), grd(i), gst(i), yy(i), 0, false };
+      double xtf = xi(i);
       double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
       double d = fabs(gst(i));
       if(d < dmin) d = dmin;
@@ -141,34 +166,81 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
       std::cout << "\nDerivative parameter  " << i << " d = " << d << " dmin = " << dmin << std::endl;
 #endif
 
-
       for(unsigned int icyc = 0; icyc < Ncycles(); icyc++) {
          double sag = 0.;
          double fs1 = 0.;
          double fs2 = 0.;
          for(unsigned int multpy = 0; multpy < 5; multpy++) {
-            x(i) = xtf + d;
-            fs1 = mfcn(x);
-            x(i) = xtf - d;
-            fs2 = mfcn(x);
-            x(i) = xtf;
+            xi(i) = xtf + d;
+            fs1 = mfcn(xi);
+            xi(i) = xtf - d;
+            fs2 = mfcn(xi);
+            xi(i) = xtf;
+            e.ncalls += 2;
             sag = 0.5*(fs1+fs2-2.*amin);
 
-#ifdef DEBUG
-            std::cout << "cycle " << icyc << " mul " << multpy << "\t sag = " << sag << " d = " << d << std::endl;
-#endif
-            //  Now as F77 Minuit - check taht sag is not zero
-            if (sag != 0) goto L30; // break
+            //  Now as F77 Minuit - check that sag is not zero
+            if (sag != 0) break;
             if(trafo.Parameter(i).HasLimits()) {
-               if(d > 0.5) goto L26;
+               if(d > 0.5) break;
                d *= 10.;
                if(d > 0.5) d = 0.51;
                continue;
             }
             d *= 10.;
          }
+         if (sag == 0) {
+            e.failed = true;
+            return e;
+         }
+
+         double g2bfor = e.g2;
+         e.g2 = 2.*sag/(d*d);
+         e.grd = (fs1-fs2)/(2.*d);
+         e.gst = d;
+         e.yy = fs1;
+         double dlast = d;
+         d = sqrt(2.*aimsag/fabs(e.g2));
+         if(trafo.Parameter(i).HasLimits()) d = std::min(0.5, d);
+         if(d < dmin) d = dmin;
+
+#ifdef DEBUG
+         std::cout << "\t cycle " << icyc << " g1 = " << e.grd << " g2 = " << e.g2 << " step = " << e.gst << " d = " << d
+                   << " diffd = " <<  fabs(d-dlast)/d << " diffg2 = " << fabs(e.g2-g2bfor)/e.g2 << std::endl;
+#endif
+
+         // see if converged
+         if(fabs((d-dlast)/d) < Tolerstp()) break;
+         if(fabs((e.g2-g2bfor)/e.g2) < TolerG2()) break;
+         d = std::min(d, 10.*dlast);
+         d = std::max(d, 0.1*dlast);
+      }
+      return e;
+   };
+
+   // with the thread pool the diagonal elements are all computed first, each on its own copy of the
+   // parameter values. They are then checked in order as in the serial computation, so the resulting
+   // state is the same (only the number of function calls differs when Hesse fails)
+   std::vector<DiagonalElement> diagonal;
+#ifdef R__USE_IMT
+   if (pool) {
+      auto parallelElement = [&](unsigned int i) {
+         MnAlgebraicVector xi = x;
+         return diagonalElement(i, xi);
+      };
+      std::vector<unsigned int> index(n);
+      for (unsigned int i = 0; i < n; i++) index[i] = i;
+      diagonal = pool->Map(parallelElement, index);
+   }
+#endif
+
+   unsigned int ncalls = mfcn.NumOfCalls();
+   for(unsigned int i = 0; i < n; i++) {
+
+      DiagonalElement e = (diagonal.empty()) ? diagonalElement(i, x) : diagonal[i];
+      g2(i) = e.g2;
 
-L26:
+      if (e.failed) {
 #ifdef WARNINGMSG
 
          // get parameter name for i
@@ -186,33 +258,15 @@ L26:
          }
 
          return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
-
-L30:
-            double g2bfor = g2(i);
-         g2(i) = 2.*sag/(d*d);
-         grd(i) = (fs1-fs2)/(2.*d);
-         gst(i) = d;
-         dirin(i) = d;
-         yy(i) = fs1;
-         double dlast = d;
-         d = sqrt(2.*aimsag/fabs(g2(i)));
-         if(trafo.Parameter(i).HasLimits()) d = std::min(0.5, d);
-         if(d < dmin) d = dmin;
-
-#ifdef DEBUG
-         std::cout << "\t g1 = " << grd(i) << " g2 = " << g2(i) << " step = " << gst(i) << " d = " << d
-                   << " diffd = " <<  fabs(d-dlast)/d << " diffg2 = " << fabs(g2(i)-g2bfor)/g2(i) << std::endl;
-#endif
-
-
-         // see if converged
-         if(fabs((d-dlast)/d) < Tolerstp()) break;
-         if(fabs((g2(i)-g2bfor)/g2(i)) < TolerG2()) break;
-         d = std::min(d, 10.*dlast);
-         d = std::max(d, 0.1*dlast);
       }
+
+      grd(i) = e.grd;
+      gst(i) = e.gst;
+      dirin(i) = e.gst;
+      yy(i) = e.yy;
       vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
+      ncalls += e.ncalls;
+      if(ncalls > maxcalls) {
 
 #ifdef WARNINGMSG
          //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
@@ -244,6 +298,57 @@ L30:
    }
 
    //off-diagonal Elements
+#ifdef R__USE_IMT
+   if (pool && n > 2) {
+      // the n*(n-1)/2 off-diagonal elements, taken row by row, are split in n-1 chunks of the same
+      // size computed in parallel. Each chunk works on its own copy of the parameter values
+      unsigned int nelem = n*(n-1)/2;
+      unsigned int nchunks = n-1;
+      auto offDiagonalChunk = [&](unsigned int ichunk) {
+         unsigned int begin = (unsigned long long) nelem * ichunk / nchunks;
+         unsigned int end = (unsigned long long) nelem * (ichunk + 1) / nchunks;
+         // row and column of the first element of the chunk
+         unsigned int i = 0;
+         unsigned int rowBegin = 0;
+         while (rowBegin + (n-1-i) <= begin) {
+            rowBegin += n-1-i;
+            i++;
+         }
+         unsigned int j = i + 1 + (begin - rowBegin);
+         MnAlgebraicVector xi = x;
+         std::vector<double> elems;
+         elems.reserve(end - begin);
+         for (unsigned int k = begin; k < end; k++) {
+            xi(i) = x(i) + dirin(i);
+            xi(j) = x(j) + dirin(j);
+            double fs1 = mfcn(xi);
+            elems.push_back( (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j)) );
+            xi(i) = x(i);
+            xi(j) = x(j);
+            if (++j == n) {
+               i++;
+               j = i+1;
+            }
+         }
+         return elems;
+      };
+      std::vector<unsigned int> chunks(nchunks);
+      for (unsigned int ichunk = 0; ichunk < nchunks; ichunk++) chunks[ichunk] = ichunk;
+      std::vector<std::vector<double> > elems = pool->Map(offDiagonalChunk, chunks);
+      unsigned int i = 0;
+      unsigned int j = 1;
+      for (unsigned int ichunk = 0; ichunk < nchunks; ichunk++) {
+         for (unsigned int k = 0; k < elems[ichunk].size(); k++) {
+            vhmat(i,j) = elems[ichunk][k];
+            if (++j == n) {
+               i++;
+               j = i+1;
+            }
+         }
+      }
+   }
+   else {
+#endif
    // initial starting values
    MPIProcess mpiprocOffDiagonal(n*(n-1)/2,0);
    unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
@@ -277,6 +382,9 @@ L30:
    }
 
    mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
+#ifdef R__USE_IMT
+   }
+#endif
 
    //verify if matrix pos-def (still 2nd derivative)
 
@@ -20,6 +20,13 @@
 #include "Minuit2/MnPrint.h"
 #endif
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 
 namespace ROOT {
 
@@ -91,6 +98,14 @@ MinosError MnMinos::Minos(unsigned int par, unsigned int maxcalls, double toler)
    assert(!fMinimum.UserState().Parameter(par).IsFixed());
    assert(!fMinimum.UserState().Parameter(par).IsConst());
 
+#ifdef R__USE_IMT
+   if (fStrategy.ParallelMinos()) {
+      // find the lower and upper crossings concurrently
+      std::vector<unsigned int> pars(1, par);
+      return Minos(pars, maxcalls, toler).front();
+   }
+#endif
+
    MnCross up = Upval(par, maxcalls,toler);
 #ifdef DEBUG
    std::cout << "Function calls to find upper error " << up.NFcn() << std::endl;
@@ -106,6 +121,36 @@ MinosError MnMinos::Minos(unsigned int par, unsigned int maxcalls, double toler)
 }
 
 
+std::vector<MinosError> MnMinos::Minos(const std::vector<unsigned int> & pars, unsigned int maxcalls, double toler) const {
+   // do full minos error analysis (lower + upper) for the given parameters.
+   // If the strategy requests it (MnStrategy::SetParallelMinos) and ROOT is built with imt support
+   // all the crossings are searched concurrently using the ROOT thread pool. Every crossing uses its
+   // own copy of the parameter state and of the minimizer, the FCN must be thread safe
+   std::vector<MinosError> result;
+   result.reserve(pars.size());
+
+#ifdef R__USE_IMT
+   if (fStrategy.ParallelMinos()) {
+      // task 2*k finds the lower crossing, task 2*k+1 the upper crossing of parameter pars[k]
+      std::vector<unsigned int> tasks(2*pars.size());
+      for (unsigned int k = 0; k < tasks.size(); k++) tasks[k] = k;
+      auto crossing = [&](unsigned int k) {
+         return FindCrossValue( (k%2 == 0) ? -1 : 1, pars[k/2], maxcalls, toler);
+      };
+      std::vector<MnCross> crosses = ROOT::Internal::GetImplicitMTExecutor()->Map(crossing, tasks);
+      for (unsigned int k = 0; k < pars.size(); k++)
+         result.push_back(MinosError(pars[k], fMinimum.UserState().Value(pars[k]), crosses[2*k], crosses[2*k+1]) );
+      return result;
+   }
+#endif
+
+   for (unsigned int k = 0; k < pars.size(); k++) {
+      MnCross up = Upval(pars[k], maxcalls,toler);
+      MnCross lo = Loval(pars[k], maxcalls,toler);
+      result.push_back(MinosError(pars[k], fMinimum.UserState().Value(pars[k]), lo, up) );
+   }
+   return result;
+}
 MnCross MnMinos::FindCrossValue(int direction, unsigned int par, unsigned int maxcalls, double toler) const {
    // get crossing value in the parameter direction :
    // direction = + 1 upper value
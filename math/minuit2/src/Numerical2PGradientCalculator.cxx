@@ -31,6 +31,13 @@
 
 #include <math.h>
 
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 #include "Minuit2/MPIProcess.h"
 
 namespace ROOT {
@@ -94,16 +101,12 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    //    std::cout << " ncycle " << Ncycle() << std::endl;
 
    unsigned int n = (par.Vec()).size();
-   unsigned int ncycle = Ncycle();
+
    //   MnAlgebraicVector vgrd(n), vgrd2(n), vgstp(n);
    MnAlgebraicVector grd = Gradient.Grad();
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
-#ifndef _OPENMP
-   MPIProcess mpiproc(n,0);
-#endif
-
 #ifdef DEBUG
    std::cout << "Calculating Gradient at x =   " << par.Vec() << std::endl;
    int pr = std::cout.precision(13);
@@ -111,6 +114,34 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
+#ifdef R__USE_IMT
+   if (Strategy().ParallelGradient() && n > 1) {
+      // compute the derivatives of the different parameters in parallel using the ROOT thread pool.
+      // The FCN must be thread safe. Each task uses its own copy of the parameter values and the
+      // result is identical to the serial one
+      struct Derivative { double grd, g2, gstep; };
+      auto derivative = [&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         Derivative d = { grd(i), g2(i), gstep(i) };
+         ParameterDerivative(i, x, fcnmin, dfmin, vrysml, d.grd, d.g2, d.gstep);
+         return d;
+      };
+      std::vector<unsigned int> index(n);
+      for (unsigned int i = 0; i < n; i++) index[i] = i;
+      std::vector<Derivative> result = ROOT::Internal::GetImplicitMTExecutor()->Map(derivative, index);
+      for (unsigned int i = 0; i < n; i++) {
+         grd(i) = result[i].grd;
+         g2(i) = result[i].g2;
+         gstep(i) = result[i].gstep;
+      }
+      return FunctionGradient(grd, g2, gstep);
+   }
+#endif
+
+#ifndef _OPENMP
+   MPIProcess mpiproc(n,0);
+#endif
+
 #ifndef _OPENMP
    // for serial execution this can be outside the loop
    MnAlgebraicVector x = par.Vec();
@@ -142,62 +173,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       MnAlgebraicVector x = par.Vec();
 #endif
 
-      double xtf = x(i);
-      double epspri = eps2 + fabs(grd(i)*eps2);
-      double stepb4 = 0.;
-      for(unsigned int j = 0; j < ncycle; j++)  {
-         double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
-         double step = std::max(optstp, fabs(0.1*gstep(i)));
-         //       std::cout<<"step: "<<step;
-         if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
-            if(step > 0.5) step = 0.5;
-         }
-         double stpmax = 10.*fabs(gstep(i));
-         if(step > stpmax) step = stpmax;
-         //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
-         if(step < stpmin) step = stpmin;
-         //       std::cout<<" "<<step<<std::endl;
-         //       std::cout<<"step: "<<step<<std::endl;
-         if(fabs((step-stepb4)/step) < StepTolerance()) {
-            //    std::cout<<"(step-stepb4)/step"<<std::endl;
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            break;
-         }
-         gstep(i) = step;
-         stepb4 = step;
-         //       MnAlgebraicVector pstep(n);
-         //       pstep(i) = step;
-         //       double fs1 = Fcn()(pstate + pstep);
-         //       double fs2 = Fcn()(pstate - pstep);
-
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
-
-         double grdb4 = grd(i);
-         grd(i) = 0.5*(fs1 - fs2)/step;
-         g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
-
-#ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
-                   << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
-         std::cout.precision(pr);
-#endif
-
-         if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
-            //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
-            break;
-         }
-      }
-
+      ParameterDerivative(i, x, fcnmin, dfmin, vrysml, grd(i), g2(i), gstep(i));
 
 #ifdef DEBUG_MP
 #pragma omp critical
@@ -228,6 +204,72 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    return FunctionGradient(grd, g2, gstep);
 }
 
+void Numerical2PGradientCalculator::ParameterDerivative(unsigned int i, MnAlgebraicVector& x, double fcnmin, double dfmin, double vrysml,
+                                                        double& grd, double& g2, double& gstep) const {
+   // iterate the two-point derivative of the internal parameter i until the step or the
+   // gradient value converge (or the maximum number of cycles is reached)
+
+   double eps2 = Precision().Eps2();
+   unsigned int ncycle = Ncycle();
+
+   double xtf = x(i);
+   double epspri = eps2 + fabs(grd*eps2);
+   double stepb4 = 0.;
+   for(unsigned int j = 0; j < ncycle; j++)  {
+      double optstp = sqrt(dfmin/(fabs(g2)+epspri));
+      double step = std::max(optstp, fabs(0.1*gstep));
+      //       std::cout<<"step: "<<step;
+      if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
+         if(step > 0.5) step = 0.5;
+      }
+      double stpmax = 10.*fabs(gstep);
+      if(step > stpmax) step = stpmax;
+      //       std::cout<<" "<<step;
+      double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+      if(step < stpmin) step = stpmin;
+      //       std::cout<<" "<<step<<std::endl;
+      //       std::cout<<"step: "<<step<<std::endl;
+      if(fabs((step-stepb4)/step) < StepTolerance()) {
+         //    std::cout<<"(step-stepb4)/step"<<std::endl;
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         break;
+      }
+      gstep = step;
+      stepb4 = step;
+      //       MnAlgebraicVector pstep(n);
+      //       pstep(i) = step;
+      //       double fs1 = Fcn()(pstate + pstep);
+      //       double fs2 = Fcn()(pstate - pstep);
+
+      x(i) = xtf + step;
+      double fs1 = Fcn()(x);
+      x(i) = xtf - step;
+      double fs2 = Fcn()(x);
+      x(i) = xtf;
+
+      double grdb4 = grd;
+      grd = 0.5*(fs1 - fs2)/step;
+      g2 = (fs1 + fs2 - 2.*fcnmin)/step/step;
+
+#ifdef DEBUG
+      int pr = std::cout.precision(13);
+      std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
+                << " grd " << grd << " g2 " << g2 << std::endl;
+      std::cout.precision(pr);
+#endif
+
+      if(fabs(grdb4-grd)/(fabs(grd)+dfmin/step) < GradTolerance())  {
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
+         //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
+         break;
+      }
+   }
+}
+
+
 const MnMachinePrecision& Numerical2PGradientCalculator::Precision() const {
    // return global precision (set in transformation)
    return fTransformation.Precision();
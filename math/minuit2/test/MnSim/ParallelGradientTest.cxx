@@ -0,0 +1,106 @@
+// @(#)root/minuit2:$Id$
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnUserFcn.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/Numerical2PGradientCalculator.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+// test of the parallel computation of the numerical gradient (MnStrategy::SetParallelGradient).
+// The derivatives of the parameters are computed independently of each other, so the gradient
+// and the minimum found by Migrad must be identical to the serial ones.
+// Without imt support the serial computation is done in both cases
+
+using namespace ROOT::Minuit2;
+
+// thread-safe function of npar coupled parameters
+struct CoupledFCN : public FCNBase {
+
+   double operator()(const std::vector<double> & p) const {
+      double f = 0;
+      unsigned int n = p.size();
+      for (unsigned int i = 0; i < n; ++i) {
+         double d = p[i] - 0.5 * i;
+         f += (1. + 0.1 * i) * d * d + 0.01 * std::pow(d, 4);
+         if (i + 1 < n) f += 0.2 * p[i] * p[i+1];
+      }
+      return f;
+   }
+
+   double Up() const { return 1.; }
+};
+
+int main() {
+
+   const unsigned int npar = 20;
+
+   CoupledFCN fcn;
+
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < npar; ++i) {
+      char name[10];
+      snprintf(name, 10, "p%d", i);
+      upar.Add(name, 1. + 0.1 * i, 0.1);
+   }
+   // a parameter with limits, to use the transformation
+   upar.SetLimits("p3", -10., 10.);
+
+   int iret = 0;
+
+   // gradient at the starting point
+   MnUserParameterState state(upar);
+   MnUserFcn mfcn(fcn, state.Trafo());
+   MnStrategy serial(1);
+   MnStrategy parallel(1);
+   parallel.SetParallelGradient();
+
+   Numerical2PGradientCalculator gcSerial(mfcn, state.Trafo(), serial);
+   Numerical2PGradientCalculator gcParallel(mfcn, state.Trafo(), parallel);
+   // compute it more than once, since the thread pool is reused by the calculator
+   for (int itry = 0; itry < 3; ++itry) {
+      FunctionGradient g1 = gcSerial(state.IntParameters());
+      FunctionGradient g2 = gcParallel(state.IntParameters());
+      for (unsigned int i = 0; i < npar; ++i) {
+         if (g1.Grad()(i) != g2.Grad()(i) || g1.G2()(i) != g2.G2()(i) || g1.Gstep()(i) != g2.Gstep()(i)) {
+            std::cerr << "ParallelGradientTest: gradient differs for parameter " << i << " : "
+                      << g1.Grad()(i) << "  " << g2.Grad()(i) << std::endl;
+            iret = 1;
+         }
+      }
+   }
+
+   // full minimization
+   MnMigrad migrad1(fcn, upar, serial);
+   FunctionMinimum min1 = migrad1();
+   MnMigrad migrad2(fcn, upar, parallel);
+   FunctionMinimum min2 = migrad2();
+
+   if (!min1.IsValid() || !min2.IsValid()) {
+      std::cerr << "ParallelGradientTest: minimization failed" << std::endl;
+      iret = 2;
+   }
+   if (min1.Fval() != min2.Fval() || min1.NFcn() != min2.NFcn()) {
+      std::cerr << "ParallelGradientTest: different minimum " << min1.Fval() << "  " << min2.Fval()
+                << " number of calls " << min1.NFcn() << "  " << min2.NFcn() << std::endl;
+      iret = 3;
+   }
+   for (unsigned int i = 0; i < npar; ++i) {
+      if (min1.UserState().Value(i) != min2.UserState().Value(i)) {
+         std::cerr << "ParallelGradientTest: different value for parameter " << i << " : "
+                   << min1.UserState().Value(i) << "  " << min2.UserState().Value(i) << std::endl;
+         iret = 3;
+      }
+   }
+
+   if (iret == 0)
+      std::cout << "ParallelGradientTest: parallel and serial gradients are identical (fval = " << min2.Fval()
+                << " , nfcn = " << min2.NFcn() << ")" << std::endl;
+   return iret;
+}
@@ -0,0 +1,118 @@
+// @(#)root/minuit2:$Id$
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnUserParameters.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnMinos.h"
+#include "Minuit2/MinosError.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+// test of the parallel Hesse (MnStrategy::SetParallelHessian) and of the concurrent Minos
+// crossings (MnStrategy::SetParallelMinos).
+// The second derivatives and the Minos errors must be identical to the serial ones, while the
+// off-diagonal elements can differ in the last digits since the parameter values are restored
+// exactly in the parallel computation.
+// Without imt support the serial computation is done in both cases
+
+using namespace ROOT::Minuit2;
+
+// thread-safe function of npar coupled parameters
+struct CoupledFCN : public FCNBase {
+
+   double operator()(const std::vector<double> & p) const {
+      double f = 0;
+      unsigned int n = p.size();
+      for (unsigned int i = 0; i < n; ++i) {
+         double d = p[i] - 0.5 * i;
+         f += (1. + 0.1 * i) * d * d + 0.01 * std::pow(d, 4);
+         if (i + 1 < n) f += 0.2 * p[i] * p[i+1];
+      }
+      return f;
+   }
+
+   double Up() const { return 1.; }
+};
+
+int main() {
+
+   const unsigned int npar = 8;
+
+   CoupledFCN fcn;
+
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < npar; ++i) {
+      char name[10];
+      snprintf(name, 10, "p%d", i);
+      upar.Add(name, 1. + 0.1 * i, 0.1);
+   }
+   upar.SetLimits("p3", -10., 10.);
+
+   int iret = 0;
+
+   MnMigrad migrad(fcn, upar);
+   FunctionMinimum min = migrad();
+   if (!min.IsValid()) {
+      std::cerr << "ParallelHesseTest: minimization failed" << std::endl;
+      return 1;
+   }
+
+   // Hesse
+   MnStrategy serial(1);
+   MnStrategy parallel(1);
+   parallel.SetParallelHessian();
+   parallel.SetParallelMinos();
+
+   MnUserParameterState st1 = MnHesse(serial)(fcn, min.UserState());
+   MnUserParameterState st2 = MnHesse(parallel)(fcn, min.UserState());
+   if (!st1.HasCovariance() || !st2.HasCovariance()) {
+      std::cerr << "ParallelHesseTest: Hesse failed" << std::endl;
+      return 2;
+   }
+   for (unsigned int i = 0; i < npar; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         double c1 = st1.Covariance()(i,j);
+         double c2 = st2.Covariance()(i,j);
+         if (std::abs(c1 - c2) > 1.E-8 * std::sqrt(st1.Covariance()(i,i) * st1.Covariance()(j,j)) ) {
+            std::cerr << "ParallelHesseTest: covariance differs for (" << i << "," << j << ") : "
+                      << c1 << "  " << c2 << std::endl;
+            iret = 3;
+         }
+      }
+   }
+
+   // Minos for all the parameters
+   std::vector<unsigned int> pars(npar);
+   for (unsigned int i = 0; i < npar; ++i) pars[i] = i;
+   MnMinos minos1(fcn, min, serial);
+   MnMinos minos2(fcn, min, parallel);
+   std::vector<MinosError> me1 = minos1.Minos(pars);
+   std::vector<MinosError> me2 = minos2.Minos(pars);
+   for (unsigned int i = 0; i < npar; ++i) {
+      if (!me1[i].IsValid() || !me2[i].IsValid() || me1[i].Parameter() != i || me2[i].Parameter() != i) {
+         std::cerr << "ParallelHesseTest: invalid Minos error for parameter " << i << std::endl;
+         iret = 4;
+      }
+      else if (me1[i].Lower() != me2[i].Lower() || me1[i].Upper() != me2[i].Upper() ) {
+         std::cerr << "ParallelHesseTest: Minos error differs for parameter " << i << " : "
+                   << me1[i].Lower() << "  " << me2[i].Lower() << " , "
+                   << me1[i].Upper() << "  " << me2[i].Upper() << std::endl;
+         iret = 4;
+      }
+   }
+   // the single parameter analysis gives the same result
+   MinosError me = minos2.Minos(npar-1);
+   if (me.Lower() != me1[npar-1].Lower() || me.Upper() != me1[npar-1].Upper() ) {
+      std::cerr << "ParallelHesseTest: Minos error differs for parameter " << npar-1 << std::endl;
+      iret = 5;
+   }
+
+   if (iret == 0)
+      std::cout << "ParallelHesseTest: parallel and serial Hesse and Minos results agree" << std::endl;
+   return iret;
+}
@@ -12,6 +12,8 @@
 
 #include "TLorentzVector.h"
 
+class TRandom;
+
 class TGenPhaseSpace : public TObject {
 private:
    Int_t        fNt;             // number of decay particles
@@ -21,7 +23,9 @@ private:
    Double_t     fWtMax;          // maximum weigth
    TLorentzVector  fDecPro[18];  //kinematics of the generated particles
 
-   Double_t PDK(Double_t a, Double_t b, Double_t c);
+   Double_t PDK(Double_t a, Double_t b, Double_t c) const;
+   void     GenerateRange(Int_t first, Int_t nevents, Long64_t stride, Double_t *weights, Double_t *px,
+                          Double_t *py, Double_t *pz, Double_t *e, TRandom *rndm) const;
 
 public:
    TGenPhaseSpace(): fNt(0), fMass(), fBeta(), fTeCmTm(0.), fWtMax(0.) {}
@@ -31,6 +35,10 @@ public:
 
    Bool_t          SetDecay(TLorentzVector &P, Int_t nt, const Double_t *mass, Option_t *opt="");
    Double_t        Generate();
+   void            GenerateBatch(Int_t nevents, Double_t *weights, Double_t *px, Double_t *py,
+                                 Double_t *pz, Double_t *e, TRandom *rndm = 0) const;
+   void            GenerateParallel(Int_t nevents, Double_t *weights, Double_t *px, Double_t *py,
+                                    Double_t *pz, Double_t *e, ULong64_t seed = 1) const;
    TLorentzVector *GetDecay(Int_t n);
 
    Int_t    GetNt()      const { return fNt;}
@@ -17,22 +17,34 @@
 
 see example of use in PhaseSpace.C
 
+Large samples can be generated with GenerateBatch, which fills arrays with
+the momenta and the weights of many events, or with GenerateParallel, which
+in addition generates the events in parallel when implicit multi-threading is enabled.
+
 Note that Momentum, Energy units are Gev/C, GeV
 */
 
 #include "TGenPhaseSpace.h"
 #include "TRandom.h"
+#include "TRandomPhilox.h"
 #include "TMath.h"
 #include <stdlib.h>
+#include <vector>
+#include <algorithm>
 
 const Int_t kMAXP = 18;
 
+namespace {
+   // number of events generated together by GenerateBatch
+   const Int_t kPhaseSpaceChunk = 64;
+}
+
 ClassImp(TGenPhaseSpace)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// The PDK function.
 
-Double_t TGenPhaseSpace::PDK(Double_t a, Double_t b, Double_t c)
+Double_t TGenPhaseSpace::PDK(Double_t a, Double_t b, Double_t c) const
 {
    Double_t x = (a-b-c)*(a+b+c)*(a-b+c)*(a+b-c);
    x = TMath::Sqrt(x)/(2*a);
@@ -168,6 +180,200 @@ Double_t TGenPhaseSpace::Generate()
    return wt;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate nevents random final states.
+///
+/// The weights of the events are stored in weights[i] and the four-momenta of the
+/// decay products in px, py, pz and e, which must have a size of nevents*GetNt():
+/// the momentum of the decay product n in the event i is at position n*nevents + i.
+/// The random numbers are taken from rndm (gRandom by default); the events are
+/// not the same as the ones produced by successive calls to Generate(), since the
+/// random numbers are used in a different order.
+///
+/// The events are generated in blocks with the same sequence of operations for all
+/// the events of a block; the loops over the events of a block (rotations and
+/// boosts of the decay products) can be vectorized by the compiler.
+/// GenerateBatch does not modify the generator, it can be called concurrently
+/// from several threads with different random number generators.
+///
+/// Note that Momentum, Energy units are Gev/C, GeV
+
+void TGenPhaseSpace::GenerateBatch(Int_t nevents, Double_t *weights, Double_t *px, Double_t *py,
+                                   Double_t *pz, Double_t *e, TRandom *rndm) const
+{
+   if (!rndm) rndm = gRandom;
+   GenerateRange(0, nevents, nevents, weights, px, py, pz, e, rndm);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate nevents random final states, as GenerateBatch, with the random numbers
+/// of the substreams of TRandomPhilox::GenerateStreams initialized with seed, which
+/// generates the groups of events in parallel when implicit multi-threading is enabled.
+
+void TGenPhaseSpace::GenerateParallel(Int_t nevents, Double_t *weights, Double_t *px, Double_t *py,
+                                      Double_t *pz, Double_t *e, ULong64_t seed) const
+{
+   TRandomPhilox::GenerateStreams(seed, nevents, [&](TRandomPhilox &rndm, Long64_t first, Long64_t n) {
+      GenerateRange(first, n, nevents, weights, px, py, pz, e, &rndm);
+   });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the events first ... first+nevents-1 of the output arrays, where the
+/// momenta of a decay product are stored with the given stride (see GenerateBatch).
+/// The stride is a 64 bit integer, since the offsets fNt*stride of the last decay
+/// products can exceed the range of Int_t for large samples.
+
+void TGenPhaseSpace::GenerateRange(Int_t first, Int_t nevents, Long64_t stride, Double_t *weights,
+                                   Double_t *px, Double_t *py, Double_t *pz, Double_t *e,
+                                   TRandom *rndm) const
+{
+   if (fNt < 2 || nevents <= 0) return;
+
+   // fNt-2 random numbers for the invariant masses and 2 for each rotation
+   const Int_t nrnd = 3*fNt - 4;
+   std::vector<Double_t> rnd(nrnd*kPhaseSpaceChunk);
+
+   Double_t invMas[kMAXP][kPhaseSpaceChunk];
+   Double_t pd[kMAXP][kPhaseSpaceChunk];
+   Double_t cZ[kPhaseSpaceChunk], sZ[kPhaseSpaceChunk], cY[kPhaseSpaceChunk], sY[kPhaseSpaceChunk];
+   Double_t by[kPhaseSpaceChunk], gy[kPhaseSpaceChunk], gy2[kPhaseSpaceChunk];
+
+   // betas of the final boost
+   const Double_t b2 = fBeta[0]*fBeta[0] + fBeta[1]*fBeta[1] + fBeta[2]*fBeta[2];
+   const Double_t gamma = 1.0 / TMath::Sqrt(1.0 - b2);
+   const Double_t gamma2 = b2 > 0 ? (gamma - 1.0)/b2 : 0.0;
+
+   for (Int_t i0 = first; i0 < first + nevents; i0 += kPhaseSpaceChunk) {
+      const Int_t nev = std::min(kPhaseSpaceChunk, first + nevents - i0);
+      rndm->RndmArray(nrnd*nev, rnd.data());
+      // the random number r of the event k is rnd[r*nev + k]
+      const Double_t *r = rnd.data();
+      Int_t n, k;
+
+      //
+      //-----> sorted random numbers (insertion sort of each event)
+      //
+      for (k=0; k<nev; k++) {
+         invMas[0][k] = 0;
+         invMas[fNt-1][k] = 1;
+      }
+      for (n=1; n<fNt-1; n++) {
+         for (k=0; k<nev; k++) invMas[n][k] = r[(n-1)*nev + k];
+      }
+      for (k=0; k<nev; k++) {
+         for (n=2; n<fNt-1; n++) {
+            const Double_t x = invMas[n][k];
+            Int_t m = n;
+            for ( ; m > 1 && invMas[m-1][k] > x; m--) invMas[m][k] = invMas[m-1][k];
+            invMas[m][k] = x;
+         }
+      }
+      r += (fNt-2)*nev;
+
+      Double_t sum = 0;
+      for (n=0; n<fNt; n++) {
+         sum += fMass[n];
+         for (k=0; k<nev; k++) invMas[n][k] = invMas[n][k]*fTeCmTm + sum;
+      }
+
+      //
+      //-----> compute the weights of the events
+      //
+      Double_t *wt = weights + i0;
+      for (k=0; k<nev; k++) wt[k] = fWtMax;
+      for (n=0; n<fNt-1; n++) {
+         for (k=0; k<nev; k++) {
+            pd[n][k] = PDK(invMas[n+1][k], invMas[n][k], fMass[n+1]);
+            wt[k] *= pd[n][k];
+         }
+      }
+
+      //
+      //-----> complete specification of the events (Raubold-Lynch method)
+      //
+      {
+         Double_t *x = px + i0, *y = py + i0, *z = pz + i0, *t = e + i0;
+         for (k=0; k<nev; k++) {
+            x[k] = 0;
+            y[k] = pd[0][k];
+            z[k] = 0;
+            t[k] = TMath::Sqrt(pd[0][k]*pd[0][k] + fMass[0]*fMass[0]);
+         }
+      }
+      for (Int_t i=1; i<fNt; i++) {
+         {
+            Double_t *x = px + i*stride + i0, *y = py + i*stride + i0;
+            Double_t *z = pz + i*stride + i0, *t = e + i*stride + i0;
+            for (k=0; k<nev; k++) {
+               x[k] = 0;
+               y[k] = -pd[i-1][k];
+               z[k] = 0;
+               t[k] = TMath::Sqrt(pd[i-1][k]*pd[i-1][k] + fMass[i]*fMass[i]);
+            }
+         }
+
+         for (k=0; k<nev; k++) {
+            cZ[k] = 2*r[k] - 1;
+            sZ[k] = TMath::Sqrt(1 - cZ[k]*cZ[k]);
+            const Double_t angY = 2*TMath::Pi() * r[nev + k];
+            cY[k] = TMath::Cos(angY);
+            sY[k] = TMath::Sin(angY);
+         }
+         r += 2*nev;
+
+         // rotation around Z and around Y
+         for (Int_t j=0; j<=i; j++) {
+            Double_t *x = px + j*stride + i0, *y = py + j*stride + i0, *z = pz + j*stride + i0;
+            for (k=0; k<nev; k++) {
+               const Double_t x0 = x[k];
+               const Double_t y0 = y[k];
+               const Double_t x1 = cZ[k]*x0 - sZ[k]*y0;
+               y[k] = sZ[k]*x0 + cZ[k]*y0;
+               const Double_t z0 = z[k];
+               x[k] = cY[k]*x1 - sY[k]*z0;
+               z[k] = sY[k]*x1 + cY[k]*z0;
+            }
+         }
+
+         if (i == fNt-1) break;
+
+         // boost along Y with beta = pd[i] / sqrt(pd[i]*pd[i] + invMas[i]*invMas[i])
+         for (k=0; k<nev; k++) {
+            by[k] = pd[i][k] / TMath::Sqrt(pd[i][k]*pd[i][k] + invMas[i][k]*invMas[i][k]);
+            const Double_t by2 = by[k]*by[k];
+            gy[k] = 1.0 / TMath::Sqrt(1.0 - by2);
+            gy2[k] = by2 > 0 ? (gy[k] - 1.0)/by2 : 0.0;
+         }
+         for (Int_t j=0; j<=i; j++) {
+            Double_t *y = py + j*stride + i0, *t = e + j*stride + i0;
+            for (k=0; k<nev; k++) {
+               const Double_t bp = by[k]*y[k];
+               y[k] = y[k] + gy2[k]*bp*by[k] + gy[k]*by[k]*t[k];
+               t[k] = gy[k]*(t[k] + bp);
+            }
+         }
+      }
+
+      //
+      //---> final boost of all particles
+      //
+      if (b2 > 0) {
+         for (n=0; n<fNt; n++) {
+            Double_t *x = px + n*stride + i0, *y = py + n*stride + i0;
+            Double_t *z = pz + n*stride + i0, *t = e + n*stride + i0;
+            for (k=0; k<nev; k++) {
+               const Double_t bp = fBeta[0]*x[k] + fBeta[1]*y[k] + fBeta[2]*z[k];
+               x[k] = x[k] + gamma2*bp*fBeta[0] + gamma*fBeta[0]*t[k];
+               y[k] = y[k] + gamma2*bp*fBeta[1] + gamma*fBeta[1]*t[k];
+               z[k] = z[k] + gamma2*bp*fBeta[2] + gamma*fBeta[2]*t[k];
+               t[k] = gamma*(t[k] + bp);
+            }
+         }
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return Lorentz vector corresponding to decay n
 
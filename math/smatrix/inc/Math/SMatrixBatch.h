@@ -0,0 +1,531 @@
+// @(#)root/smatrix:$Id$
+
+#ifndef ROOT_Math_SMatrixBatch
+#define ROOT_Math_SMatrixBatch
+
+/**
+   @file
+   Batch of N small matrices of the same size stored as a structure of arrays
+   ("matriplex"), with the operations needed by track fitting (product,
+   similarity and inversion) applied to all the matrices of the batch at once.
+*/
+
+#ifndef ROOT_Math_SMatrix
+#include "Math/SMatrix.h"
+#endif
+
+#ifndef ROOT_Math_StaticCheck
+#include "Math/StaticCheck.h"
+#endif
+
+#include <cmath>
+
+namespace ROOT {
+
+namespace Math {
+
+
+/**
+   Batch of N matrices of dimension D1 x D2 stored as a structure of arrays:
+   the N values of the element (i,j) are contiguous in memory, the element (i,j)
+   of the matrix n being at position (i*D2 + j)*N + n.
+
+   All the operations are written as loops on the N matrices of the batch for a
+   given element, which have a fixed trip count and no dependency between the
+   iterations, and can therefore be vectorized by the compiler. With N a multiple
+   of the SIMD width (e.g. 4 or 8 for double) each lane of a SIMD register processes
+   a different matrix.
+   This is efficient when a large number of independent small matrix operations
+   must be performed, as for example in the Kalman filter fit of many tracks.
+
+   The free functions ROOT::Math::Multiply, ROOT::Math::Similarity,
+   ROOT::Math::SimilarityT and ROOT::Math::Transpose operate on batches; the
+   result batch must be different from the argument batches.
+
+   @ingroup SMatrixSVector
+*/
+template <class T, unsigned int D1, unsigned int D2 = D1, unsigned int N = 8>
+class SMatrixBatch {
+
+public:
+
+   /** @name --- Typedefs --- */
+
+   /** contained scalar type */
+   typedef T  value_type;
+
+   /** type of the single matrices of the batch */
+   typedef SMatrix<T,D1,D2> matrix_type;
+
+   /**
+      Enumeration defining the batch dimension,
+      number of rows, columns and size = rows*columns)
+   */
+   enum {
+      /// return no. of matrix rows
+      kRows = D1,
+      /// return no. of matrix columns
+      kCols = D2,
+      /// return no of elements of a single matrix: rows*columns
+      kSize = D1*D2,
+      /// return no. of matrices in the batch
+      kBatchSize = N
+   };
+
+   /** @name --- Constructors and Assignment --- */
+
+   /**
+      Default constructor: all the matrices are zero
+   */
+   SMatrixBatch() : fArray() {}
+
+   /**
+      construct a batch with all the N matrices equal to m
+   */
+   template <class R>
+   explicit SMatrixBatch(const SMatrix<T,D1,D2,R> & m) {
+      for (unsigned int n = 0; n < N; ++n) SetMatrix(n, m);
+   }
+
+   /** @name --- Access functions --- */
+
+   /**
+      access the element (i,j) of the matrix n of the batch
+   */
+   T & operator() (unsigned int i, unsigned int j, unsigned int n) { return fArray[(i*D2 + j)*N + n]; }
+   const T & operator() (unsigned int i, unsigned int j, unsigned int n) const { return fArray[(i*D2 + j)*N + n]; }
+
+   /**
+      pointer to the N contiguous values of the element (i,j)
+   */
+   T * Array(unsigned int i, unsigned int j) { return fArray + (i*D2 + j)*N; }
+   const T * Array(unsigned int i, unsigned int j) const { return fArray + (i*D2 + j)*N; }
+
+   /**
+      pointer to the internal storage of the whole batch
+   */
+   T * Array() { return fArray; }
+   const T * Array() const { return fArray; }
+
+   /**
+      copy the matrix m in the position n of the batch
+   */
+   template <class R>
+   void SetMatrix(unsigned int n, const SMatrix<T,D1,D2,R> & m) {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            fArray[(i*D2 + j)*N + n] = m(i,j);
+   }
+
+   /**
+      copy the matrix at the position n of the batch in m.
+      For a symmetric m the lower part of the matrix of the batch is used
+      (it is assigned after the upper part)
+   */
+   template <class R>
+   void GetMatrix(unsigned int n, SMatrix<T,D1,D2,R> & m) const {
+      for (unsigned int i = 0; i < D1; ++i)
+         for (unsigned int j = 0; j < D2; ++j)
+            m(i,j) = fArray[(i*D2 + j)*N + n];
+   }
+
+   /**
+      return the matrix at the position n of the batch
+   */
+   matrix_type Matrix(unsigned int n) const {
+      matrix_type m;
+      GetMatrix(n, m);
+      return m;
+   }
+
+   /** @name --- Operators --- */
+
+   /**
+      element by element addition of the batch rhs
+   */
+   SMatrixBatch & operator+= (const SMatrixBatch & rhs) {
+      for (unsigned int k = 0; k < kSize*N; ++k) fArray[k] += rhs.fArray[k];
+      return *this;
+   }
+
+   /**
+      element by element subtraction of the batch rhs
+   */
+   SMatrixBatch & operator-= (const SMatrixBatch & rhs) {
+      for (unsigned int k = 0; k < kSize*N; ++k) fArray[k] -= rhs.fArray[k];
+      return *this;
+   }
+
+   /**
+      multiplication of all the matrices with a scalar
+   */
+   SMatrixBatch & operator*= (const T & rhs) {
+      for (unsigned int k = 0; k < kSize*N; ++k) fArray[k] *= rhs;
+      return *this;
+   }
+
+   /** @name --- Linear Algebra Functions --- */
+
+   /**
+      Invert all the square matrices of the batch (this method changes the current batch).
+      The method used is the Gauss-Jordan elimination without pivoting, which executes
+      the same sequence of operations for all the matrices of the batch.
+      As SMatrix::InvertFast it is faster than a pivoting algorithm, but it can suffer from
+      a worse numerical accuracy when the condition of the matrix is large.
+      Return true if the inversion is successful for all the matrices. The matrices for
+      which the inversion fails (a null pivot is found) are left unchanged.
+      \param ok if not null, ok[n] is set to true if the inversion of the matrix n succeeded
+   */
+   bool InvertFast(bool * ok = 0);
+
+   /**
+      Invert all the symmetric positive defined matrices of the batch using the Cholesky
+      decomposition (this method changes the current batch). Only the lower part of the
+      matrices is used.
+      Return true if the inversion is successful for all the matrices. The matrices which
+      are not positive defined are left unchanged.
+      \param ok if not null, ok[n] is set to true if the inversion of the matrix n succeeded
+   */
+   bool InvertChol(bool * ok = 0);
+
+private:
+
+   T fArray[D1*D2*N];
+
+};
+
+
+/**
+   Cholesky decomposition of a batch of N symmetric positive defined matrices of
+   dimension D, performed for all the matrices at the same time.
+   It is the batch version of ROOT::Math::CholeskyDecomp; the decomposition uses
+   only the lower part of the matrices.
+
+   @ingroup SMatrixSVector
+*/
+template <class T, unsigned int D, unsigned int N = 8>
+class CholeskyDecompBatch {
+
+public:
+
+   /**
+      perform the decomposition of all the matrices of the batch m
+   */
+   explicit CholeskyDecompBatch(const SMatrixBatch<T,D,D,N> & m) : fL(), fOk() {
+      for (unsigned int n = 0; n < N; ++n) fOk[n] = true;
+      T s[N];
+      for (unsigned int i = 0; i < D; ++i) {
+         for (unsigned int j = 0; j <= i; ++j) {
+            const T * mij = m.Array(i,j);
+            for (unsigned int n = 0; n < N; ++n) s[n] = mij[n];
+            for (unsigned int k = 0; k < j; ++k) {
+               const T * lik = L(i,k);
+               const T * ljk = L(j,k);
+               for (unsigned int n = 0; n < N; ++n) s[n] -= lik[n] * ljk[n];
+            }
+            T * lij = L(i,j);
+            if (i == j) {
+               // store the inverse of the diagonal elements. For the failing matrices
+               // continue with a dummy value to avoid floating point exceptions
+               for (unsigned int n = 0; n < N; ++n) {
+                  const bool positive = (s[n] > 0);
+                  fOk[n] = fOk[n] && positive;
+                  lij[n] = T(1) / std::sqrt(positive ? s[n] : T(1));
+               }
+            }
+            else {
+               const T * ljj = L(j,j);
+               for (unsigned int n = 0; n < N; ++n) lij[n] = s[n] * ljj[n];
+            }
+         }
+      }
+   }
+
+   /**
+      return true if the decomposition of all the matrices was successful
+   */
+   bool ok() const {
+      for (unsigned int n = 0; n < N; ++n)
+         if (!fOk[n]) return false;
+      return true;
+   }
+
+   /**
+      return true if the decomposition of the matrix n was successful
+   */
+   bool ok(unsigned int n) const { return fOk[n]; }
+
+   /**
+      compute the inverse of the decomposed matrices and store it in m.
+      The matrices of m whose decomposition failed are left unchanged.
+      Return true if all the matrices could be inverted
+   */
+   bool Invert(SMatrixBatch<T,D,D,N> & m) const {
+      // inverse of L (lower triangular), the diagonal is already inverted
+      T li[D*(D+1)/2*N];
+      T s[N];
+      for (unsigned int i = 0; i < D; ++i) {
+         const T * lii = L(i,i);
+         T * liii = li + Index(i,i)*N;
+         for (unsigned int n = 0; n < N; ++n) liii[n] = lii[n];
+         for (unsigned int j = 0; j < i; ++j) {
+            for (unsigned int n = 0; n < N; ++n) s[n] = 0;
+            for (unsigned int k = j; k < i; ++k) {
+               const T * lik = L(i,k);
+               const T * likj = li + Index(k,j)*N;
+               for (unsigned int n = 0; n < N; ++n) s[n] += lik[n] * likj[n];
+            }
+            T * lij = li + Index(i,j)*N;
+            for (unsigned int n = 0; n < N; ++n) lij[n] = - lii[n] * s[n];
+         }
+      }
+      // inverse of m = L^-1^T * L^-1
+      for (unsigned int i = 0; i < D; ++i) {
+         for (unsigned int j = 0; j <= i; ++j) {
+            for (unsigned int n = 0; n < N; ++n) s[n] = 0;
+            for (unsigned int k = i; k < D; ++k) {
+               const T * liki = li + Index(k,i)*N;
+               const T * likj = li + Index(k,j)*N;
+               for (unsigned int n = 0; n < N; ++n) s[n] += liki[n] * likj[n];
+            }
+            T * mij = m.Array(i,j);
+            T * mji = m.Array(j,i);
+            for (unsigned int n = 0; n < N; ++n) {
+               const T v = fOk[n] ? s[n] : mij[n];
+               mij[n] = v;
+               mji[n] = fOk[n] ? v : mji[n];
+            }
+         }
+      }
+      return ok();
+   }
+
+   /**
+      solve the linear systems m x = rhs for all the decomposed matrices.
+      rhs contains the D*N values of the right hand sides, the element i of the
+      system n at position i*N + n, and it is replaced by the solution.
+      The systems whose decomposition failed are left unchanged.
+      Return true if all the systems could be solved
+   */
+   bool Solve(T * rhs) const {
+      T x[D*N];
+      // forward substitution: L y = rhs
+      for (unsigned int i = 0; i < D; ++i) {
+         T * xi = x + i*N;
+         const T * bi = rhs + i*N;
+         for (unsigned int n = 0; n < N; ++n) xi[n] = bi[n];
+         for (unsigned int k = 0; k < i; ++k) {
+            const T * lik = L(i,k);
+            const T * xk = x + k*N;
+            for (unsigned int n = 0; n < N; ++n) xi[n] -= lik[n] * xk[n];
+         }
+         const T * lii = L(i,i);
+         for (unsigned int n = 0; n < N; ++n) xi[n] *= lii[n];
+      }
+      // back substitution: L^T x = y
+      for (unsigned int ii = D; ii > 0; --ii) {
+         const unsigned int i = ii - 1;
+         T * xi = x + i*N;
+         for (unsigned int k = i + 1; k < D; ++k) {
+            const T * lki = L(k,i);
+            const T * xk = x + k*N;
+            for (unsigned int n = 0; n < N; ++n) xi[n] -= lki[n] * xk[n];
+         }
+         const T * lii = L(i,i);
+         for (unsigned int n = 0; n < N; ++n) xi[n] *= lii[n];
+      }
+      for (unsigned int i = 0; i < D; ++i) {
+         T * bi = rhs + i*N;
+         const T * xi = x + i*N;
+         for (unsigned int n = 0; n < N; ++n) bi[n] = fOk[n] ? xi[n] : bi[n];
+      }
+      return ok();
+   }
+
+private:
+
+   // index of the element (i,j), j <= i, in the packed lower triangular storage
+   static unsigned int Index(unsigned int i, unsigned int j) { return i*(i+1)/2 + j; }
+
+   T * L(unsigned int i, unsigned int j) { return fL + Index(i,j)*N; }
+   const T * L(unsigned int i, unsigned int j) const { return fL + Index(i,j)*N; }
+
+   /// lower triangular matrices L (packed storage) with the diagonal elements pre-inverted
+   T fL[D*(D+1)/2*N];
+   /// flags indicating a successful decomposition
+   bool fOk[N];
+};
+
+
+//==============================================================================
+// SMatrixBatch::InvertFast
+//==============================================================================
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+bool SMatrixBatch<T,D1,D2,N>::InvertFast(bool * ok) {
+   STATIC_CHECK( D1 == D2, SMatrixBatch_InvertFast_matrix_is_not_square );
+   const unsigned int D = D1;
+   // keep a copy to restore the matrices which cannot be inverted
+   SMatrixBatch<T,D1,D2,N> orig(*this);
+   bool lok[N];
+   for (unsigned int n = 0; n < N; ++n) lok[n] = true;
+   T inv[N];
+   T f[N];
+   for (unsigned int k = 0; k < D; ++k) {
+      T * akk = Array(k,k);
+      for (unsigned int n = 0; n < N; ++n) {
+         const bool nonzero = (akk[n] != 0);
+         lok[n] = lok[n] && nonzero;
+         inv[n] = T(1) / (nonzero ? akk[n] : T(1));
+         akk[n] = 1;
+      }
+      for (unsigned int j = 0; j < D; ++j) {
+         T * akj = Array(k,j);
+         for (unsigned int n = 0; n < N; ++n) akj[n] *= inv[n];
+      }
+      for (unsigned int i = 0; i < D; ++i) {
+         if (i == k) continue;
+         T * aik = Array(i,k);
+         for (unsigned int n = 0; n < N; ++n) {
+            f[n] = aik[n];
+            aik[n] = 0;
+         }
+         for (unsigned int j = 0; j < D; ++j) {
+            T * aij = Array(i,j);
+            const T * akj = Array(k,j);
+            for (unsigned int n = 0; n < N; ++n) aij[n] -= f[n] * akj[n];
+         }
+      }
+   }
+   bool allOk = true;
+   for (unsigned int n = 0; n < N; ++n) {
+      if (ok) ok[n] = lok[n];
+      allOk &= lok[n];
+   }
+   if (!allOk) {
+      for (unsigned int k = 0; k < kSize; ++k) {
+         T * a = fArray + k*N;
+         const T * a0 = orig.fArray + k*N;
+         for (unsigned int n = 0; n < N; ++n) a[n] = lok[n] ? a[n] : a0[n];
+      }
+   }
+   return allOk;
+}
+
+//==============================================================================
+// SMatrixBatch::InvertChol
+//==============================================================================
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+bool SMatrixBatch<T,D1,D2,N>::InvertChol(bool * ok) {
+   STATIC_CHECK( D1 == D2, SMatrixBatch_InvertChol_matrix_is_not_square );
+   CholeskyDecompBatch<T,D1,N> decomp(*this);
+   if (ok) {
+      for (unsigned int n = 0; n < N; ++n) ok[n] = decomp.ok(n);
+   }
+   return decomp.Invert(*this);
+}
+
+
+/**
+   Matrix product of the batches: c = a * b for all the matrices of the batch
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, unsigned int N>
+inline void Multiply(const SMatrixBatch<T,D1,D,N> & a, const SMatrixBatch<T,D,D2,N> & b,
+                     SMatrixBatch<T,D1,D2,N> & c) {
+   // accumulate in a local array, which cannot alias the arguments
+   T s[N];
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         for (unsigned int n = 0; n < N; ++n) s[n] = 0;
+         for (unsigned int k = 0; k < D; ++k) {
+            const T * aik = a.Array(i,k);
+            const T * bkj = b.Array(k,j);
+            for (unsigned int n = 0; n < N; ++n) s[n] += aik[n] * bkj[n];
+         }
+         T * cij = c.Array(i,j);
+         for (unsigned int n = 0; n < N; ++n) cij[n] = s[n];
+      }
+   }
+}
+
+/**
+   Transpose of all the matrices of the batch: at = a^T
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+inline void Transpose(const SMatrixBatch<T,D1,D2,N> & a, SMatrixBatch<T,D2,D1,N> & at) {
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         const T * aij = a.Array(i,j);
+         T * atji = at.Array(j,i);
+         for (unsigned int n = 0; n < N; ++n) atji[n] = aij[n];
+      }
+   }
+}
+
+/**
+   Similarity of the batches: c = u * a * u^T for all the matrices of the batch,
+   where a is symmetric and u has dimension D1 x D2.
+   Only the lower part of a is used; the result is symmetric
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+inline void Similarity(const SMatrixBatch<T,D1,D2,N> & u, const SMatrixBatch<T,D2,D2,N> & a,
+                       SMatrixBatch<T,D1,D1,N> & c) {
+   T s[N];
+   // tmp = u * a
+   SMatrixBatch<T,D1,D2,N> tmp;
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j < D2; ++j) {
+         for (unsigned int n = 0; n < N; ++n) s[n] = 0;
+         for (unsigned int k = 0; k < D2; ++k) {
+            const T * uik = u.Array(i,k);
+            const T * akj = (k >= j) ? a.Array(k,j) : a.Array(j,k);
+            for (unsigned int n = 0; n < N; ++n) s[n] += uik[n] * akj[n];
+         }
+         T * tij = tmp.Array(i,j);
+         for (unsigned int n = 0; n < N; ++n) tij[n] = s[n];
+      }
+   }
+   // c = tmp * u^T
+   for (unsigned int i = 0; i < D1; ++i) {
+      for (unsigned int j = 0; j <= i; ++j) {
+         for (unsigned int n = 0; n < N; ++n) s[n] = 0;
+         for (unsigned int k = 0; k < D2; ++k) {
+            const T * tik = tmp.Array(i,k);
+            const T * ujk = u.Array(j,k);
+            for (unsigned int n = 0; n < N; ++n) s[n] += tik[n] * ujk[n];
+         }
+         T * cij = c.Array(i,j);
+         T * cji = c.Array(j,i);
+         for (unsigned int n = 0; n < N; ++n) cij[n] = s[n];
+         for (unsigned int n = 0; n < N; ++n) cji[n] = s[n];
+      }
+   }
+}
+
+/**
+   Transpose Similarity of the batches: c = u^T * a * u for all the matrices of the batch,
+   where a is symmetric and u has dimension D1 x D2.
+   Only the lower part of a is used; the result is symmetric
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, unsigned int N>
+inline void SimilarityT(const SMatrixBatch<T,D1,D2,N> & u, const SMatrixBatch<T,D1,D1,N> & a,
+                        SMatrixBatch<T,D2,D2,N> & c) {
+   SMatrixBatch<T,D2,D1,N> ut;
+   Transpose(u, ut);
+   Similarity(ut, a, c);
+}
+
+
+}  // namespace Math
+
+}  // namespace ROOT
+
+
+#endif  /* ROOT_Math_SMatrixBatch  */
@@ -0,0 +1,258 @@
+// @(#)root/smatrix:$Id$
+///////////////////////////////////////////////////////////////////////////////////
+//
+//  SMatrixBatch Benchmark test suite
+//  ==================================
+//
+//  This program compares the batched (structure of arrays) matrix operations of
+//  ROOT::Math::SMatrixBatch with the same operations performed one matrix at a time
+//  with ROOT::Math::SMatrix.
+//  The time performing the operations on a collection of matrices is measured.
+//  The benchmarked operations are:
+//      - product of 5x5 matrices
+//      - similarity of a 5x5 symmetric matrix with a 2x5 projection matrix
+//      - inversion of 5x5 symmetric matrices with the Cholesky decomposition
+//      - fast inversion of 5x5 matrices
+//      - a Kalman filter update step of the 5x5 track covariance with a 2D measurement
+//
+//  The results of the batch and of the single matrix operations are compared.
+//
+//  To run the program do:
+//  stressBatch          : run standard test with a collection of 100000 matrices
+//  stressBatch  1000000 : run with a collection of 1000000 matrices
+//
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "Math/SMatrix.h"
+#include "Math/SMatrixBatch.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+
+using namespace ROOT::Math;
+
+const unsigned int kBatch = 8;   // number of matrices in a batch
+
+typedef SMatrix<double,5,5>                          SMatrix55;
+typedef SMatrix<double,5,5,MatRepSym<double,5> >     SMatrixSym5;
+typedef SMatrix<double,2,5>                          SMatrix25;
+typedef SMatrix<double,5,2>                          SMatrix52;
+typedef SMatrix<double,2,2,MatRepSym<double,2> >     SMatrixSym2;
+
+typedef SMatrixBatch<double,5,5,kBatch> Batch55;
+typedef SMatrixBatch<double,2,5,kBatch> Batch25;
+typedef SMatrixBatch<double,5,2,kBatch> Batch52;
+typedef SMatrixBatch<double,2,2,kBatch> Batch22;
+
+
+void printTime(TStopwatch & time, const std::string & s) {
+   int pr = std::cout.precision(4);
+   std::cout << std::setw(28) << s << "\t" << " Real time = " << time.RealTime() << "\t(sec)\tCPU time = "
+             << time.CpuTime() << "\t(sec)"
+             << std::endl;
+   std::cout.precision(pr);
+}
+
+template<class M>
+void fillRandomMat(TRandom & r, M & m, unsigned int first, unsigned int second, double offset = 1) {
+   for(unsigned int i = 0; i < first; ++i)
+      for(unsigned int j = 0; j < second; ++j)
+         m(i,j) = r.Rndm() + offset;
+}
+
+template<class M>
+void fillRandomSym(TRandom & r, M & m, unsigned int first, double offset = 1) {
+   for(unsigned int i = 0; i < first; ++i) {
+      for(unsigned int j = i; j < first; ++j) {
+         if ( i != j ) {
+            m(i,j) = r.Rndm() + offset;
+            m(j,i) = m(i,j);
+         }
+         else // add extra offset to make positive defined
+            m(i,i) = r.Rndm() + 5*offset;
+      }
+   }
+}
+
+// compare the matrices stored in the batches with the ones computed one by one
+template<class M, class B>
+int compareResults(const std::vector<M> & v, const std::vector<B> & vb, const std::string & name, double tol = 1.E-10) {
+   int nfail = 0;
+   for (unsigned int k = 0; k < v.size(); ++k) {
+      const M & m = v[k];
+      const B & b = vb[k/kBatch];
+      unsigned int n = k % kBatch;
+      for (unsigned int i = 0; i < M::kRows; ++i) {
+         for (unsigned int j = 0; j < M::kCols; ++j) {
+            double d = std::abs(m(i,j) - b(i,j,n));
+            if (d > tol * (std::abs(m(i,j)) + 1.) ) nfail++;
+         }
+      }
+   }
+   if (nfail) std::cout << "ERROR: " << name << " : " << nfail << " elements differ" << std::endl;
+   return nfail;
+}
+
+
+int stressBatch(unsigned int nmat) {
+
+   // use a multiple of the batch size
+   nmat = ((nmat + kBatch - 1)/kBatch) * kBatch;
+   const unsigned int nbatch = nmat/kBatch;
+
+   std::cout << "Test SMatrixBatch with " << nmat << " matrices (" << nbatch << " batches of "
+             << kBatch << ")\n" << std::endl;
+
+   TRandom3 r(111);
+   std::vector<SMatrix55>   a(nmat), b(nmat);
+   std::vector<SMatrixSym5> c(nmat);
+   std::vector<SMatrix25>   h(nmat);
+   std::vector<SMatrixSym2> v(nmat);
+   for (unsigned int k = 0; k < nmat; ++k) {
+      fillRandomMat(r, a[k], 5, 5);
+      fillRandomMat(r, b[k], 5, 5);
+      fillRandomSym(r, c[k], 5);
+      fillRandomMat(r, h[k], 2, 5, 0.);
+      fillRandomSym(r, v[k], 2, 0.1);
+   }
+
+   // fill the batches
+   std::vector<Batch55> ab(nbatch), bb(nbatch), cb(nbatch);
+   std::vector<Batch25> hb(nbatch);
+   std::vector<Batch22> vb(nbatch);
+   for (unsigned int k = 0; k < nmat; ++k) {
+      ab[k/kBatch].SetMatrix(k % kBatch, a[k]);
+      bb[k/kBatch].SetMatrix(k % kBatch, b[k]);
+      cb[k/kBatch].SetMatrix(k % kBatch, c[k]);
+      hb[k/kBatch].SetMatrix(k % kBatch, h[k]);
+      vb[k/kBatch].SetMatrix(k % kBatch, v[k]);
+   }
+
+   int iret = 0;
+   TStopwatch w;
+
+   // matrix product
+   {
+      std::vector<SMatrix55> res(nmat);
+      w.Start();
+      for (unsigned int k = 0; k < nmat; ++k) res[k] = a[k] * b[k];
+      w.Stop();
+      printTime(w, "SMatrix  A*B");
+
+      std::vector<Batch55> resb(nbatch);
+      w.Start();
+      for (unsigned int k = 0; k < nbatch; ++k) Multiply(ab[k], bb[k], resb[k]);
+      w.Stop();
+      printTime(w, "SMatrixBatch A*B");
+      iret |= compareResults(res, resb, "Multiply");
+   }
+
+   // similarity
+   {
+      std::vector<SMatrixSym2> res(nmat);
+      w.Start();
+      for (unsigned int k = 0; k < nmat; ++k) res[k] = Similarity(h[k], c[k]);
+      w.Stop();
+      printTime(w, "SMatrix  H*C*Ht");
+
+      std::vector<Batch22> resb(nbatch);
+      w.Start();
+      for (unsigned int k = 0; k < nbatch; ++k) Similarity(hb[k], cb[k], resb[k]);
+      w.Stop();
+      printTime(w, "SMatrixBatch H*C*Ht");
+      iret |= compareResults(res, resb, "Similarity");
+   }
+
+   // inversion with Cholesky decomposition
+   {
+      std::vector<SMatrixSym5> res(c);
+      w.Start();
+      for (unsigned int k = 0; k < nmat; ++k) res[k].InvertChol();
+      w.Stop();
+      printTime(w, "SMatrix  InvertChol");
+
+      std::vector<Batch55> resb(cb);
+      w.Start();
+      for (unsigned int k = 0; k < nbatch; ++k) resb[k].InvertChol();
+      w.Stop();
+      printTime(w, "SMatrixBatch InvertChol");
+      iret |= compareResults(res, resb, "InvertChol", 1.E-8);
+   }
+
+   // fast inversion
+   {
+      // make the random matrices diagonal dominant to have a good condition
+      std::vector<SMatrix55> res(a);
+      std::vector<Batch55> resb(nbatch);
+      for (unsigned int k = 0; k < nmat; ++k) {
+         for (unsigned int i = 0; i < 5; ++i) res[k](i,i) += 5;
+         resb[k/kBatch].SetMatrix(k % kBatch, res[k]);
+      }
+
+      w.Start();
+      for (unsigned int k = 0; k < nmat; ++k) res[k].InvertFast();
+      w.Stop();
+      printTime(w, "SMatrix  InvertFast");
+
+      w.Start();
+      for (unsigned int k = 0; k < nbatch; ++k) resb[k].InvertFast();
+      w.Stop();
+      printTime(w, "SMatrixBatch InvertFast");
+      iret |= compareResults(res, resb, "InvertFast", 1.E-8);
+   }
+
+   // Kalman filter update of the covariance matrix:
+   // K = C Ht (V + H C Ht)^-1 , C' = C - K H C
+   {
+      std::vector<SMatrix55> res(nmat);
+      w.Start();
+      for (unsigned int k = 0; k < nmat; ++k) {
+         SMatrixSym2 rinv = v[k] + Similarity(h[k], c[k]);
+         rinv.InvertChol();
+         SMatrix52 gain = c[k] * Transpose(h[k]) * rinv;
+         res[k] = c[k] - gain * (h[k] * c[k]);
+      }
+      w.Stop();
+      printTime(w, "SMatrix  Kalman update");
+
+      std::vector<Batch55> resb(nbatch);
+      Batch22 rinv;
+      Batch52 ht, cht, gain;
+      Batch25 hc;
+      Batch55 khc;
+      w.Start();
+      for (unsigned int k = 0; k < nbatch; ++k) {
+         Similarity(hb[k], cb[k], rinv);
+         rinv += vb[k];
+         rinv.InvertChol();
+         Transpose(hb[k], ht);
+         Multiply(cb[k], ht, cht);
+         Multiply(cht, rinv, gain);
+         Multiply(hb[k], cb[k], hc);
+         Multiply(gain, hc, khc);
+         resb[k] = cb[k];
+         resb[k] -= khc;
+      }
+      w.Stop();
+      printTime(w, "SMatrixBatch Kalman update");
+      iret |= compareResults(res, resb, "Kalman update", 1.E-8);
+   }
+
+   if (iret) std::cout << "\nERROR - stressBatch FAILED" << std::endl;
+   else      std::cout << "\nstressBatch OK" << std::endl;
+   return iret;
+}
+
+
+int main(int argc, char *argv[]) {
+   unsigned int nmat = 100000;
+   if (argc > 1) nmat = std::atoi(argv[1]);
+   return stressBatch(nmat);
+}
@@ -7,6 +7,7 @@
 #include "Math/ChebyshevPol.h"
 
 #include <limits>
+#include <vector>
 #include <cstdlib>
 #include <stdio.h>
 // test of tformula neeeded to be run
@@ -657,6 +658,31 @@ bool test37() {
   ok &= TMath::AreEqualAbs( f1.Eval(0.5), ref(0.5), 1.E-10);
   return ok; 
 }
+
+bool test38() {
+  // test evaluation of arrays of points
+  bool ok = true;
+  TF2 f2("f2","[0]*exp(-x*x) + [1]*y + sin(x*y)",-3,3,-3,3);
+  f2.SetParameters(2,3);
+  const int n = 100;
+  std::vector<double> xy(2*n);
+  for (int i = 0; i < n; ++i) {
+     xy[i] = -3. + 0.06*i;
+     xy[n+i] = 3. - 0.05*i;
+  }
+  std::vector<double> out(n);
+  double p[2] = {1.5, -2.};
+  f2.EvalPar(n, xy.data(), p, out.data());
+  for (int i = 0; i < n; ++i) {
+     double x[2] = {xy[i], xy[n+i]};
+     ok &= TMath::AreEqualAbs( out[i], f2.EvalPar(x, p), 1.E-12);
+  }
+  // with the function parameters
+  f2.GetFormula()->EvalPar(n, xy.data(), 0, out.data());
+  for (int i = 0; i < n; ++i)
+     ok &= TMath::AreEqualAbs( out[i], f2.Eval(xy[i], xy[n+i]), 1.E-12);
+  return ok;
+}
    
 void PrintError(int itest)  { 
    Error("TFormula test","test%d FAILED ",itest);
@@ -712,6 +738,7 @@ int runTests(bool debug = false) {
    IncrTest(itest); if (!test35() ) { PrintError(itest); }
    IncrTest(itest); if (!test36() ) { PrintError(itest); }
    IncrTest(itest); if (!test37() ) { PrintError(itest); }
+   IncrTest(itest); if (!test38() ) { PrintError(itest); }
 
    std::cout << ".\n";
     
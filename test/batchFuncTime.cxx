@@ -0,0 +1,168 @@
+// @(#)root/test:$Id$
+
+//
+// Compare the throughput of the scalar and of the batch (array) versions of the
+// ROOT::Math and TMath special and probability functions, and check their accuracy.
+// The array versions computed with the vectorizable approximations of exp and erf must
+// agree with the scalar functions within a relative difference of 1E-14, the other ones
+// must give identical results.
+//
+// Usage: batchFuncTime
+//
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <string>
+
+#include "Math/PdfFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+const unsigned int npoints = 1000000;
+const int nloop = 10;
+// tolerance of the functions computed with the vectorizable approximations
+const double tolVec = 1.E-14;
+
+// time func (scalar) and batchFunc (batch) on the values x and compare the results,
+// which must agree within the relative tolerance tol
+template <class Func, class BatchFunc>
+bool testFunction(const std::string & name, const std::vector<double> & x, Func func, BatchFunc batchFunc,
+                  double tol = 0)
+{
+   std::vector<double> y1(x.size());
+   std::vector<double> y2(x.size());
+
+   TStopwatch w;
+   w.Start();
+   for (int iloop = 0; iloop < nloop; ++iloop)
+      for (unsigned int i = 0; i < x.size(); ++i)
+         y1[i] = func(x[i]);
+   w.Stop();
+   double tscalar = w.CpuTime();
+
+   w.Start();
+   for (int iloop = 0; iloop < nloop; ++iloop)
+      batchFunc(x.size(), x.data(), y2.data());
+   w.Stop();
+   double tbatch = w.CpuTime();
+
+   int ndiff = 0;
+   double maxdiff = 0;
+   for (unsigned int i = 0; i < x.size(); ++i) {
+      if (y1[i] == y2[i]) continue;
+      // the lgamma of negative integers can be nan
+      if (std::isnan(y1[i]) && std::isnan(y2[i])) continue;
+      double diff = std::abs(y1[i] - y2[i]) / std::abs(y1[i]);
+      if (!(diff <= tol)) ndiff++;
+      if (diff > maxdiff) maxdiff = diff;
+   }
+
+   std::cout << name << "\t scalar : " << 1.E9*tscalar/(nloop*x.size()) << " ns/call"
+             << "\t batch : " << 1.E9*tbatch/(nloop*x.size()) << " ns/value"
+             << "\t speedup : " << ((tbatch > 0) ? tscalar/tbatch : 0)
+             << "\t max rel. difference : " << maxdiff << std::endl;
+   if (ndiff) std::cout << "Error: " << name << " - " << ndiff << " values differ by more than " << tol << std::endl;
+
+   return ndiff == 0;
+}
+
+int batchFuncTime()
+{
+   TRandom3 r(111);
+   std::vector<double> x(npoints);
+   for (unsigned int i = 0; i < npoints; ++i) x[i] = r.Uniform(-10, 50);
+   // special values: the end points of the gamma distributions, infinities and a nan
+   std::vector<double> xs = { -10., 0., 2., 1.E-310, -1.E-310, 1.E300, -1.E300,
+                              INFINITY, -INFINITY, NAN };
+
+   bool ok = true;
+
+   ok &= testFunction("normal_pdf", x,
+                      [](double v) { return ROOT::Math::normal_pdf(v, 5., 2.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::normal_pdf_array(n, v, y, 5., 2.); },
+                      tolVec);
+   ok &= testFunction("normal_cdf", x,
+                      [](double v) { return ROOT::Math::normal_cdf(v, 5., 2.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::normal_cdf_array(n, v, y, 5., 2.); },
+                      tolVec);
+   ok &= testFunction("landau_pdf", x,
+                      [](double v) { return ROOT::Math::landau_pdf(v, 2., 1.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::landau_pdf_array(n, v, y, 2., 1.); });
+   ok &= testFunction("crystalball", x,
+                      [](double v) { return ROOT::Math::crystalball_function(v, 1.5, 3., 5., 2.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::crystalball_function_array(n, v, y, 1.5, 3., 5., 2.); },
+                      tolVec);
+   ok &= testFunction("gamma_pdf", x,
+                      [](double v) { return ROOT::Math::gamma_pdf(v, 2.5, 5., -10.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::gamma_pdf_array(n, v, y, 2.5, 5., -10.); },
+                      tolVec);
+   ok &= testFunction("erf", x,
+                      [](double v) { return ROOT::Math::erf(v/10); },
+                      [](unsigned int n, const double * v, double * y) {
+                         for (unsigned int i = 0; i < n; ++i) y[i] = v[i]/10;
+                         ROOT::Math::erf_array(n, y, y); },
+                      tolVec);
+   ok &= testFunction("crystalball (alpha < 0)", x,
+                      [](double v) { return ROOT::Math::crystalball_function(v, -1.5, 3., 5., 2.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::crystalball_function_array(n, v, y, -1.5, 3., 5., 2.); },
+                      tolVec);
+   ok &= testFunction("gamma_pdf (alpha = 1)", x,
+                      [](double v) { return ROOT::Math::gamma_pdf(v, 1., 5., -10.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::gamma_pdf_array(n, v, y, 1., 5., -10.); },
+                      tolVec);
+   ok &= testFunction("gamma_pdf (alpha < 1)", x,
+                      [](double v) { return ROOT::Math::gamma_pdf(v, 0.5, 5., -10.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::gamma_pdf_array(n, v, y, 0.5, 5., -10.); },
+                      tolVec);
+   ok &= testFunction("lgamma", x,
+                      [](double v) { return ROOT::Math::lgamma(v); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::lgamma_array(n, v, y); });
+   ok &= testFunction("TMath::Gaus", x,
+                      [](double v) { return TMath::Gaus(v, 5., 2., kTRUE); },
+                      [](unsigned int n, const double * v, double * y) { TMath::GausArray(n, v, y, 5., 2., kTRUE); },
+                      tolVec);
+   ok &= testFunction("TMath::Landau", x,
+                      [](double v) { return TMath::Landau(v, 2., 1.); },
+                      [](unsigned int n, const double * v, double * y) { TMath::LandauArray(n, v, y, 2., 1.); });
+
+   // special values
+   std::cout << "\nSpecial values" << std::endl;
+   ok &= testFunction("normal_pdf", xs,
+                      [](double v) { return ROOT::Math::normal_pdf(v, 5., 2.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::normal_pdf_array(n, v, y, 5., 2.); },
+                      tolVec);
+   ok &= testFunction("normal_cdf", xs,
+                      [](double v) { return ROOT::Math::normal_cdf(v, 5., 2.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::normal_cdf_array(n, v, y, 5., 2.); },
+                      tolVec);
+   ok &= testFunction("gamma_pdf", xs,
+                      [](double v) { return ROOT::Math::gamma_pdf(v, 2.5, 5., -10.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::gamma_pdf_array(n, v, y, 2.5, 5., -10.); },
+                      tolVec);
+   ok &= testFunction("gamma_pdf (alpha = 1)", xs,
+                      [](double v) { return ROOT::Math::gamma_pdf(v, 1., 5., -10.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::gamma_pdf_array(n, v, y, 1., 5., -10.); },
+                      tolVec);
+   ok &= testFunction("gamma_pdf (alpha < 1)", xs,
+                      [](double v) { return ROOT::Math::gamma_pdf(v, 0.5, 5., -10.); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::gamma_pdf_array(n, v, y, 0.5, 5., -10.); },
+                      tolVec);
+   ok &= testFunction("erf", xs,
+                      [](double v) { return ROOT::Math::erf(v); },
+                      [](unsigned int n, const double * v, double * y) { ROOT::Math::erf_array(n, v, y); },
+                      tolVec);
+
+   if (!ok) std::cerr << "batchFuncTime: batch and scalar functions are different: FAILED" << std::endl;
+   else std::cout << "batchFuncTime: OK" << std::endl;
+
+   return (ok) ? 0 : 1;
+}
+
+int main()
+{
+   return batchFuncTime();
+}
@@ -16,6 +16,8 @@
 #include "delaunayTriangulation_bug.h"
 
 #include "TPad.h"
+#include "TROOT.h"
+#include "RConfigure.h"
 
 #include <iostream>
 
@@ -58,6 +60,43 @@ int delaunayTriangulation(bool old = false) {
            std::cout << eta << " " << res << "  " << res2 << std::endl;
 	}
 
+	// batch interpolation must give the same values as the single point one
+	const int NBATCH = 4000;   // more than one chunk of the parallel interpolation
+	Double_t xb[NBATCH], yb[NBATCH], zb[NBATCH], zb2[NBATCH];
+	for (int i = 0; i < NBATCH; i++) {
+           xb[i] = 50 + 0.001;
+           yb[i] = 1. + 0.00025 * i + 0.001;
+	}
+	graph->Interpolate(NBATCH, xb, yb, zb);
+	delaunay.ComputeZ(NBATCH, xb, yb, zb2);
+	for (int i = 0; i < NBATCH; i++) {
+           if (zb[i] != graph->Interpolate(xb[i], yb[i]) || zb2[i] != delaunay.ComputeZ(xb[i], yb[i])) {
+              printf("ERROR - batch interpolation differs at (%f,%f): %f %f\n", xb[i], yb[i], zb[i], zb2[i]);
+              return 5;
+           }
+	}
+
+	// the triangles are kept with the graph: a copy streamed from it must interpolate
+	// the same values without computing the triangulation again, also when the
+	// points are interpolated in parallel
+	if (!old) {
+	   TGraph2D * copy = (TGraph2D*) graph->Clone("copy");
+#ifdef R__USE_IMT
+	   ROOT::EnableImplicitMT();
+#endif
+	   copy->Interpolate(NBATCH, xb, yb, zb2);
+#ifdef R__USE_IMT
+	   ROOT::DisableImplicitMT();
+#endif
+	   for (int i = 0; i < NBATCH; i++) {
+	      if (zb[i] != zb2[i]) {
+	         printf("ERROR - interpolation of the copied graph differs at (%f,%f): %f %f\n", xb[i], yb[i], zb[i], zb2[i]);
+	         return 6;
+	      }
+	   }
+	   delete copy;
+	}
+
 	if(delaunay.GetNdt() == EXP){
            if(VERBOSE) printDelaunay(delaunay);
 
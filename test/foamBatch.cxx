@@ -0,0 +1,176 @@
+// @(#)root/test:$Id$
+
+//
+// Test of the batch cell exploration (TFoam::SetnSamplBatch) and of the thread-safe
+// event generation (TFoam::GenerateEvent and TFoam::GenerateEvents) of TFoam.
+//
+// The distribution is the two-dimensional camel of the foam tutorials, normalized
+// to one. A foam explored one event at a time and a foam explored in batches are
+// built with the same random number seed: the integrals obtained from the events of
+// the two foams (MakeEvent, GenerateEvent and GenerateEvents) must agree with each
+// other and with one within the statistical errors.
+// When ROOT is built with imt support the batch foam is built again with implicit
+// multi-threading, and it must be identical to the one built without; the events of
+// GenerateEvents must also be identical with and without implicit multi-threading.
+//
+// Usage: foamBatch [nevents]
+//
+//       nevents       - number of events generated by each method (default 100003)
+//
+
+#include <stdlib.h>
+#include <vector>
+
+#include "RConfigure.h"
+#include "TFoam.h"
+#include "TFoamIntegrand.h"
+#include "TRandom3.h"
+#include "TMath.h"
+#include "Riostream.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+const Int_t    kDim           = 2;
+const Int_t    kNCells        = 500;
+const Int_t    kNSamplBatch   = 64;
+
+// two-dimensional distribution, normalized to one (within 1e-5)
+class TFoamCamel2 : public TFoamIntegrand {
+public:
+   Double_t Density(Int_t, Double_t *x) {
+      const Double_t gamSq = 0.1*0.1;
+      Double_t dist = 0;
+      dist += TMath::Exp(-((x[0]-1./3)*(x[0]-1./3) + (x[1]-1./3)*(x[1]-1./3))/gamSq)/gamSq/TMath::Pi();
+      dist += TMath::Exp(-((x[0]-2./3)*(x[0]-2./3) + (x[1]-2./3)*(x[1]-2./3))/gamSq)/gamSq/TMath::Pi();
+      return 0.5*dist;
+   }
+};
+
+// build a foam of weighted events, exploring the cells in batches of nBatch events
+static TFoam *build_foam(const char *name, TFoamIntegrand *rho, TRandom *rndm, Int_t nBatch)
+{
+   TFoam *foam = new TFoam(name);
+   foam->SetkDim(kDim);
+   foam->SetnCells(kNCells);
+   foam->SetOptRej(0);
+   foam->SetChat(0);
+   foam->SetnSamplBatch(nBatch);
+   foam->Initialize(rndm, rho);
+   return foam;
+}
+
+// compute the integral and its error from the weights of the events, check that
+// the events are inside the unit hypercube and that the integral is one
+static Bool_t check_events(const char *name, Double_t prime, const std::vector<Double_t> &wt,
+                           const std::vector<Double_t> &vect, Double_t &integral, Double_t &error)
+{
+   const Int_t n = wt.size();
+   Double_t s = 0, s2 = 0;
+   Int_t nbad = 0;
+   for (Int_t i = 0; i < n; i++) {
+      s += wt[i]; s2 += wt[i]*wt[i];
+      if (!(wt[i] >= 0)) nbad++;
+      for (Int_t k = 0; k < kDim; k++)
+         if (!(vect[i*kDim+k] >= 0 && vect[i*kDim+k] <= 1)) nbad++;
+   }
+   const Double_t mean = s/n;
+   integral = prime*mean;
+   error = prime*TMath::Sqrt((s2/n - mean*mean)/n);
+   const Double_t pull = (integral - 1)/error;
+   std::cout << "\t" << name << ": integral " << integral << " +- " << error << " (pull " << pull << ")" << std::endl;
+   if (nbad)
+      std::cout << "\t" << name << ": " << nbad << " bad weights or coordinates" << std::endl;
+   return nbad == 0 && TMath::Abs(pull) < 5;
+}
+
+// compare two integrals in standard deviations
+static Bool_t compare_integrals(const char *name, Double_t i1, Double_t e1, Double_t i2, Double_t e2)
+{
+   const Double_t pull = (i1 - i2)/TMath::Sqrt(e1*e1 + e2*e2);
+   std::cout << "\t" << name << ": pull " << pull << std::endl;
+   return TMath::Abs(pull) < 5;
+}
+
+int main(int argc,char **argv)
+{
+   const Int_t nevents = (argc > 1) ? atoi(argv[1]) : 100003;
+
+   TFoamCamel2 rho;
+   Bool_t ok = kTRUE;
+
+   std::cout << "\nBuild the foam exploring the cells one event at a time" << std::endl;
+   TRandom3 rndm1(4357);
+   TFoam *foam1 = build_foam("FoamSerial", &rho, &rndm1, 0);
+   std::vector<Double_t> wt1(nevents), vect1(nevents*kDim);
+   for (Int_t i = 0; i < nevents; i++) {
+      foam1->MakeEvent();
+      foam1->GetMCvect(&vect1[i*kDim]);
+      wt1[i] = foam1->GetMCwt();
+   }
+   Double_t int1, err1;
+   ok &= check_events("MakeEvent", foam1->GetPrimary(), wt1, vect1, int1, err1);
+   Double_t intMC, errMC;
+   foam1->GetIntegMC(intMC, errMC);
+   if (TMath::Abs(intMC - int1) > 1.0e-10*int1) {
+      std::cout << "\tGetIntegMC gives " << intMC << std::endl;
+      ok = kFALSE;
+   }
+
+   std::cout << "\nBuild the foam exploring the cells in batches of " << kNSamplBatch << " events" << std::endl;
+   TRandom3 rndm2(4357);
+   TFoam *foam2 = build_foam("FoamBatch", &rho, &rndm2, kNSamplBatch);
+
+   std::cout << "\nGenerate " << nevents << " events with GenerateEvent" << std::endl;
+   TRandom3 rndm3(65539);
+   std::vector<Double_t> wt2(nevents), vect2(nevents*kDim);
+   for (Int_t i = 0; i < nevents; i++)
+      wt2[i] = foam2->GenerateEvent(&rndm3, &vect2[i*kDim]);
+   Double_t int2, err2;
+   ok &= check_events("GenerateEvent", foam2->GetPrimary(), wt2, vect2, int2, err2);
+   ok &= compare_integrals("GenerateEvent vs MakeEvent", int2, err2, int1, err1);
+
+   std::cout << "\nGenerate them with GenerateEvents" << std::endl;
+   std::vector<Double_t> wt3(nevents), vect3(nevents*kDim);
+   foam2->GenerateEvents(nevents, vect3.data(), wt3.data(), 17);
+   Double_t int3, err3;
+   ok &= check_events("GenerateEvents", foam2->GetPrimary(), wt3, vect3, int3, err3);
+   ok &= compare_integrals("GenerateEvents vs MakeEvent", int3, err3, int1, err1);
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   std::cout << "\nBuild the foam exploring the cells in batches with implicit multi-threading" << std::endl;
+   TRandom3 rndm4(4357);
+   TFoam *foam4 = build_foam("FoamBatchMT", &rho, &rndm4, kNSamplBatch);
+   if (foam4->GetPrimary() != foam2->GetPrimary()) {
+      std::cout << "\tthe primary integral " << foam4->GetPrimary()
+                << " differs from the one without implicit multi-threading" << std::endl;
+      ok = kFALSE;
+   }
+
+   std::cout << "\nGenerate the events with GenerateEvents and implicit multi-threading" << std::endl;
+   // with both foams, that must give the same events
+   TFoam *foams[2] = { foam2, foam4 };
+   for (Int_t ifoam = 0; ifoam < 2; ifoam++) {
+      std::vector<Double_t> wt5(nevents), vect5(nevents*kDim);
+      foams[ifoam]->GenerateEvents(nevents, vect5.data(), wt5.data(), 17);
+      if (wt5 != wt3 || vect5 != vect3) {
+         std::cout << "\tthe events differ from the ones generated without implicit multi-threading"
+                   << std::endl;
+         ok = kFALSE;
+      }
+   }
+   ROOT::DisableImplicitMT();
+   delete foam4;
+#endif
+
+   delete foam1;
+   delete foam2;
+
+   if (!ok) {
+      std::cout << "\nBatch exploration and generation of foam events: FAILED" << std::endl;
+      return 1;
+   }
+   std::cout << "\nBatch exploration and generation of foam events: OK" << std::endl;
+   return 0;
+}
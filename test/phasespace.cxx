@@ -0,0 +1,163 @@
+// @(#)root/test:$Id$
+
+//
+// Test of the batch generation of TGenPhaseSpace events (GenerateBatch and
+// GenerateParallel, both implemented by the private GenerateRange).
+//
+// For all the generated events the four-momentum of the decaying particle must be
+// conserved and the decay products must have their masses. The distribution of the
+// weights must agree with the one of the events generated one at a time with
+// Generate(): the mean weights and the histograms of the weights are compared.
+// The number of events is not a multiple of the block sizes used by the generation,
+// so that the last blocks and random number streams are partially filled.
+// When ROOT is built with imt support GenerateParallel is run with and without
+// implicit multi-threading, and the events must be identical.
+//
+// Usage: phasespace [nevents]
+//
+//       nevents       - number of events (default 100003)
+//
+
+#include <stdlib.h>
+#include <vector>
+
+#include "RConfigure.h"
+#include "TGenPhaseSpace.h"
+#include "TLorentzVector.h"
+#include "TRandom3.h"
+#include "TMath.h"
+#include "Riostream.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+const Int_t    kNt            = 4;
+const Double_t kMasses[kNt]   = { 0.13957, 0.13957, 0.49368, 0.93827 };
+const Int_t    kNbins         = 20;
+
+// check the conservation of the four-momentum and the masses of the decay products
+// for the events stored as by GenerateBatch
+static Bool_t check_kinematics(const char *name, const TLorentzVector &p, Int_t nevents,
+                               const std::vector<Double_t> &px, const std::vector<Double_t> &py,
+                               const std::vector<Double_t> &pz, const std::vector<Double_t> &e)
+{
+   const Double_t tol = 1.0e-10*p.E();
+   Int_t nbad = 0;
+   for (Int_t i = 0; i < nevents; i++) {
+      Double_t sx = 0, sy = 0, sz = 0, se = 0;
+      for (Int_t n = 0; n < kNt; n++) {
+         const Long64_t j = Long64_t(n)*nevents + i;
+         sx += px[j]; sy += py[j]; sz += pz[j]; se += e[j];
+         const Double_t m2 = e[j]*e[j] - px[j]*px[j] - py[j]*py[j] - pz[j]*pz[j];
+         if (TMath::Abs(TMath::Sqrt(TMath::Max(m2, 0.)) - kMasses[n]) > tol) nbad++;
+      }
+      if (TMath::Abs(sx-p.Px()) > tol || TMath::Abs(sy-p.Py()) > tol ||
+          TMath::Abs(sz-p.Pz()) > tol || TMath::Abs(se-p.E()) > tol) nbad++;
+   }
+   if (nbad)
+      std::cout << "\t" << name << ": " << nbad << " events do not conserve the four-momentum" << std::endl;
+   return nbad == 0;
+}
+
+// compare the weights with the reference ones, computing the difference of the
+// mean values in standard deviations and the chi2 per bin of the histograms
+static Bool_t compare_weights(const char *name, const std::vector<Double_t> &w,
+                              const std::vector<Double_t> &wref, Double_t wtmax)
+{
+   Double_t s[2] = {0, 0}, s2[2] = {0, 0};
+   std::vector<Double_t> h[2] = { std::vector<Double_t>(kNbins), std::vector<Double_t>(kNbins) };
+   const std::vector<Double_t> *ws[2] = { &w, &wref };
+   for (Int_t k = 0; k < 2; k++) {
+      for (UInt_t i = 0; i < ws[k]->size(); i++) {
+         const Double_t x = (*ws[k])[i]/wtmax;
+         s[k] += x; s2[k] += x*x;
+         const Int_t bin = TMath::Min(Int_t(x*kNbins), kNbins-1);
+         if (bin >= 0) h[k][bin]++;
+      }
+   }
+   const Double_t n[2] = { Double_t(w.size()), Double_t(wref.size()) };
+   Double_t mean[2], var[2];
+   for (Int_t k = 0; k < 2; k++) {
+      mean[k] = s[k]/n[k];
+      var[k] = (s2[k]/n[k] - mean[k]*mean[k])/n[k];
+   }
+   const Double_t pull = (mean[0]-mean[1])/TMath::Sqrt(var[0]+var[1]);
+
+   // chi2 of two histograms with different number of entries
+   Double_t chi2 = 0;
+   Int_t ndf = 0;
+   for (Int_t i = 0; i < kNbins; i++) {
+      const Double_t nsum = h[0][i] + h[1][i];
+      if (nsum == 0) continue;
+      const Double_t d = h[0][i]*TMath::Sqrt(n[1]/n[0]) - h[1][i]*TMath::Sqrt(n[0]/n[1]);
+      chi2 += d*d/nsum;
+      ndf++;
+   }
+   ndf--;
+
+   std::cout << "\t" << name << ": mean weight " << mean[0]*wtmax << " (Generate: " << mean[1]*wtmax
+             << ", pull " << pull << "), chi2/ndf " << chi2 << "/" << ndf << std::endl;
+   return TMath::Abs(pull) < 5 && chi2 < ndf + 5*TMath::Sqrt(2.*ndf);
+}
+
+int main(int argc,char **argv)
+{
+   const Int_t nevents = (argc > 1) ? atoi(argv[1]) : 100003;
+
+   TLorentzVector p(0.5, -0.3, 3.0, 5.0);
+   TGenPhaseSpace gen;
+   if (!gen.SetDecay(p, kNt, kMasses)) {
+      std::cout << "Decay not allowed: FAILED" << std::endl;
+      return 1;
+   }
+
+   Bool_t ok = kTRUE;
+   const Long64_t size = Long64_t(nevents)*kNt;
+
+   std::cout << "\nGenerate " << nevents << " events with Generate()" << std::endl;
+   std::vector<Double_t> wref(nevents);
+   gRandom->SetSeed(4357);
+   for (Int_t i = 0; i < nevents; i++) {
+      wref[i] = gen.Generate();
+      // Generate() fills the decay products of the generator
+      TLorentzVector sum;
+      for (Int_t n = 0; n < kNt; n++) sum += *gen.GetDecay(n);
+      if (TMath::Abs(sum.E() - p.E()) > 1.0e-10*p.E()) ok = kFALSE;
+   }
+
+   std::cout << "\nGenerate them with GenerateBatch" << std::endl;
+   std::vector<Double_t> w(nevents), px(size), py(size), pz(size), e(size);
+   TRandom3 rndm(65539);
+   gen.GenerateBatch(nevents, w.data(), px.data(), py.data(), pz.data(), e.data(), &rndm);
+   ok &= check_kinematics("GenerateBatch", p, nevents, px, py, pz, e);
+   ok &= compare_weights("GenerateBatch", w, wref, gen.GetWtMax());
+
+   std::cout << "\nGenerate them with GenerateParallel" << std::endl;
+   std::vector<Double_t> w1(nevents), px1(size), py1(size), pz1(size), e1(size);
+   gen.GenerateParallel(nevents, w1.data(), px1.data(), py1.data(), pz1.data(), e1.data(), 17);
+   ok &= check_kinematics("GenerateParallel", p, nevents, px1, py1, pz1, e1);
+   ok &= compare_weights("GenerateParallel", w1, wref, gen.GetWtMax());
+
+#ifdef R__USE_IMT
+   std::cout << "\nGenerate them with GenerateParallel and implicit multi-threading" << std::endl;
+   ROOT::EnableImplicitMT();
+   // twice, since the thread pool is reused
+   for (Int_t itry = 0; itry < 2; itry++) {
+      std::vector<Double_t> w2(nevents), px2(size), py2(size), pz2(size), e2(size);
+      gen.GenerateParallel(nevents, w2.data(), px2.data(), py2.data(), pz2.data(), e2.data(), 17);
+      if (w2 != w1 || px2 != px1 || py2 != py1 || pz2 != pz1 || e2 != e1) {
+         std::cout << "\tthe events differ from the ones generated without implicit multi-threading"
+                   << std::endl;
+         ok = kFALSE;
+      }
+   }
+   ROOT::DisableImplicitMT();
+#endif
+
+   if (!ok) {
+      std::cout << "\nBatch generation of phase space events: FAILED" << std::endl;
+      return 1;
+   }
+   std::cout << "\nBatch generation of phase space events: OK" << std::endl;
+   return 0;
+}
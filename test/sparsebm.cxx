@@ -0,0 +1,156 @@
+// @(#)root/test:$Id$
+
+//
+// Benchmark of the sparse matrix classes against the dense ones.
+//
+// The matrix is the 5-point discrete Laplacian on a ngrid x ngrid grid, a symmetric
+// positive definite matrix of size ngrid^2 with at most 5 non-zero elements per row.
+// Timed are the matrix-vector product (dense and sparse) and the solution of a linear
+// system with the dense Cholesky decomposition, the sparse decomposition (TDecompSparse)
+// and the conjugate gradient solver (TDecompSparse::SolveConjugateGradient).
+// When ROOT is built with imt support the sparse product and the conjugate gradient
+// are clocked with and without implicit multi-threading for a (4*ngrid)^2 matrix, large
+// enough for the product to be done in parallel.
+//
+// Usage: sparsebm [ngrid] [ntimes]
+//
+//       ngrid         - grid size, the matrix has ngrid^2 rows (default 40)
+//       ntimes        - number of matrix-vector products (default 200)
+//
+
+#include <stdlib.h>
+
+#include "RConfigure.h"
+#include "TStopwatch.h"
+#include "TMath.h"
+#include "TMatrixD.h"
+#include "TMatrixDSparse.h"
+#include "TVectorD.h"
+#include "TDecompChol.h"
+#include "TDecompSparse.h"
+#include "Riostream.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+// 5-point Laplacian on a ngrid x ngrid grid
+static TMatrixDSparse laplacian(Int_t ngrid)
+{
+   const Int_t n = ngrid*ngrid;
+   Int_t nnz = 0;
+   TArrayI irow(5*n);
+   TArrayI icol(5*n);
+   TArrayD val(5*n);
+   for (Int_t ix = 0; ix < ngrid; ix++) {
+      for (Int_t iy = 0; iy < ngrid; iy++) {
+         const Int_t i = ix*ngrid+iy;
+         irow[nnz] = i; icol[nnz] = i; val[nnz++] = 4.0;
+         if (ix > 0)       { irow[nnz] = i; icol[nnz] = i-ngrid; val[nnz++] = -1.0; }
+         if (ix < ngrid-1) { irow[nnz] = i; icol[nnz] = i+ngrid; val[nnz++] = -1.0; }
+         if (iy > 0)       { irow[nnz] = i; icol[nnz] = i-1;     val[nnz++] = -1.0; }
+         if (iy < ngrid-1) { irow[nnz] = i; icol[nnz] = i+1;     val[nnz++] = -1.0; }
+      }
+   }
+   TMatrixDSparse m(0,n-1,0,n-1);
+   m.SetMatrixArray(nnz,irow.GetArray(),icol.GetArray(),val.GetArray());
+   return m;
+}
+
+// clock ntimes sparse matrix-vector products and one conjugate gradient solution
+// of the system with solution v
+static Bool_t clock_sparse(const TMatrixDSparse &ms,const TVectorD &v,const TVectorD &rhs,
+                           Int_t ntimes,TStopwatch &sw)
+{
+   Bool_t ok = kTRUE;
+
+   sw.Start();
+   TVectorD r(v.GetLwb(),v.GetUpb());
+   for (Int_t count = 0; count < ntimes; count++)
+      r = ms*v;
+   std::cout << "\tsparse product      : " << sw.RealTime() << " sec" << std::endl;
+   ok &= (r == ms*v);
+
+   sw.Start();
+   TVectorD x = rhs;
+   ok &= TDecompSparse::SolveConjugateGradient(ms,x,1.0e-12);
+   std::cout << "\tconjugate gradient  : " << sw.RealTime() << " sec" << std::endl;
+   ok &= (TMath::Sqrt((x-v).Norm2Sqr()) < 1.0e-8*TMath::Sqrt(v.Norm2Sqr()));
+
+   return ok;
+}
+
+int main(int argc,char **argv)
+{
+   const Int_t ngrid  = (argc > 1) ? atoi(argv[1]) : 40;
+   const Int_t ntimes = (argc > 2) ? atoi(argv[2]) : 200;
+   const Int_t n      = ngrid*ngrid;
+
+   std::cout << "\nCompare dense and sparse matrices of size " << n << " x " << n << std::endl;
+
+   const TMatrixDSparse ms = laplacian(ngrid);
+   const TMatrixD       md(ms);
+
+   TVectorD v(n);
+   for (Int_t i = 0; i < n; i++)
+      v(i) = 1.0+0.001*i;
+   // right-hand side of the system with solution v
+   const TVectorD rhs = ms*v;
+
+   Bool_t ok = kTRUE;
+   TStopwatch sw;
+
+   {
+      std::cout << "\nClock the dense matrix" << std::endl;
+      sw.Start();
+      TVectorD r(n);
+      for (Int_t count = 0; count < ntimes; count++)
+         r = md*v;
+      std::cout << "\tdense product       : " << sw.RealTime() << " sec" << std::endl;
+      ok &= (TMath::Sqrt((r-rhs).Norm2Sqr()) < 1.0e-12*TMath::Sqrt(rhs.Norm2Sqr()));
+
+      sw.Start();
+      TVectorD x = rhs;
+      TDecompChol chol(md);
+      ok &= chol.Solve(x);
+      std::cout << "\tCholesky solution   : " << sw.RealTime() << " sec" << std::endl;
+      ok &= (TMath::Sqrt((x-v).Norm2Sqr()) < 1.0e-8*TMath::Sqrt(v.Norm2Sqr()));
+   }
+
+   {
+      std::cout << "\nClock the sparse matrix" << std::endl;
+      ok &= clock_sparse(ms,v,rhs,ntimes,sw);
+
+      sw.Start();
+      TVectorD x = rhs;
+      TDecompSparse lu(ms,0);
+      ok &= lu.Solve(x);
+      std::cout << "\tsparse decomposition: " << sw.RealTime() << " sec" << std::endl;
+      ok &= (TMath::Sqrt((x-v).Norm2Sqr()) < 1.0e-8*TMath::Sqrt(v.Norm2Sqr()));
+   }
+
+#ifdef R__USE_IMT
+   {
+      const TMatrixDSparse msl = laplacian(4*ngrid);
+      TVectorD vl(msl.GetNrows());
+      for (Int_t i = 0; i < vl.GetNrows(); i++)
+         vl(i) = 1.0+0.001*i;
+      const TVectorD rhsl = msl*vl;
+
+      std::cout << "\nClock a sparse matrix of size " << msl.GetNrows() << " x " << msl.GetNcols()
+                << " without implicit multi-threading" << std::endl;
+      ok &= clock_sparse(msl,vl,rhsl,ntimes,sw);
+
+      std::cout << "\nClock it with implicit multi-threading" << std::endl;
+      ROOT::EnableImplicitMT();
+      ok &= clock_sparse(msl,vl,rhsl,ntimes,sw);
+      ROOT::DisableImplicitMT();
+   }
+#endif
+
+   if (!ok) {
+      std::cout << "\nDense and sparse results differ: FAILED" << std::endl;
+      return 1;
+   }
+   std::cout << "\nDense and sparse results agree" << std::endl;
+   return 0;
+}
@@ -68,11 +68,14 @@
 #include "TH2.h"
 #include "THn.h"
 #include "THnSparse.h"
+#include "TH2Poly.h"
 
 #include "TProfile.h"
 #include "TProfile2D.h"
 #include "TProfile3D.h"
 
+#include "TKDE.h"
+
 #include "TF1.h"
 #include "TF2.h"
 #include "TF3.h"
@@ -90,6 +93,7 @@
 #include "TFile.h"
 #include "TClass.h"
 
+#include "RConfigure.h"
 #include "TROOT.h"
 #include <algorithm>
 #include <cassert>
@@ -3365,6 +3369,159 @@ bool testMerge2D()
    return ret;
 }
 
+bool testMerge2DLarge()
+{
+   // Tests the merge of 2D Histograms with many bins, where the bin range is
+   // split in blocks which are merged in parallel with implicit multi-threading.
+   // The merge of the bin arrays must also give the same result as the merge bin
+   // by bin, which is used when the histograms have different types, including
+   // the errors of the negative bins of the histograms without sum of weights squared
+
+   TH2D* h1 = new TH2D("merge2DLarge-h1", "h1-Title", 200, minRange, maxRange, 200, minRange, maxRange);
+   TH2D* h2 = new TH2D("merge2DLarge-h2", "h2-Title", 200, minRange, maxRange, 200, minRange, maxRange);
+   TH2D* h3 = new TH2D("merge2DLarge-h3", "h3-Title", 200, minRange, maxRange, 200, minRange, maxRange);
+
+   h1->Sumw2();h2->Sumw2();
+
+   for ( Int_t e = 0; e < nEvents * 10; ++e ) {
+      h1->Fill(r.Uniform(0.9 * minRange, 1.1 * maxRange), r.Uniform(0.9 * minRange, 1.1 * maxRange), r.Uniform(0.5, 2.));
+      h2->Fill(r.Uniform(0.9 * minRange, 1.1 * maxRange), r.Uniform(0.9 * minRange, 1.1 * maxRange), r.Uniform(0.5, 2.));
+      h3->Fill(r.Uniform(0.9 * minRange, 1.1 * maxRange), r.Uniform(0.9 * minRange, 1.1 * maxRange), 1.0);
+   }
+   // negative bins in the histogram without sum of weights squared
+   for ( Int_t bin = 0; bin < h3->GetNcells(); bin += 7 )
+      h3->SetBinContent(bin, -h3->GetBinContent(bin) - 1);
+
+   // same content as h3 stored in a TH2F, to merge bin by bin
+   TH2F* h3f = new TH2F("merge2DLarge-h3f", "h3-Title", 200, minRange, maxRange, 200, minRange, maxRange);
+   for ( Int_t bin = 0; bin < h3->GetNcells(); ++bin )
+      h3f->SetBinContent(bin, h3->GetBinContent(bin));
+   h3f->SetEntries(h3->GetEntries());
+
+   TH2D* h4 = (TH2D*) h1->Clone("merge2DLarge-h4");
+   TH2D* h5 = (TH2D*) h1->Clone("merge2DLarge-h5");
+
+   TList *list = new TList;
+   list->Add(h2);
+   list->Add(h3);
+
+   h1->Merge(list);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   h4->Merge(list);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   TList *list2 = new TList;
+   list2->Add(h2);
+   list2->Add(h3f);
+   h5->Merge(list2);
+
+   bool ret = equals("Merge2DLarge", h1, h4, cmpOptStats, 1E-13);
+   ret |= equals("Merge2DLarge (bin by bin)", h1, h5, cmpOptStats, 1E-13);
+   if (cleanHistos) delete h1;
+   if (cleanHistos) delete h2;
+   if (cleanHistos) delete h3;
+   delete h3f;
+   delete list;
+   delete list2;
+   return ret;
+}
+
+bool testMergeProfLazySumw2()
+{
+   // Tests that with TH1::SetDefaultSumw2 the sum of squared weights per bin of a profile
+   // is only created by the first weight different from one, and that the profiles without
+   // it are equal to the ones where it is created explicitly (fills, Add, Merge and I/O)
+
+   Bool_t defaultSumw2 = TH1::GetDefaultSumw2();
+   TH1::SetDefaultSumw2(kTRUE);
+
+   Double_t c1 = r.Rndm() + 1.5;
+
+   // p1 is filled with unit weights, p2 has the same entries and the explicit sum of squared weights
+   TProfile* p1 = new TProfile("lazy-p1", "p1-Title", numberOfBins, minRange, maxRange);
+   TProfile* p2 = new TProfile("lazy-p2", "p2-Title", numberOfBins, minRange, maxRange);
+   p2->Sumw2();
+   // p3 is filled with weights
+   TProfile* p3 = new TProfile("lazy-p3", "p3-Title", numberOfBins, minRange, maxRange);
+
+   for ( Int_t e = 0; e < nEvents; ++e ) {
+      Double_t x = r.Uniform(0.9 * minRange, 1.1 * maxRange);
+      Double_t y = r.Uniform(0.9 * minRange, 1.1 * maxRange);
+      p1->Fill(x, y, 1.0);
+      p2->Fill(x, y, 1.0);
+   }
+   for ( Int_t e = 0; e < nEvents; ++e ) {
+      Double_t x = r.Uniform(0.9 * minRange, 1.1 * maxRange);
+      Double_t y = r.Uniform(0.9 * minRange, 1.1 * maxRange);
+      p3->Fill(x, y, c1);
+   }
+
+   int ret = 0;
+   ret |= (p1->GetBinSumw2()->fN != 0 || p3->GetBinSumw2()->fN == 0);
+   ret |= equals("LazySumw2-Unweighted", p1, (TProfile*) p2->Clone("lazy-p2c"), cmpOptStats, 1E-13);
+
+   // a weighted fill creates it from the bin entries
+   TProfile* p4 = (TProfile*) p1->Clone("lazy-p4");
+   TProfile* p5 = (TProfile*) p2->Clone("lazy-p5");
+   for ( Int_t e = 0; e < nEvents; ++e ) {
+      Double_t x = r.Uniform(0.9 * minRange, 1.1 * maxRange);
+      Double_t y = r.Uniform(0.9 * minRange, 1.1 * maxRange);
+      p4->Fill(x, y, c1);
+      p5->Fill(x, y, c1);
+   }
+   ret |= (p4->GetBinSumw2()->fN == 0);
+   ret |= equals("LazySumw2-Fill", p4, p5, cmpOptStats, 1E-13);
+
+   // Add of a profile without and a profile with it, and Add with scale factors
+   TProfile* p6 = new TProfile("lazy-p6", "p6=p1+p3", numberOfBins, minRange, maxRange);
+   p6->Add(p1, p3);
+   TProfile* p7 = new TProfile("lazy-p7", "p7=p2+p3", numberOfBins, minRange, maxRange);
+   p7->Add(p2, p3);
+   ret |= (p6->GetBinSumw2()->fN == 0);
+   ret |= equals("LazySumw2-Add", p6, p7, cmpOptStats, 1E-13);
+   TProfile* p8 = new TProfile("lazy-p8", "p8=c1*p1", numberOfBins, minRange, maxRange);
+   p8->Add(p1, p1, c1, 0);
+   TProfile* p9 = new TProfile("lazy-p9", "p9=c1*p2", numberOfBins, minRange, maxRange);
+   p9->Add(p2, p2, c1, 0);
+   ret |= (p8->GetBinSumw2()->fN == 0);
+   ret |= equals("LazySumw2-AddScaled", p8, p9, cmpOptStats, 1E-13);
+
+   // Merge of a weighted profile into a profile without it
+   TProfile* p10 = (TProfile*) p1->Clone("lazy-p10");
+   TProfile* p11 = (TProfile*) p2->Clone("lazy-p11");
+   TList *list = new TList;
+   list->Add(p3);
+   p10->Merge(list);
+   p11->Merge(list);
+   ret |= (p10->GetBinSumw2()->fN == 0);
+   ret |= equals("LazySumw2-Merge", p10, p11, cmpOptStats, 1E-13);
+
+   // a profile without it is written and read back without it
+   TFile f("tmpHist.root", "RECREATE");
+   p1->Write();
+   f.Close();
+   TFile f2("tmpHist.root");
+   TProfile* p12 = static_cast<TProfile*> ( f2.Get("lazy-p1") );
+   ret |= (p12->GetBinSumw2()->fN != 0);
+   ret |= equals("LazySumw2-ReadWrite", p1, p12, cmpOptStats);
+
+   TH1::SetDefaultSumw2(defaultSumw2);
+
+   delete list;
+   delete p1;
+   delete p2;
+   delete p3;
+   delete p4;
+   delete p6;
+   delete p8;
+   delete p10;
+   return ret;
+}
+
 bool testMergeProf2D()
 {
    // Tests the merge method for 2D Profiles
@@ -6399,6 +6556,63 @@ bool testH3Integral()
    return iret;
 }
 
+// test the evaluation of the kernel density estimate by FFT on a grid (TKDE::SetNFFTPoints)
+bool testTKDEFFT()
+{
+   const UInt_t n = 1000;
+   const UInt_t npx = 101;
+   std::vector<Double_t> data(n);
+   for (UInt_t i = 0; i < n; ++i)
+      data[i] = r.Gaus(0, 1);
+
+   TKDE kde(n, &data[0], 0.0, 0.0, "KernelType:Gaussian;Iteration:Fixed;Mirror:noMirror;Binning:Unbinned");
+   std::vector<Double_t> x(npx), direct(npx);
+   Double_t fmax = 0;
+   for (UInt_t i = 0; i < npx; ++i) {
+      x[i] = -4. + 8. * i / (npx - 1);
+      direct[i] = kde(x[i]);
+      fmax = std::max(fmax, direct[i]);
+   }
+
+   int iret = 0;
+
+   // the FFT estimate must agree with the direct sum of the kernels, within the error of
+   // the linear binning and interpolation on the grid
+   kde.SetNFFTPoints(4096);
+   std::vector<Double_t> fft(npx);
+   Double_t maxDiff = 0;
+   for (UInt_t i = 0; i < npx; ++i) {
+      fft[i] = kde(x[i]);
+      maxDiff = std::max(maxDiff, std::abs(fft[i] - direct[i]));
+   }
+   iret |= (maxDiff > 1.E-3 * fmax);
+
+   // the number of grid points is rounded up to a power of two
+   kde.SetNFFTPoints(3000);
+   int nround = 0;
+   for (UInt_t i = 0; i < npx; ++i)
+      nround += (kde(x[i]) != fft[i]);
+   iret |= (nround != 0);
+
+   // without the grid the kernels are summed again
+   kde.SetNFFTPoints(0);
+   int ndirect = 0;
+   for (UInt_t i = 0; i < npx; ++i)
+      ndirect += (kde(x[i]) != direct[i]);
+   iret |= (ndirect != 0);
+
+   if ( defaultEqualOptions & cmpOptDebug ) {
+      std::cout << "Maximum difference (FFT - direct) = " << maxDiff << " maximum = " << fmax << std::endl;
+      std::cout << "Points differing with 3000 and 4096 grid points = " << nround << std::endl;
+      std::cout << "Points differing after disabling the grid = " << ndirect << std::endl;
+   }
+
+   if ( defaultEqualOptions & cmpOptPrint )
+      std::cout << "TKDE FFT:\t" << (iret?"FAILED":"OK") << std::endl;
+
+   return iret;
+}
+
 // test histogram buffer
 bool testH1Buffer() {
 
@@ -6757,6 +6971,207 @@ bool testProfile2Extend() {
 
 }
 
+bool testH1FillN() {
+
+   // compare FillN with a loop of Fill, for fixed and variable bins,
+   // with under/overflows and weights
+
+   TH1D * h1 = new TH1D("h1","h1",numberOfBins, minRange, maxRange);
+   TH1D * h2 = new TH1D("h2","h2",numberOfBins, minRange, maxRange);
+   Double_t v[numberOfBins+1];
+   FillVariableRange(v);
+   TH1D * h3 = new TH1D("h3","h3",numberOfBins, v);
+   TH1D * h4 = new TH1D("h4","h4",numberOfBins, v);
+
+   std::vector<double> x(nEvents);
+   std::vector<double> w(nEvents);
+   for (int i = 0; i < nEvents; ++i) {
+      x[i] = r.Uniform(minRange - 1, maxRange + 1);
+      w[i] = (i < nEvents/2) ? 1. : r.Uniform(0,2);
+      h1->Fill(x[i], w[i]);
+      h3->Fill(x[i], w[i]);
+   }
+   h2->FillN(nEvents, &x[0], &w[0]);
+   h4->FillN(nEvents, &x[0], &w[0]);
+
+   bool ret = equals("testh1filln", h1, h2, cmpOptStats, 1E-15);
+   ret |= equals("testh1fillnvar", h3, h4, cmpOptStats, 1E-15);
+   if (cleanHistos) delete h1;
+   if (cleanHistos) delete h3;
+   return ret;
+}
+
+bool testH2FillN() {
+
+   TH2D * h1 = new TH2D("h1","h1",numberOfBins, minRange, maxRange, numberOfBins + 2, minRange, maxRange);
+   TH2D * h2 = new TH2D("h2","h2",numberOfBins, minRange, maxRange, numberOfBins + 2, minRange, maxRange);
+
+   // interleaved x,y,w values to test the stride
+   std::vector<double> v(3*nEvents);
+   for (int i = 0; i < nEvents; ++i) {
+      v[3*i]   = r.Uniform(minRange - 1, maxRange + 1);
+      v[3*i+1] = r.Uniform(minRange - 1, maxRange + 1);
+      v[3*i+2] = r.Uniform(0,2);
+      h1->Fill(v[3*i], v[3*i+1], v[3*i+2]);
+   }
+   h2->FillN(nEvents, &v[0], &v[1], &v[2], 3);
+
+   bool ret = equals("testh2filln", h1, h2, cmpOptStats, 1E-15);
+   if (cleanHistos) delete h1;
+   return ret;
+}
+
+bool testH3FillN() {
+
+   TH3D * h1 = new TH3D("h1","h1",numberOfBins, minRange, maxRange, numberOfBins + 1, minRange, maxRange,
+                        numberOfBins + 2, minRange, maxRange);
+   TH3D * h2 = new TH3D("h2","h2",numberOfBins, minRange, maxRange, numberOfBins + 1, minRange, maxRange,
+                        numberOfBins + 2, minRange, maxRange);
+
+   std::vector<double> x(nEvents);
+   std::vector<double> y(nEvents);
+   std::vector<double> z(nEvents);
+   for (int i = 0; i < nEvents; ++i) {
+      x[i] = r.Uniform(minRange - 1, maxRange + 1);
+      y[i] = r.Uniform(minRange - 1, maxRange + 1);
+      z[i] = r.Uniform(minRange - 1, maxRange + 1);
+      h1->Fill(x[i], y[i], z[i]);
+   }
+   h2->FillN(nEvents, &x[0], &y[0], &z[0], nullptr);
+
+   bool ret = equals("testh3filln", h1, h2, cmpOptStats, 1E-15);
+   if (cleanHistos) delete h1;
+   return ret;
+}
+
+bool testH2PolyFillN() {
+
+   TH2Poly* h1 = new TH2Poly("h1", "h1", 0., 10., 0., 10.);
+   TH2Poly* h2 = new TH2Poly("h2", "h2", 0., 10., 0., 10.);
+   // many small bins in one corner, a few large ones elsewhere
+   h1->Honeycomb(0., 0., .05, 30, 30);
+   h2->Honeycomb(0., 0., .05, 30, 30);
+   h1->AddBin(5., 5., 10., 10.);
+   h2->AddBin(5., 5., 10., 10.);
+
+   std::vector<double> x(nEvents);
+   std::vector<double> y(nEvents);
+   std::vector<double> w(nEvents);
+   int differents = 0;
+   for (int i = 0; i < nEvents; ++i) {
+      x[i] = (i % 2) ? r.Uniform(minRange - 1, 3.) : r.Uniform(minRange - 1, maxRange + 1);
+      y[i] = (i % 2) ? r.Uniform(minRange - 1, 3.) : r.Uniform(minRange - 1, maxRange + 1);
+      w[i] = r.Uniform(0.5, 2.);
+      Int_t bin = h1->Fill(x[i], y[i], w[i]);
+
+      // the bin found must be the first bin containing the point
+      if (bin > 0) {
+         TIter next(h1->GetBins());
+         TH2PolyBin* pb;
+         while ((pb = (TH2PolyBin*) next()) && !pb->IsInside(x[i], y[i])) {}
+         if (!pb || pb->GetBinNumber() != bin) ++differents;
+      }
+   }
+   h2->FillN(nEvents, &x[0], &y[0], &w[0]);
+
+   for (int i = 1; i <= h1->GetNumberOfBins(); ++i)
+      differents += equals(h1->GetBinContent(i), h2->GetBinContent(i), 1E-15);
+   for (int i = -9; i < 0; ++i)
+      differents += equals(h1->GetBinContent(i), h2->GetBinContent(i), 1E-15);
+
+   // enough entries for the bins to be searched in parallel when implicit
+   // multi-threading is available; the result must not change
+   const int nBatch = 8 * nEvents;
+   std::vector<double> xb(nBatch);
+   std::vector<double> yb(nBatch);
+   for (int i = 0; i < nBatch; ++i) {
+      xb[i] = r.Uniform(minRange - 1, maxRange + 1);
+      yb[i] = r.Uniform(minRange - 1, maxRange + 1);
+   }
+   h1->FillN(nBatch, &xb[0], &yb[0], nullptr);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   h2->FillN(nBatch, &xb[0], &yb[0], nullptr);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   for (int i = 1; i <= h1->GetNumberOfBins(); ++i)
+      differents += equals(h1->GetBinContent(i), h2->GetBinContent(i), 1E-15);
+   for (int i = -9; i < 0; ++i)
+      differents += equals(h1->GetBinContent(i), h2->GetBinContent(i), 1E-15);
+   differents += equals(h1->GetEntries(), h2->GetEntries(), 1E-15);
+
+   if ( defaultEqualOptions & cmpOptPrint )
+      std::cout << "testh2polyfilln: \t" << (differents?"FAILED":"OK") << std::endl;
+
+   delete h1;
+   delete h2;
+   return differents;
+}
+
+bool testSparseFillN() {
+
+   Int_t bsize[] = { numberOfBins, numberOfBins + 1, numberOfBins + 2 };
+   Double_t xmin[] = {minRange, minRange, minRange};
+   Double_t xmax[] = {maxRange, maxRange, maxRange};
+
+   THnSparseD* s1 = new THnSparseD("s1", "s1-Title", 3, bsize, xmin, xmax);
+   THnSparseD* s2 = new THnSparseD("s2", "s2-Title", 3, bsize, xmin, xmax);
+   THnSparseD* s3 = new THnSparseD("s3", "s3-Title", 3, bsize, xmin, xmax);
+   s1->Sumw2();
+   s2->Sumw2();
+   s3->Sumw2();
+
+   std::vector<double> x(3 * nEvents);
+   std::vector<double> w(nEvents);
+   for (int i = 0; i < nEvents; ++i) {
+      for (int d = 0; d < 3; ++d)
+         x[3 * i + d] = r.Uniform(minRange - 1, maxRange + 1);
+      w[i] = r.Uniform(0.5, 2.);
+      s1->Fill(&x[3 * i], w[i]);
+      s3->Fill(&x[3 * i], w[i]);
+      s3->Fill(&x[3 * i], w[i]);
+   }
+   s2->FillN(nEvents, &x[0], &w[0]);
+
+   // adding with the same binning must be the same as filling twice
+   THnSparseD* s4 = (THnSparseD*) s1->Clone("s4");
+   s4->Add(s2);
+
+   // histograms with several chunks and partially overlapping bins, added
+   // serially and (when implicit multi-threading is available) in parallel
+   THnSparseD* s5 = new THnSparseD("s5", "s5-Title", 3, bsize, xmin, xmax, 64);
+   s5->Sumw2();
+   for (int i = 0; i < nEvents; ++i) {
+      Double_t y[3];
+      for (int d = 0; d < 3; ++d)
+         y[d] = r.Uniform(minRange, maxRange);
+      s5->Fill(y, r.Uniform(0.5, 2.));
+   }
+   THnSparseD* s6 = (THnSparseD*) s1->Clone("s6");
+   s6->Add(s5, 0.5);
+   THnSparseD* s7 = (THnSparseD*) s1->Clone("s7");
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   s7->Add(s5, 0.5);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+
+   bool ret = equals("testsparsefilln", s1, s2, cmpOptStats, 1E-13);
+   ret |= equals("testsparsefilln-add", s3, s4, cmpOptStats, 1E-13);
+   ret |= equals("testsparsefilln-addmt", s6, s7, cmpOptStats, 1E-13);
+   if (cleanHistos) {
+      delete s1;
+      delete s3;
+      delete s5;
+      delete s6;
+   }
+   return ret;
+}
+
 bool testConversion1D()
 {
    const int nbins[3] = {50,11,12};
@@ -10020,7 +10435,8 @@ int stressHistogram()
                                                       testMergeVar1D,              testMergeProfVar1D,
                                                       testMerge2D,                 testMergeProf2D,
                                                       testMerge3D,                 testMergeProf3D,
-                                                      testMergeHn<THnD>,           testMergeHn<THnSparseD>
+                                                      testMergeHn<THnD>,           testMergeHn<THnSparseD>,
+                                                      testMerge2DLarge,            testMergeProfLazySumw2
    };
 
 
@@ -10111,6 +10527,13 @@ int stressHistogram()
                                            "Integral tests for Histograms....................................",
                                            integralTestPointer };
 
+   const unsigned int numberOfKDE = 1;
+   pointer2Test kdeTestPointer[numberOfKDE] = { testTKDEFFT
+   };
+   struct TTestSuite kdeTestSuite = { numberOfKDE,
+                                      "TKDE FFT evaluation tests........................................",
+                                      kdeTestPointer };
+
    const unsigned int numberOfBufferTest = 4;
    pointer2Test bufferTestPointer[numberOfBufferTest] = { testH1Buffer,
                                                           testH1BufferWeights,
@@ -10131,6 +10554,17 @@ int stressHistogram()
                                            "Extend axis tests for Histograms.................................",
                                            extendTestPointer };
 
+   const unsigned int numberOfFillNTest = 5;
+   pointer2Test fillNTestPointer[numberOfFillNTest] = { testH1FillN,
+                                                        testH2FillN,
+                                                        testH3FillN,
+                                                        testH2PolyFillN,
+                                                        testSparseFillN
+   };
+   struct TTestSuite fillNTestSuite = { numberOfFillNTest,
+                                        "FillN tests for Histograms.......................................",
+                                        fillNTestPointer };
+
    // Test 15
    // TH1-THn[Sparse] Conversions Tests
    const unsigned int numberOfConversions = 3;
@@ -10178,8 +10612,10 @@ int stressHistogram()
    testSuite.push_back( &interpolationTestSuite);
    testSuite.push_back( &scaleTestSuite);
    testSuite.push_back( &integralTestSuite);
+   testSuite.push_back( &kdeTestSuite);
    testSuite.push_back( &bufferTestSuite);
    testSuite.push_back( &extendTestSuite);
+   testSuite.push_back( &fillNTestSuite);
    testSuite.push_back( &conversionsTestSuite);
    testSuite.push_back( &fillDataTestSuite);
 
@@ -117,6 +117,7 @@
 #include "TDecompQRH.h"
 #include "TDecompSVD.h"
 #include "TDecompBK.h"
+#include "TDecompSparse.h"
 #include "TMatrixDEigen.h"
 #include "TMatrixDSymEigen.h"
 
@@ -1571,6 +1572,37 @@ void mstress_mm_multiplications()
     ok &= VerifyMatrixIdentity(unit,hht2,gVerbose,EPSILON);
   }
 
+  if (ok)
+  {
+    if (gVerbose)
+      std::cout << "Check the blocked multiplication of large non-square matrices against the element sums" << std::endl;
+    const Int_t nrows = 150, ninner = 130, ncols = 170;
+    TMatrixD a(nrows,ninner);
+    TMatrixD b(ninner,ncols);
+    for (Int_t i = 0; i < nrows; i++)
+      for (Int_t k = 0; k < ninner; k++)
+        a(i,k) = TMath::Sin(i+2.*k);
+    for (Int_t k = 0; k < ninner; k++)
+      for (Int_t j = 0; j < ncols; j++)
+        b(k,j) = TMath::Cos(3.*k-j);
+    TMatrixD ab_eth(nrows,ncols);
+    for (Int_t i = 0; i < nrows; i++)
+      for (Int_t j = 0; j < ncols; j++) {
+        Double_t sum = 0;
+        for (Int_t k = 0; k < ninner; k++)
+          sum += a(i,k)*b(k,j);
+        ab_eth(i,j) = sum;
+      }
+    const TMatrixD at(TMatrixD::kTransposed,a);
+    const TMatrixD bt(TMatrixD::kTransposed,b);
+    const TMatrixD ab  (a,TMatrixD::kMult,b);
+    const TMatrixD atb (at,TMatrixD::kTransposeMult,b);
+    const TMatrixD abt (a,TMatrixD::kMultTranspose,bt);
+    ok &= VerifyMatrixIdentity(ab,ab_eth,gVerbose,100*EPSILON);
+    ok &= VerifyMatrixIdentity(atb,ab_eth,gVerbose,100*EPSILON);
+    ok &= VerifyMatrixIdentity(abt,ab_eth,gVerbose,100*EPSILON);
+  }
+
   if (gVerbose)
     std::cout << "\nDone\n" << std::endl;
 
@@ -3991,6 +4023,19 @@ void astress_decomp()
     ok &= VerifyMatrixIdentity(chol.GetMatrix(),mtm,gVerbose,100*EPSILON);
   }
 
+  {
+    // large enough to use several blocks of the blocked Cholesky and the
+    // threaded Crout decomposition (when implicit multi-threading is enabled)
+    TMatrixDSym m3 = THilbertMatrixDSym(300);
+    TMatrixDDiag diag3(m3);
+    diag3 += 1.;
+    TDecompChol chol(m3);
+    ok &= VerifyMatrixIdentity(chol.GetMatrix(),m3,gVerbose,1000*EPSILON);
+    const TMatrixD m4(m3);
+    TDecompLU lu(m4);
+    ok &= VerifyMatrixIdentity(lu.GetMatrix(),m4,gVerbose,1000*EPSILON);
+  }
+
   if (gVerbose)
     std::cout << "\nDone" <<std::endl;
 
@@ -4127,6 +4172,36 @@ void astress_lineqn()
     }
   }
 
+  if (ok)
+  {
+    if (gVerbose)
+      std::cout << "\nSolve sparse symmetric positive definite system with conjugate gradient" << std::endl;
+
+    const Int_t msize   = 400;
+    const Int_t verbose = gVerbose;
+    TMatrixD m(msize,msize);
+    for (Int_t i = 0; i < msize; i++) {
+      m(i,i) = 4.0;
+      if (i > 0)       m(i,i-1) = -1.0;
+      if (i < msize-1) m(i,i+1) = -1.0;
+    }
+    const TMatrixDSparse ms(m);
+
+    TVectorD rowsum(msize);
+    for (Int_t i = 0; i < msize; i++)
+      for (Int_t j = 0; j < msize; j++)
+        rowsum(i) += m(i,j);
+
+    TVectorD b = rowsum;
+    ok &= TDecompSparse::SolveConjugateGradient(ms,b,1.0e-12);
+    ok &= VerifyVectorValue(b,1.0,verbose,1.0e-10);
+
+    TVectorD bd = rowsum;
+    TDecompChol chol(m);
+    chol.Solve(bd);
+    ok &= VerifyVectorIdentity(b,bd,verbose,1.0e-10);
+  }
+
   if (gVerbose)
     std::cout << "\nDone" <<std::endl;
 
@@ -7,6 +7,9 @@
 //    ====================
 //
 // This stress program tests many elements of the TSpectrum, TSpectrum2 classes.
+// The background estimation of large spectra, one by one and in batches
+// (in parallel with implicit multi-threading), is timed separately and is not
+// included in the ROOTMARKS.
 //
 // To run in batch, do
 //   stressSpectrum        : run 100 experiments with graphics (default)
@@ -37,6 +40,8 @@
 //****************************************************************************
 //Peak1 : found = 70.21/ 73.75, good = 65.03/ 68.60, ghost = 8.54/ 8.39,--- OK
 //Peak2 : found =163/300, good =163, ghost =8,----------------------------  OK
+//Backgr: spectra =100, area diff =0.0019, time/spectrum = 3.52 ms,-------  OK
+//Batch : spectra =100, max diff =0, real time/spectrum = 0.98 ms,-------- OK
 //****************************************************************************
 //stressSpectrum: Real Time =  19.86 seconds Cpu Time =  19.04 seconds
 //****************************************************************************
@@ -56,6 +61,7 @@
 #include "Riostream.h"
 #include "TROOT.h"
 #include "TMath.h"
+#include "RConfigure.h"
 
 Int_t npeaks;
 Double_t fpeaks(Double_t *x, Double_t *par) {
@@ -248,6 +254,107 @@ void stress2(Int_t np2) {
           nfound,npeaks,ngood,nghost,sok);
 }
 
+void stress3(Int_t nspectra) {
+   // estimate the background of large spectra with the SNIP algorithm
+   // (TSpectrum::Background), with and without smoothing, and check that
+   // the area of the peaks on top of a linear background is recovered
+   const Int_t nbins = 16384;
+   const Int_t npeaks3 = 20;
+   TRandom r;
+   Double_t *source = new Double_t[nbins];
+   Double_t *dest   = new Double_t[nbins];
+   TSpectrum *s = new TSpectrum();
+   Double_t worst = 0;
+   gBenchmark->Start("stressBackground");
+   for (Int_t isp=0;isp<nspectra;isp++) {
+      Double_t a0    = r.Uniform(100,150);
+      Double_t slope = r.Uniform(0,0.01);
+      Double_t area  = 0;
+      Int_t i;
+      for (i=0;i<nbins;i++) source[i] = a0 + slope*i;
+      for (Int_t p=0;p<npeaks3;p++) {
+         Double_t x0  = r.Uniform(200,nbins-200);
+         Double_t amp = r.Uniform(100,1100);
+         Double_t sg  = r.Uniform(2,4);
+         for (i=Int_t(x0-10*sg);i<Int_t(x0+10*sg);i++) {
+            Double_t v = amp*TMath::Gaus(i,x0,sg);
+            source[i] += v;
+            area      += v;
+         }
+      }
+      for (Int_t ismooth=0;ismooth<2;ismooth++) {
+         for (i=0;i<nbins;i++) dest[i] = source[i];
+         s->Background(dest,nbins,20,TSpectrum::kBackIncreasingWindow,TSpectrum::kBackOrder2,
+                       ismooth == 1,TSpectrum::kBackSmoothing3,kFALSE);
+         Double_t net = 0;
+         for (i=0;i<nbins;i++) net += source[i] - dest[i];
+         worst = TMath::Max(worst,TMath::Abs(net/area - 1));
+      }
+   }
+   gBenchmark->Stop("stressBackground");
+   Double_t ms = 1000*gBenchmark->GetCpuTime("stressBackground")/(2*nspectra);
+   delete s;
+   delete [] source;
+   delete [] dest;
+   char sok[20];
+   if (worst < 0.01) {
+      snprintf(sok,20,"OK");
+   } else {
+      snprintf(sok,20,"failed");
+   }
+   printf("Backgr: spectra =%d, area diff =%6.4f, time/spectrum =%5.2f ms,------- %s\n",
+          nspectra,worst,ms,sok);
+}
+
+void stress4(Int_t nspectra) {
+   // estimate the background of many large spectra at once with
+   // TSpectrum::BackgroundBatch (in parallel with implicit multi-threading)
+   // and check that the result is the same as one spectrum at a time
+   const Int_t nbins = 16384;
+   TRandom r;
+   Double_t *source = new Double_t[nspectra*nbins];
+   Double_t *dest   = new Double_t[nspectra*nbins];
+   for (Int_t isp=0;isp<nspectra;isp++) {
+      Double_t *sp = source + isp*nbins;
+      Double_t a0  = r.Uniform(100,150);
+      for (Int_t i=0;i<nbins;i++) sp[i] = r.Poisson(a0);
+      for (Int_t p=0;p<20;p++) {
+         Double_t x0 = r.Uniform(200,nbins-200);
+         Double_t amp = r.Uniform(100,1100);
+         for (Int_t i=Int_t(x0-30);i<Int_t(x0+30);i++) sp[i] += amp*TMath::Gaus(i,x0,3);
+      }
+   }
+   TSpectrum *s = new TSpectrum();
+   for (Int_t i=0;i<nspectra*nbins;i++) dest[i] = source[i];
+   for (Int_t isp=0;isp<nspectra;isp++)
+      s->Background(source+isp*nbins,nbins,20,TSpectrum::kBackDecreasingWindow,TSpectrum::kBackOrder2,
+                    kTRUE,TSpectrum::kBackSmoothing5,kFALSE);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+#endif
+   gBenchmark->Start("stressBackgroundBatch");
+   const char *error = s->BackgroundBatch(dest,nspectra,nbins,20,TSpectrum::kBackDecreasingWindow,
+                                          TSpectrum::kBackOrder2,kTRUE,TSpectrum::kBackSmoothing5,kFALSE);
+   gBenchmark->Stop("stressBackgroundBatch");
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   Double_t ms = 1000*gBenchmark->GetRealTime("stressBackgroundBatch")/nspectra;
+   Double_t maxdiff = 0;
+   for (Int_t i=0;i<nspectra*nbins;i++) maxdiff = TMath::Max(maxdiff,TMath::Abs(dest[i]-source[i]));
+   delete s;
+   delete [] source;
+   delete [] dest;
+   char sok[20];
+   if (!error && maxdiff == 0) {
+      snprintf(sok,20,"OK");
+   } else {
+      snprintf(sok,20,"failed");
+   }
+   printf("Batch : spectra =%d, max diff =%g, real time/spectrum =%5.2f ms,-------- %s\n",
+          nspectra,maxdiff,ms,sok);
+}
+
 void stressSpectrum(Int_t ntimes=100) {
    std::cout << "****************************************************************************" <<std::endl;
    std::cout << "*  Starting  stress S P E C T R U M                                        *" <<std::endl;
@@ -256,6 +363,8 @@ void stressSpectrum(Int_t ntimes=100) {
    stress1(ntimes);
    stress2(300);
    gBenchmark->Stop ("stressSpectrum");
+   stress3(ntimes);
+   stress4(ntimes);
    Double_t reftime100 = 19.04; //pcbrun compiled
    Double_t ct = gBenchmark->GetCpuTime("stressSpectrum");
    const Double_t rootmarks = 800*reftime100*ntimes/(100*ct);